@@ -0,0 +1,195 @@
+// CPU time per draw call of many small indexed meshes, each with its own vertex buffer and vertex
+// array (as mdl::Mesh), with the indices given from client memory to each draw call, and from an
+// IndexBuffer bound along with the vertex array, and uploaded to a stream buffer before each draw
+// call (as Drawer::DrawElements() does on macOS, where core profile contexts do not accept indices
+// from client memory). Client memory indices are skipped if the context does not accept them.
+// The CPU time is that of the draw loop; the frame time also includes glFinish().
+// Usage: DrawCallBench [mesh_num] [frame_num]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/rio_Window.h>
+#include <gpu/rio_Drawer.h>
+#include <gpu/rio_Shader.h>
+#include <gpu/rio_VertexArray.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+static const char* const cVertexShaderSrc =
+    "#version 330 core\n"
+    "layout(location = 0) in vec3 aPos;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = vec4(aPos, 1.0);\n"
+    "}\n";
+
+static const char* const cFragmentShaderSrc =
+    "#version 330 core\n"
+    "out vec4 oColor;\n"
+    "void main()\n"
+    "{\n"
+    "    oColor = vec4(1.0, 0.5, 0.0, 1.0);\n"
+    "}\n";
+
+static const u16 cIndices[36] = {
+    0, 1, 3, 0, 3, 2,   4, 6, 7, 4, 7, 5,   0, 4, 5, 0, 5, 1,
+    2, 3, 7, 2, 7, 6,   1, 5, 7, 1, 7, 3,   0, 2, 6, 0, 6, 4
+};
+
+struct BenchMesh
+{
+    f32                 vertices[8 * 3];
+    rio::VertexBuffer   vbo;
+    rio::VertexStream   pos_stream;
+    rio::VertexArray    vao;            // Without index buffer
+    rio::IndexBuffer    ibo;
+    rio::VertexArray    vao_indexed;    // With ibo
+
+    void initialize(f32 x, f32 y)
+    {
+        for (u32 i = 0; i < 8; i++)
+        {
+            vertices[i * 3 + 0] = x + ((i & 1) ? 0.01f : -0.01f);
+            vertices[i * 3 + 1] = y + ((i & 2) ? 0.01f : -0.01f);
+            vertices[i * 3 + 2] = (i & 4) ? 0.01f : -0.01f;
+        }
+
+        vbo.setStride(sizeof(f32) * 3);
+        vbo.setDataInvalidate(vertices, sizeof(vertices));
+        pos_stream.setLayout(0, rio::VertexStream::FORMAT_32_32_32_FLOAT, 0);
+
+        vao.addAttribute(pos_stream, vbo);
+        vao.process();
+
+        ibo.setDataInvalidate(cIndices, 36);
+        vao_indexed.addAttribute(pos_stream, vbo);
+        vao_indexed.setIndexBuffer(&ibo);
+        vao_indexed.process();
+    }
+};
+
+enum Mode
+{
+    MODE_CLIENT,        // Indices from client memory
+    MODE_UPLOAD,        // Indices uploaded to a stream buffer before each draw call
+    MODE_INDEX_BUFFER   // IndexBuffer
+};
+
+f64 getMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<f64, std::milli>(end - start).count();
+}
+
+void run(const char* name, Mode mode, BenchMesh* meshes, u32 mesh_num, u32 frame_num, GLuint stream_ibo)
+{
+    rio::Window* window = rio::Window::instance();
+
+    f64 draw_ms = 0.0;
+    f64 frame_ms = 0.0;
+
+    for (u32 frame = 0; frame < frame_num; frame++)
+    {
+        window->clearColor(0.0f, 0.0f, 0.0f);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < mesh_num; i++)
+        {
+            const BenchMesh& mesh = meshes[i];
+
+            switch (mode)
+            {
+            case MODE_CLIENT:
+                mesh.vao.bind();
+                rio::Drawer::DrawElements(rio::Drawer::TRIANGLES, 36, cIndices);
+                break;
+            case MODE_UPLOAD:
+                mesh.vao.bind();
+                RIO_GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, stream_ibo));
+                RIO_GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(cIndices), cIndices, GL_STREAM_DRAW));
+                RIO_GL_CALL(glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, nullptr));
+                break;
+            case MODE_INDEX_BUFFER:
+                mesh.vao_indexed.bind();
+                rio::Drawer::DrawElements(rio::Drawer::TRIANGLES, mesh.ibo);
+                break;
+            }
+        }
+        const auto draw_end = std::chrono::steady_clock::now();
+
+        window->swapBuffers();
+        RIO_GL_CALL(glFinish());
+
+        draw_ms += getMs(start, draw_end);
+        frame_ms += getMs(start, std::chrono::steady_clock::now());
+    }
+
+    std::printf("%-18s %8.1f ns per draw call, %8.3f ms per frame\n", name, draw_ms * 1e6 / (u64(frame_num) * mesh_num), frame_ms / frame_num);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 mesh_num = argc > 1 ? std::atoi(argv[1]) : 5000;
+    const u32 frame_num = argc > 2 ? std::atoi(argv[2]) : 50;
+    if (mesh_num == 0 || frame_num == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    rio::FileDeviceMgr::createSingleton();
+    if (!rio::Window::createSingleton(256, 256, false, true, 3, 3, true))
+    {
+        std::printf("Failed to create the window.\n");
+        return 1;
+    }
+
+    rio::Shader shader;
+    shader.load(cVertexShaderSrc, cFragmentShaderSrc);
+    shader.bind();
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<f32> dist(-0.95f, 0.95f);
+
+    BenchMesh* meshes = new BenchMesh[mesh_num];
+    for (u32 i = 0; i < mesh_num; i++)
+        meshes[i].initialize(dist(rng), dist(rng));
+
+    GLuint stream_ibo;
+    RIO_GL_CALL(glGenBuffers(1, &stream_ibo));
+
+    std::printf("%u meshes of 12 triangles, %u frames\n", mesh_num, frame_num);
+
+    // Check if the context accepts indices from client memory
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+    meshes[0].vao.bind();
+    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, cIndices);
+    const bool client_supported = glGetError() == GL_NO_ERROR;
+
+    // Warm up
+    run("Warm up:", MODE_INDEX_BUFFER, meshes, mesh_num, 2, stream_ibo);
+
+    if (client_supported)
+        run("Client indices:", MODE_CLIENT, meshes, mesh_num, frame_num, stream_ibo);
+    else
+        std::printf("Client indices:    not supported by the context\n");
+
+    run("Uploaded per draw:", MODE_UPLOAD, meshes, mesh_num, frame_num, stream_ibo);
+    run("IndexBuffer:", MODE_INDEX_BUFFER, meshes, mesh_num, frame_num, stream_ibo);
+
+    RIO_GL_CALL(glBindVertexArray(GL_NONE));
+    RIO_GL_CALL(glDeleteBuffers(1, &stream_ibo));
+    delete[] meshes;
+    shader.unload();
+
+    rio::Window::destroySingleton();
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
@@ -0,0 +1,210 @@
+// Frame time of drawing a model made of many cube meshes scattered around the camera, most of them
+// out of view, with all meshes drawn and with Model::draw(const Frustum&) skipping the culled ones.
+// The visible and culled counts are those of the frustum, which is set every frame.
+// Usage: FrustumCullingBench [mesh_num] [frame_num]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/mdl/res/rio_ModelData.h>
+#include <gfx/mdl/rio_Model.h>
+#include <gfx/rio_Camera.h>
+#include <gfx/rio_Frustum.h>
+#include <gfx/rio_Projection.h>
+#include <gfx/rio_Window.h>
+#include <gpu/rio_RenderState.h>
+#include <gpu/rio_Shader.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+static const char* const cVertexShaderSrc =
+    "#version 330 core\n"
+    "layout(location = 0) in vec3 aPos;\n"
+    "uniform mat4 uViewProj;\n"
+    "uniform mat4 uWorld;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = uViewProj * uWorld * vec4(aPos, 1.0);\n"
+    "}\n";
+
+static const char* const cFragmentShaderSrc =
+    "#version 330 core\n"
+    "out vec4 oColor;\n"
+    "void main()\n"
+    "{\n"
+    "    oColor = vec4(1.0, 0.5, 0.0, 1.0);\n"
+    "}\n";
+
+struct DrawContext
+{
+    rio::Shader*    shader;
+    u32             world_location;
+};
+
+template <typename T>
+void put(std::vector<u8>& data, u32 offset, T value)
+{
+    std::memcpy(&data[offset], &value, sizeof(T));
+}
+
+// Set the relative offset and count of a res::Buffer field
+void putBuffer(std::vector<u8>& data, u32 field_offset, u32 target_offset, u32 count)
+{
+    put<s32>(data, field_offset, s32(target_offset - field_offset));
+    put<u32>(data, field_offset + 4, count);
+}
+
+// Build a model with one cube mesh per position, without materials
+// (see the layouts of res::Model and res::Mesh)
+void buildModel(std::vector<u8>* data, u32 mesh_num)
+{
+    static const u32 cIndices[36] = {
+        0, 1, 3, 0, 3, 2,   4, 6, 7, 4, 7, 5,   0, 4, 5, 0, 5, 1,
+        2, 3, 7, 2, 7, 6,   1, 5, 7, 1, 7, 3,   0, 2, 6, 0, 6, 4
+    };
+
+    const u32 vertex_size = 8 * sizeof(rio::mdl::res::Vertex);
+    const u32 mesh_offset = 0x20;
+    const u32 mesh_data_offset = mesh_offset + mesh_num * sizeof(rio::mdl::res::Mesh);
+    const u32 mesh_data_size = vertex_size + sizeof(cIndices);
+
+    data->assign(mesh_data_offset + mesh_num * mesh_data_size, 0);
+
+    std::memcpy(&(*data)[0], "riomodel", 8);
+    put<u32>(*data, 0x08, rio::mdl::res::Model::cVersionCurrent);
+    put<u32>(*data, 0x0C, data->size());
+    putBuffer(*data, 0x10, mesh_offset, mesh_num);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<f32> dist(-200.0f, 200.0f);
+
+    for (u32 i = 0; i < mesh_num; i++)
+    {
+        const u32 mesh = mesh_offset + i * sizeof(rio::mdl::res::Mesh);
+        const u32 vertices = mesh_data_offset + i * mesh_data_size;
+        const u32 indices = vertices + vertex_size;
+
+        putBuffer(*data, mesh + 0x00, vertices, 8);
+        putBuffer(*data, mesh + 0x08, indices, 36);
+
+        const f32 srt[9] = { 1.0f, 1.0f, 1.0f,   0.0f, 0.0f, 0.0f,   dist(rng), 0.0f, dist(rng) };
+        std::memcpy(&(*data)[mesh + 0x10], srt, sizeof(srt));
+
+        for (u32 j = 0; j < 8; j++)
+        {
+            const f32 pos[3] = { (j & 1) ? 1.0f : -1.0f, (j & 2) ? 1.0f : -1.0f, (j & 4) ? 1.0f : -1.0f };
+            std::memcpy(&(*data)[vertices + j * sizeof(rio::mdl::res::Vertex)], pos, sizeof(pos));
+        }
+
+        std::memcpy(&(*data)[indices], cIndices, sizeof(cIndices));
+    }
+}
+
+void setWorldMtx(const rio::mdl::Mesh& mesh, void* user_data)
+{
+    const DrawContext& context = *static_cast<const DrawContext*>(user_data);
+
+    rio::Matrix44f world_mtx;
+    world_mtx.fromMatrix34(mesh.worldMtx());
+
+    context.shader->setUniform(world_mtx, context.world_location, u32(-1));
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 mesh_num = argc > 1 ? std::atoi(argv[1]) : 4000;
+    const u32 frame_num = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (mesh_num == 0 || frame_num == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    rio::FileDeviceMgr::createSingleton();
+    if (!rio::Window::createSingleton(256, 256, false, true, 3, 3, true))
+    {
+        std::printf("Failed to create the window.\n");
+        return 1;
+    }
+
+    std::vector<u8> data;
+    buildModel(&data, mesh_num);
+
+    rio::mdl::Model* model = new rio::mdl::Model(reinterpret_cast<const rio::mdl::res::Model*>(data.data()));
+    model->setModelWorldMtx(rio::Matrix34f::ident);
+
+    rio::LookAtCamera camera({ 0.0f, 5.0f, 60.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+    rio::PerspectiveProjection projection(1.0f, 300.0f, rio::Mathf::deg2rad(45), 1.0f);
+
+    rio::Matrix34f view_mtx;
+    camera.getMatrix(&view_mtx);
+
+    rio::Matrix44f view_proj_mtx;
+    view_proj_mtx.setMul(static_cast<const rio::Matrix44f&>(projection.getMatrix()), view_mtx);
+
+    rio::Shader shader;
+    shader.load(cVertexShaderSrc, cFragmentShaderSrc);
+    shader.bind();
+    shader.setUniform(view_proj_mtx, shader.getVertexUniformLocation("uViewProj"), u32(-1));
+
+    DrawContext context;
+    context.shader = &shader;
+    context.world_location = shader.getVertexUniformLocation("uWorld");
+
+    rio::RenderState render_state;
+    render_state.setDepthEnable(true, true);
+    render_state.apply();
+
+    std::printf("%u meshes, %u frames\n", mesh_num, frame_num);
+
+    rio::Frustum frustum;
+
+    for (bool cull : { false, true })
+    {
+        u32 drawn_num = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 frame = 0; frame < frame_num; frame++)
+        {
+            rio::Window::instance()->clearColor(0.0f, 0.0f, 0.0f);
+
+            if (cull)
+            {
+                frustum.set(camera, projection);
+                drawn_num = model->draw(frustum, &setWorldMtx, &context);
+            }
+            else
+            {
+                for (u32 i = 0; i < model->numMeshes(); i++)
+                {
+                    setWorldMtx(model->mesh(i), &context);
+                    model->mesh(i).draw();
+                }
+                drawn_num = model->numMeshes();
+            }
+
+            rio::Window::instance()->swapBuffers();
+            RIO_GL_CALL(glFinish());
+        }
+        const f64 ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count() / frame_num;
+
+        if (cull)
+            std::printf("Culled:   %8.2f ms per frame, %u drawn (visible %u, culled %u)\n", ms, drawn_num, frustum.getVisibleNum(), frustum.getCulledNum());
+        else
+            std::printf("All:      %8.2f ms per frame, %u drawn\n", ms, drawn_num);
+    }
+
+    delete model;
+    shader.unload();
+
+    rio::Window::destroySingleton();
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
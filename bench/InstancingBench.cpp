@@ -0,0 +1,297 @@
+// Frame time of drawing many copies of the same model, with one mdl::Model per copy drawing its
+// meshes one by one, and with a single model drawing all copies with Mesh::drawInstanced().
+// The instance matrices are uploaded with Model::setInstanceWorldMtx() every frame, and the time
+// taken by its first call (which sets up the vertex arrays of all meshes) is reported separately.
+// The last frame of both methods is read back, and the pixels which differ are counted.
+// Usage: InstancingBench [instance_num] [mesh_num] [frame_num]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/mdl/res/rio_ModelData.h>
+#include <gfx/mdl/rio_Model.h>
+#include <gfx/rio_Camera.h>
+#include <gfx/rio_Projection.h>
+#include <gfx/rio_Window.h>
+#include <gpu/rio_RenderState.h>
+#include <gpu/rio_Shader.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+static const u32 cWidth = 256;
+static const u32 cHeight = 256;
+
+static const char* const cVertexShaderSrc =
+    "#version 330 core\n"
+    "layout(location = 0) in vec3 aPos;\n"
+    "uniform mat4 uViewProj;\n"
+    "uniform mat4 uWorld;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = uViewProj * uWorld * vec4(aPos, 1.0);\n"
+    "}\n";
+
+static const char* const cInstancedVertexShaderSrc =
+    "#version 330 core\n"
+    "layout(location = 0) in vec3 aPos;\n"
+    "layout(location = 3) in vec4 aInstanceMtx0;\n"
+    "layout(location = 4) in vec4 aInstanceMtx1;\n"
+    "layout(location = 5) in vec4 aInstanceMtx2;\n"
+    "uniform mat4 uViewProj;\n"
+    "uniform mat4 uLocal;\n"
+    "void main()\n"
+    "{\n"
+    "    mat4 instance_mtx = transpose(mat4(aInstanceMtx0, aInstanceMtx1, aInstanceMtx2, vec4(0.0, 0.0, 0.0, 1.0)));\n"
+    "    gl_Position = uViewProj * instance_mtx * uLocal * vec4(aPos, 1.0);\n"
+    "}\n";
+
+static const char* const cFragmentShaderSrc =
+    "#version 330 core\n"
+    "out vec4 oColor;\n"
+    "void main()\n"
+    "{\n"
+    "    oColor = vec4(1.0, 0.5, 0.0, 1.0);\n"
+    "}\n";
+
+f64 getMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<f64, std::milli>(end - start).count();
+}
+
+template <typename T>
+void put(std::vector<u8>& data, u32 offset, T value)
+{
+    std::memcpy(&data[offset], &value, sizeof(T));
+}
+
+// Set the relative offset and count of a res::Buffer field
+void putBuffer(std::vector<u8>& data, u32 field_offset, u32 target_offset, u32 count)
+{
+    put<s32>(data, field_offset, s32(target_offset - field_offset));
+    put<u32>(data, field_offset + 4, count);
+}
+
+// Build a model with a row of small cube meshes, without materials
+// (see the layouts of res::Model and res::Mesh)
+void buildModel(std::vector<u8>* data, u32 mesh_num)
+{
+    static const u32 cIndices[36] = {
+        0, 1, 3, 0, 3, 2,   4, 6, 7, 4, 7, 5,   0, 4, 5, 0, 5, 1,
+        2, 3, 7, 2, 7, 6,   1, 5, 7, 1, 7, 3,   0, 2, 6, 0, 6, 4
+    };
+
+    const u32 vertex_size = 8 * sizeof(rio::mdl::res::Vertex);
+    const u32 mesh_offset = 0x20;
+    const u32 mesh_data_offset = mesh_offset + mesh_num * sizeof(rio::mdl::res::Mesh);
+    const u32 mesh_data_size = vertex_size + sizeof(cIndices);
+
+    data->assign(mesh_data_offset + mesh_num * mesh_data_size, 0);
+
+    std::memcpy(&(*data)[0], "riomodel", 8);
+    put<u32>(*data, 0x08, rio::mdl::res::Model::cVersionCurrent);
+    put<u32>(*data, 0x0C, data->size());
+    putBuffer(*data, 0x10, mesh_offset, mesh_num);
+
+    for (u32 i = 0; i < mesh_num; i++)
+    {
+        const u32 mesh = mesh_offset + i * sizeof(rio::mdl::res::Mesh);
+        const u32 vertices = mesh_data_offset + i * mesh_data_size;
+        const u32 indices = vertices + vertex_size;
+
+        putBuffer(*data, mesh + 0x00, vertices, 8);
+        putBuffer(*data, mesh + 0x08, indices, 36);
+
+        const f32 srt[9] = { 0.2f, 0.2f, 0.2f,   0.0f, 0.0f, 0.0f,   0.0f, 0.5f * i, 0.0f };
+        std::memcpy(&(*data)[mesh + 0x10], srt, sizeof(srt));
+
+        for (u32 j = 0; j < 8; j++)
+        {
+            const f32 pos[3] = { (j & 1) ? 1.0f : -1.0f, (j & 2) ? 1.0f : -1.0f, (j & 4) ? 1.0f : -1.0f };
+            std::memcpy(&(*data)[vertices + j * sizeof(rio::mdl::res::Vertex)], pos, sizeof(pos));
+        }
+
+        std::memcpy(&(*data)[indices], cIndices, sizeof(cIndices));
+    }
+}
+
+// Set a Matrix34f as a mat4 uniform
+void setMtxUniform(rio::Shader& shader, u32 location, const rio::Matrix34f& mtx)
+{
+    rio::Matrix44f mtx44;
+    mtx44.fromMatrix34(mtx);
+
+    shader.setUniform(mtx44, location, u32(-1));
+}
+
+void readColor(std::vector<u8>* pixels)
+{
+    pixels->resize(cWidth * cHeight * 4);
+    RIO_GL_CALL(glReadPixels(0, 0, cWidth, cHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels->data()));
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 instance_num = argc > 1 ? std::atoi(argv[1]) : 500;
+    const u32 mesh_num = argc > 2 ? std::atoi(argv[2]) : 4;
+    const u32 frame_num = argc > 3 ? std::atoi(argv[3]) : 20;
+    if (instance_num == 0 || mesh_num == 0 || frame_num == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    rio::FileDeviceMgr::createSingleton();
+    if (!rio::Window::createSingleton(cWidth, cHeight, false, true, 3, 3, true))
+    {
+        std::printf("Failed to create the window.\n");
+        return 1;
+    }
+
+    std::vector<u8> data;
+    buildModel(&data, mesh_num);
+    const rio::mdl::res::Model* res_mdl = reinterpret_cast<const rio::mdl::res::Model*>(data.data());
+
+    // Instances on a square grid around the origin
+    const u32 grid_size = u32(std::ceil(std::sqrt(f32(instance_num))));
+    std::vector<rio::Matrix34f> instance_mtx(instance_num, rio::Matrix34f::ident);
+    for (u32 i = 0; i < instance_num; i++)
+    {
+        instance_mtx[i].m[0][3] = (f32(i % grid_size) - grid_size * 0.5f) * 2.0f;
+        instance_mtx[i].m[2][3] = (f32(i / grid_size) - grid_size * 0.5f) * 2.0f;
+    }
+
+    rio::LookAtCamera camera({ 0.0f, grid_size * 2.0f, grid_size * 2.5f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+    rio::PerspectiveProjection projection(1.0f, grid_size * 10.0f, rio::Mathf::deg2rad(45), 1.0f);
+
+    rio::Matrix34f view_mtx;
+    camera.getMatrix(&view_mtx);
+
+    rio::Matrix44f view_proj_mtx;
+    view_proj_mtx.setMul(static_cast<const rio::Matrix44f&>(projection.getMatrix()), view_mtx);
+
+    rio::Shader shader;
+    shader.load(cVertexShaderSrc, cFragmentShaderSrc);
+    shader.bind();
+    shader.setUniform(view_proj_mtx, shader.getVertexUniformLocation("uViewProj"), u32(-1));
+    const u32 world_location = shader.getVertexUniformLocation("uWorld");
+
+    rio::Shader instanced_shader;
+    instanced_shader.load(cInstancedVertexShaderSrc, cFragmentShaderSrc);
+    instanced_shader.bind();
+    instanced_shader.setUniform(view_proj_mtx, instanced_shader.getVertexUniformLocation("uViewProj"), u32(-1));
+    const u32 local_location = instanced_shader.getVertexUniformLocation("uLocal");
+
+    rio::RenderState render_state;
+    render_state.setDepthEnable(true, true);
+    render_state.apply();
+
+    std::printf("%u instances of %u meshes, %u frames\n", instance_num, mesh_num, frame_num);
+
+    std::vector<u8> pixels[2];
+
+    // One model per instance
+    {
+        std::vector<rio::mdl::Model*> models(instance_num);
+        for (u32 i = 0; i < instance_num; i++)
+        {
+            models[i] = new rio::mdl::Model(res_mdl);
+            models[i]->setModelWorldMtx(instance_mtx[i]);
+        }
+
+        shader.bind();
+
+        f64 cpu_ms = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 frame = 0; frame < frame_num; frame++)
+        {
+            rio::Window::instance()->clearColor(0.0f, 0.0f, 0.0f);
+            rio::Window::instance()->clearDepthStencil();
+
+            const auto draw_start = std::chrono::steady_clock::now();
+            for (const rio::mdl::Model* model : models)
+            {
+                for (u32 i = 0; i < model->numMeshes(); i++)
+                {
+                    setMtxUniform(shader, world_location, model->mesh(i).worldMtx());
+                    model->mesh(i).draw();
+                }
+            }
+            cpu_ms += getMs(draw_start, std::chrono::steady_clock::now());
+
+            if (frame == frame_num - 1)
+                readColor(&pixels[0]);
+
+            rio::Window::instance()->swapBuffers();
+            RIO_GL_CALL(glFinish());
+        }
+        const f64 ms = getMs(start, std::chrono::steady_clock::now()) / frame_num;
+
+        std::printf("Per model: %8.2f ms per frame, %8.2f ms CPU, %u draw calls\n", ms, cpu_ms / frame_num, instance_num * mesh_num);
+
+        for (rio::mdl::Model* model : models)
+            delete model;
+    }
+
+    // One model with all instances
+    {
+        rio::mdl::Model* model = new rio::mdl::Model(res_mdl);
+
+        const auto setup_start = std::chrono::steady_clock::now();
+        model->setInstanceWorldMtx(instance_mtx.data(), instance_num);
+        const f64 setup_ms = getMs(setup_start, std::chrono::steady_clock::now());
+
+        instanced_shader.bind();
+
+        f64 cpu_ms = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 frame = 0; frame < frame_num; frame++)
+        {
+            rio::Window::instance()->clearColor(0.0f, 0.0f, 0.0f);
+            rio::Window::instance()->clearDepthStencil();
+
+            const auto draw_start = std::chrono::steady_clock::now();
+            model->setInstanceWorldMtx(instance_mtx.data(), instance_num);
+            for (u32 i = 0; i < model->numMeshes(); i++)
+            {
+                setMtxUniform(instanced_shader, local_location, model->mesh(i).localMtx());
+                model->mesh(i).drawInstanced();
+            }
+            cpu_ms += getMs(draw_start, std::chrono::steady_clock::now());
+
+            if (frame == frame_num - 1)
+                readColor(&pixels[1]);
+
+            rio::Window::instance()->swapBuffers();
+            RIO_GL_CALL(glFinish());
+        }
+        const f64 ms = getMs(start, std::chrono::steady_clock::now()) / frame_num;
+
+        std::printf("Instanced: %8.2f ms per frame, %8.2f ms CPU, %u draw calls (setup %.2f ms)\n", ms, cpu_ms / frame_num, mesh_num, setup_ms);
+
+        delete model;
+    }
+
+    // The world matrices are multiplied on the GPU when instancing, so edges may be rasterized slightly differently
+    u32 covered_num = 0;
+    u32 differ_num = 0;
+    for (u32 i = 0; i < cWidth * cHeight; i++)
+    {
+        covered_num += pixels[0][i * 4] != 0 || pixels[1][i * 4] != 0;
+        differ_num += std::memcmp(&pixels[0][i * 4], &pixels[1][i * 4], 4) != 0;
+    }
+    std::printf("%u of %u covered pixels differ\n", differ_num, covered_num);
+
+    shader.unload();
+    instanced_shader.unload();
+
+    rio::Window::destroySingleton();
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
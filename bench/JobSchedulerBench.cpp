@@ -0,0 +1,96 @@
+// Time per run() of JobScheduler by number of worker threads, for batches of jobs of uneven cost
+// (every 8th job is 8 times more expensive, so that stealing has work to balance), along with the
+// number of stolen jobs and the CPU time used by the process per run (which includes time spent
+// waiting for the workers, if it is not spent sleeping).
+// Usage: JobSchedulerBench [job_num] [run_num] [max_worker_num]
+
+#include <task/rio_JobScheduler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct JobArg
+{
+    u32 iteration_num;
+    f32 result;
+};
+
+void jobFunc(void* arg)
+{
+    JobArg& job_arg = *static_cast<JobArg*>(arg);
+
+    f32 x = 1.0f;
+    for (u32 i = 0; i < job_arg.iteration_num; i++)
+        x = x * 0.999f + 0.5f;
+
+    job_arg.result = x;
+}
+
+f64 getCpuMs()
+{
+    return 1000.0 * std::clock() / CLOCKS_PER_SEC;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 job_num = argc > 1 ? std::atoi(argv[1]) : 256;
+    const u32 run_num = argc > 2 ? std::atoi(argv[2]) : 200;
+    const u32 max_worker_num = argc > 3 ? std::atoi(argv[3]) : std::max(std::thread::hardware_concurrency(), 1u) * 2 - 1;
+    if (job_num == 0 || run_num == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    std::vector<JobArg> args(job_num);
+    std::vector<rio::JobScheduler::Job> jobs(job_num);
+    for (u32 i = 0; i < job_num; i++)
+    {
+        args[i].iteration_num = i % 8 == 0 ? 80000 : 10000;
+        jobs[i].func = &jobFunc;
+        jobs[i].arg = &args[i];
+    }
+
+    std::printf("%u jobs per run, %u runs, %u hardware threads\n", job_num, run_num, std::thread::hardware_concurrency());
+    std::printf("%7s %12s %8s %10s %14s\n", "workers", "ms per run", "speedup", "stolen", "CPU ms per run");
+
+    f64 base_ms = 0.0;
+    for (u32 worker_num = 0; worker_num <= max_worker_num; worker_num = worker_num == 0 ? 1 : worker_num * 2 + 1)
+    {
+        rio::JobScheduler scheduler;
+        scheduler.initialize(worker_num);
+
+        // Warm up
+        scheduler.run(jobs.data(), job_num);
+
+        u64 stolen_num = 0;
+
+        const f64 cpu_start = getCpuMs();
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < run_num; i++)
+        {
+            scheduler.run(jobs.data(), job_num);
+            stolen_num += scheduler.getStolenNum();
+        }
+        const f64 ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count() / run_num;
+        const f64 cpu_ms = (getCpuMs() - cpu_start) / run_num;
+
+        if (worker_num == 0)
+            base_ms = ms;
+
+        std::printf("%7u %12.3f %7.2fx %10u %14.3f\n", worker_num, ms, base_ms / ms, u32(stolen_num / run_num), cpu_ms);
+
+        scheduler.terminate();
+    }
+
+    return 0;
+}
@@ -0,0 +1,180 @@
+// Exactness and speed of the SIMD implementations of the f32 matrix and quaternion operations
+// (see RIO_MATH_SIMD in rio_MathTypes.h), against the generic implementations on the same inputs.
+// The generic implementations are instantiated with Scalar, a wrapper of f32 which the SIMD
+// specializations do not match, so that both can be run in the same program.
+// The results must be bit-identical, which requires building without floating-point contraction
+// (e.g. -ffp-contract=off, or without FMA instructions enabled). Returns 1 if any result differs.
+// Only the math sources are needed, e.g.:
+//   g++ -std=gnu++17 -O2 -ffp-contract=off -DRIO_RELEASE -Iinclude bench/MathSimdBench.cpp src/math/impl/*.cpp
+// Usage: MathSimdBench [iteration_num]
+
+#include <math/rio_Matrix.h>
+#include <math/rio_Quat.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Scalar
+{
+    f32 v;
+};
+
+inline Scalar operator+(Scalar a, Scalar b) { return { a.v + b.v }; }
+inline Scalar operator-(Scalar a, Scalar b) { return { a.v - b.v }; }
+inline Scalar operator*(Scalar a, Scalar b) { return { a.v * b.v }; }
+inline Scalar operator/(Scalar a, Scalar b) { return { a.v / b.v }; }
+inline Scalar operator-(Scalar a)           { return { -a.v }; }
+inline Scalar operator/(s32 a, Scalar b)    { return { f32(a) / b.v }; }
+inline bool operator==(Scalar a, s32 b)     { return a.v == f32(b); }
+
+static_assert(sizeof(rio::Matrix34<Scalar>) == sizeof(rio::Matrix34f), "Scalar size mismatch");
+static_assert(sizeof(rio::Matrix44<Scalar>) == sizeof(rio::Matrix44f), "Scalar size mismatch");
+static_assert(sizeof(rio::Quat<Scalar>) == sizeof(rio::Quatf), "Scalar size mismatch");
+
+static const u32 cInputNum = 1024;
+
+struct Input
+{
+    rio::Matrix34f  mtx34;
+    rio::Matrix44f  mtx44;
+    rio::Quatf      quat;
+};
+
+template <typename T>
+void randomize(T* value, std::mt19937& rng)
+{
+    std::uniform_real_distribution<f32> dist(-4.0f, 4.0f);
+
+    f32* const a = reinterpret_cast<f32*>(value);
+    for (u32 i = 0; i < sizeof(T) / sizeof(f32); i++)
+        a[i] = dist(rng);
+}
+
+// Reinterpret f32 math types as their Scalar instantiations, and back
+template <typename To, typename From>
+const To& as(const From& value)
+{
+    static_assert(sizeof(To) == sizeof(From), "size mismatch");
+    return *reinterpret_cast<const To*>(&value);
+}
+
+// Run an operation on every pair of consecutive inputs, with the f32 type (SIMD) and the Scalar type (generic)
+// Returns the number of results which are not bit-identical
+template <typename SimdOut, typename GenericOut, typename SimdOp, typename GenericOp>
+u32 check(const char* name, const std::vector<Input>& inputs, SimdOp simd_op, GenericOp generic_op)
+{
+    u32 mismatch_num = 0;
+
+    for (u32 i = 0; i < cInputNum; i++)
+    {
+        const Input& a = inputs[i];
+        const Input& b = inputs[(i + 1) % cInputNum];
+
+        SimdOut simd_out;
+        GenericOut generic_out;
+        std::memset(&simd_out, 0, sizeof(simd_out));
+        std::memset(&generic_out, 0, sizeof(generic_out));
+
+        const bool simd_ret = simd_op(simd_out, a, b);
+        const bool generic_ret = generic_op(generic_out, a, b);
+
+        if (simd_ret != generic_ret || std::memcmp(&simd_out, &generic_out, sizeof(SimdOut)) != 0)
+            mismatch_num++;
+    }
+
+    std::printf("%-18s %s (%u/%u mismatches)\n", name, mismatch_num == 0 ? "exact" : "DIFFERS", mismatch_num, cInputNum);
+    return mismatch_num;
+}
+
+// Time an operation run on every pair of consecutive inputs, iteration_num times
+template <typename Out, typename Op>
+f64 measure(const std::vector<Input>& inputs, u32 iteration_num, Op op)
+{
+    std::vector<Out> outs(cInputNum);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 n = 0; n < iteration_num; n++)
+        for (u32 i = 0; i < cInputNum; i++)
+            op(outs[i], inputs[i], inputs[(i + n + 1) % cInputNum]);
+    const f64 ns = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    // Keep the results alive
+    volatile f32 sink = reinterpret_cast<const f32*>(&outs[iteration_num % cInputNum])[0];
+    (void)sink;
+
+    return ns / (f64(iteration_num) * cInputNum);
+}
+
+template <typename SimdOut, typename GenericOut, typename SimdOp, typename GenericOp>
+void bench(const char* name, const std::vector<Input>& inputs, u32 iteration_num, SimdOp simd_op, GenericOp generic_op)
+{
+    const f64 simd_ns = measure<SimdOut>(inputs, iteration_num, simd_op);
+    const f64 generic_ns = measure<GenericOut>(inputs, iteration_num, generic_op);
+
+    std::printf("%-18s SIMD %6.2f ns, generic %6.2f ns (x%.2f)\n", name, simd_ns, generic_ns, generic_ns / simd_ns);
+}
+
+}
+
+#define RIO_BENCH_OP(name, SimdOut, GenericOut, simd_expr, generic_expr)                                                    \
+    mismatch_num += check<SimdOut, GenericOut>(name, inputs,                                                               \
+        [](SimdOut& o, const Input& a, const Input& b) { return simd_expr; },                                              \
+        [](GenericOut& o, const Input& a, const Input& b) { return generic_expr; });                                       \
+    bench<SimdOut, GenericOut>(name, inputs, iteration_num,                                                                \
+        [](SimdOut& o, const Input& a, const Input& b) { return simd_expr; },                                              \
+        [](GenericOut& o, const Input& a, const Input& b) { return generic_expr; })
+
+int main(int argc, char** argv)
+{
+    const u32 iteration_num = argc > 1 ? std::atoi(argv[1]) : 2000;
+
+    typedef rio::Matrix34<Scalar> Matrix34s;
+    typedef rio::Matrix44<Scalar> Matrix44s;
+    typedef rio::Quat<Scalar> Quats;
+
+    std::mt19937 rng(1);
+
+    std::vector<Input> inputs(cInputNum);
+    for (Input& input : inputs)
+    {
+        randomize(&input.mtx34, rng);
+        randomize(&input.mtx44, rng);
+        randomize(&input.quat, rng);
+    }
+
+#if RIO_MATH_SIMD_SSE
+    std::printf("SIMD: SSE2\n");
+#elif RIO_MATH_SIMD_NEON
+    std::printf("SIMD: NEON\n");
+#else
+    std::printf("SIMD: none (both columns run the generic implementations)\n");
+#endif
+
+    u32 mismatch_num = 0;
+
+    RIO_BENCH_OP("Matrix34 * 34", rio::Matrix34f, Matrix34s,
+                 (o.setMul(a.mtx34, b.mtx34), true),
+                 (o.setMul(as<Matrix34s>(a.mtx34), as<Matrix34s>(b.mtx34)), true));
+
+    RIO_BENCH_OP("Matrix44 * 34", rio::Matrix44f, Matrix44s,
+                 (o.setMul(a.mtx44, b.mtx34), true),
+                 (o.setMul(as<Matrix44s>(a.mtx44), as<Matrix34s>(b.mtx34)), true));
+
+    RIO_BENCH_OP("Quat * Quat", rio::Quatf, Quats,
+                 (o.setMul(a.quat, b.quat), true),
+                 (o.setMul(as<Quats>(a.quat), as<Quats>(b.quat)), true));
+
+    if (mismatch_num != 0)
+    {
+        std::printf("%u results differ.\n", mismatch_num);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+// Memory of ModelCacher when cycling through more models than its budget allows.
+// Each round references a sliding window of models (touching all of their data, as creating
+// mdl::Model instances would), then releases them. The cache size and the resident memory of the
+// process are reported along the rounds, and should stay flat once the budget is reached.
+// The models are generated into fs/content/models, so run it from a scratch directory.
+// (Resident memory is only reported on Linux.)
+// Usage: ModelCacherBench [model_num] [model_size_kib] [budget_mib] [round_num]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/mdl/res/rio_ModelCacher.h>
+#include <gfx/mdl/res/rio_ModelData.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+static const u32 cReferencedNum = 8;    // Models referenced at once
+
+std::string getModelName(u32 index)
+{
+    return "bench_model" + std::to_string(index);
+}
+
+// Write models without meshes nor materials, padded to the given size
+void writeModels(u32 model_num, u32 model_size)
+{
+    mkdir("fs", 0755);
+    mkdir("fs/content", 0755);
+    mkdir("fs/content/models", 0755);
+
+    std::vector<u8> data(model_size, 0);
+    std::memcpy(&data[0], "riomodel", 8);
+
+    const u32 version = rio::mdl::res::Model::cVersionCurrent;
+    std::memcpy(&data[0x08], &version, sizeof(u32));
+    std::memcpy(&data[0x0C], &model_size, sizeof(u32));
+
+    for (u32 i = 0; i < model_num; i++)
+    {
+        const std::string path = "fs/content/models/" + getModelName(i) + "_LE.rmdl";
+
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            std::printf("Failed to write %s.\n", path.c_str());
+            std::exit(1);
+        }
+
+        std::fwrite(data.data(), 1, model_size, file);
+        std::fclose(file);
+    }
+}
+
+// Resident memory of the process in KiB (0 if unknown)
+u64 getResidentKiB()
+{
+#ifdef __linux__
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file)
+        return 0;
+
+    unsigned long long size, resident;
+    const bool success = std::fscanf(file, "%llu %llu", &size, &resident) == 2;
+    std::fclose(file);
+
+    return success ? resident * sysconf(_SC_PAGESIZE) / 1024 : 0;
+#else
+    return 0;
+#endif // __linux__
+}
+
+// Read every page of the model
+u32 touchModel(const rio::mdl::res::Model* model, u32 model_size)
+{
+    const volatile u8* data = (const volatile u8*)model;
+
+    u32 sum = 0;
+    for (u32 i = 0; i < model_size; i += 4096)
+        sum += data[i];
+
+    return sum;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 model_num = argc > 1 ? std::atoi(argv[1]) : 256;
+    const u32 model_size = (argc > 2 ? std::atoi(argv[2]) : 256) * 1024;
+    const size_t budget = size_t(argc > 3 ? std::atoi(argv[3]) : 16) * 1024 * 1024;
+    const u32 round_num = argc > 4 ? std::atoi(argv[4]) : 8;
+
+    if (model_num < cReferencedNum || model_size < sizeof(rio::mdl::res::Model))
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    writeModels(model_num, model_size);
+
+    rio::FileDeviceMgr::createSingleton();
+    rio::mdl::res::ModelCacher::createSingleton();
+
+    rio::mdl::res::ModelCacher* cacher = rio::mdl::res::ModelCacher::instance();
+    cacher->setBudget(budget);
+
+    std::printf("%u models of %u KiB (%u MiB), budget of %u MiB, %u referenced at once\n",
+                model_num, model_size / 1024, u32(u64(model_num) * model_size >> 20), u32(budget >> 20), cReferencedNum);
+    std::printf("%5s %10s %8s %12s %8s %8s %8s %9s\n", "round", "cache KiB", "models", "resident KiB", "hits", "misses", "evicted", "ms");
+
+    const u64 base_resident = getResidentKiB();
+    u32 sum = 0;
+
+    for (u32 round = 0; round < round_num; round++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        // Each step references cReferencedNum consecutive models, so each model is loaded
+        // in cReferencedNum steps in a row, then not before the next round
+        for (u32 step = 0; step < model_num; step++)
+        {
+            std::string keys[cReferencedNum];
+            for (u32 i = 0; i < cReferencedNum; i++)
+            {
+                keys[i] = getModelName((step + i) % model_num);
+
+                const rio::mdl::res::Model* model = cacher->loadModel(keys[i].c_str(), keys[i].c_str());
+                RIO_ASSERT(model);
+                sum += touchModel(model, model_size);
+            }
+
+            for (u32 i = 0; i < cReferencedNum; i++)
+                cacher->releaseModel(keys[i].c_str());
+        }
+
+        const f64 ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("%5u %10u %8u %12lld %8u %8u %8u %9.2f\n", round, u32(cacher->getSize() / 1024), cacher->getModelNum(),
+                    (long long)(getResidentKiB() - base_resident), cacher->getHitNum(), cacher->getMissNum(), cacher->getEvictedNum(), ms);
+    }
+
+    cacher->trim();
+    std::printf("After trim(): %u KiB in %u models, resident %lld KiB (checksum %u)\n", u32(cacher->getSize() / 1024), cacher->getModelNum(),
+                (long long)(getResidentKiB() - base_resident), sum);
+
+    rio::mdl::res::ModelCacher::destroySingleton();
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
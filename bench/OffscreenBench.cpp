@@ -0,0 +1,122 @@
+// Frame times of the same rendering with a normal window, whose frame buffer is presented by
+// swapBuffers() (screen blit, buffer swap and event polling), and with an offscreen one, whose
+// swapBuffers() only flushes the GPU commands. The swap interval is set to 0, so that the frame
+// times are not those of the display. Each frame draws a full screen triangle, and glFinish() is
+// called every frame so that the GPU time is counted in it. The mean, 99th percentile and worst
+// frame times are reported, along with the time spent in swapBuffers().
+// With the EGL backend (RIO_USE_EGL), windows are always offscreen, and both runs are reported as
+// such: the comparison needs a GLFW build.
+// Usage: OffscreenBench [frame_num] [width] [height]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/rio_Window.h>
+#include <gpu/rio_Shader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+static const char* const cVertexShaderSrc =
+    "#version 330 core\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 pos = vec2((gl_VertexID & 1) * 4 - 1, (gl_VertexID & 2) * 2 - 1);\n"
+    "    gl_Position = vec4(pos, 0.0, 1.0);\n"
+    "}\n";
+
+static const char* const cFragmentShaderSrc =
+    "#version 330 core\n"
+    "out vec4 oColor;\n"
+    "void main()\n"
+    "{\n"
+    "    oColor = vec4(fract(gl_FragCoord.xy * 0.01), 0.5, 1.0);\n"
+    "}\n";
+
+f64 getMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<f64, std::milli>(end - start).count();
+}
+
+bool run(u32 frame_num, u32 width, u32 height, bool offscreen)
+{
+    if (!rio::Window::createSingleton(width, height, false, true, 3, 3, offscreen))
+    {
+        std::printf("Failed to create the window.\n");
+        return false;
+    }
+
+    rio::Window* window = rio::Window::instance();
+    window->setSwapInterval(0);
+
+    rio::Shader shader;
+    shader.load(cVertexShaderSrc, cFragmentShaderSrc);
+
+    GLuint vao;
+    RIO_GL_CALL(glGenVertexArrays(1, &vao));
+
+    std::vector<f64> frame_ms;
+    f64 swap_ms = 0.0;
+
+    for (u32 frame = 0; frame < frame_num; frame++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        window->clearColor(0.2f, 0.3f, 0.4f);
+
+        shader.bind();
+        RIO_GL_CALL(glBindVertexArray(vao));
+        RIO_GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 3));
+        RIO_GL_CALL(glBindVertexArray(GL_NONE));
+
+        const auto swap_start = std::chrono::steady_clock::now();
+        window->swapBuffers();
+        RIO_GL_CALL(glFinish());
+
+        const auto end = std::chrono::steady_clock::now();
+        swap_ms += getMs(swap_start, end);
+        frame_ms.push_back(getMs(start, end));
+    }
+
+    f64 total_ms = 0.0;
+    for (f64 ms : frame_ms)
+        total_ms += ms;
+
+    std::sort(frame_ms.begin(), frame_ms.end());
+
+    std::printf("%-10s %-10s mean %7.3f ms, p99 %7.3f ms, worst %7.3f ms (swap %7.3f ms)\n", offscreen ? "Offscreen" : "Normal",
+                window->isOffscreen() ? "(offscreen)" : "(presented)", total_ms / frame_num, frame_ms[frame_num * 99 / 100],
+                frame_ms.back(), swap_ms / frame_num);
+
+    RIO_GL_CALL(glDeleteVertexArrays(1, &vao));
+    shader.unload();
+
+    rio::Window::destroySingleton();
+    return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 frame_num = argc > 1 ? std::atoi(argv[1]) : 300;
+    const u32 width = argc > 2 ? std::atoi(argv[2]) : 1280;
+    const u32 height = argc > 3 ? std::atoi(argv[3]) : 720;
+    if (frame_num == 0 || width == 0 || height == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    rio::FileDeviceMgr::createSingleton();
+
+    std::printf("%u frames of %ux%u\n", frame_num, width, height);
+
+    const bool success = run(frame_num, width, height, false) && run(frame_num, width, height, true);
+
+    rio::FileDeviceMgr::destroySingleton();
+    return success ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+// Load time of many distinct shaders with the program binary cache of Shader (see
+// Shader::setProgramBinaryCache()), with the cache directory emptied first (cold: the programs are
+// compiled, linked and stored), then loading the same shaders again (warm: the programs are created
+// from the stored binaries), and without it for reference.
+// Mesa only supports program binaries along with its own shader cache, which is moved to
+// fs/mesa_shader_cache and emptied first too, so that the cold loads compile the sources. It then
+// holds the shaders compiled by the cold loads, so the loads without the program binary cache
+// only show what the driver's cache alone saves.
+// The cache is written to fs/content/program_cache, so run it from a scratch directory.
+// Usage: ProgramBinaryCacheBench [shader_num]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/rio_Window.h>
+#include <gpu/rio_Shader.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <ftw.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+static const char* const cVertexShaderSrc =
+    "#version 330 core\n"
+    "layout(location = 0) in vec3 aPos;\n"
+    "layout(location = 1) in vec2 aTexCoord;\n"
+    "layout(location = 2) in vec3 aNormal;\n"
+    "uniform mat4 uViewProj;\n"
+    "out vec2 vTexCoord;\n"
+    "out vec3 vNormal;\n"
+    "void main()\n"
+    "{\n"
+    "    vTexCoord = aTexCoord;\n"
+    "    vNormal = aNormal;\n"
+    "    gl_Position = uViewProj * vec4(aPos, 1.0);\n"
+    "}\n";
+
+// Each shader gets a different constant, so that they all have their own binary
+static const char* const cFragmentShaderSrcFmt =
+    "#version 330 core\n"
+    "in vec2 vTexCoord;\n"
+    "in vec3 vNormal;\n"
+    "out vec4 oColor;\n"
+    "uniform vec3 uLightDir[4];\n"
+    "void main()\n"
+    "{\n"
+    "    vec3 n = normalize(vNormal);\n"
+    "    float d = 0.0;\n"
+    "    for (int i = 0; i < 4; i++)\n"
+    "        d += pow(max(dot(n, normalize(uLightDir[i])), 0.0), 8.0 + float(i));\n"
+    "    oColor = vec4(vec3(d * %u.0 / 16.0) * vec3(vTexCoord, 1.0), 1.0);\n"
+    "}\n";
+
+static const char* const cCacheDirPath = "fs/content/program_cache";
+static const char* const cDriverCacheDirPath = "fs/mesa_shader_cache";
+
+s32 removeEntry(const char* path, const struct stat*, s32, FTW*)
+{
+    return remove(path);
+}
+
+// Delete a directory and everything in it (if it exists), and create it again, empty
+void clearDir(const char* path)
+{
+    nftw(path, &removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+    if (mkdir(path, 0755) != 0)
+    {
+        std::printf("Failed to create %s.\n", path);
+        std::exit(1);
+    }
+}
+
+u32 getCacheFileNum()
+{
+    DIR* dir = opendir(cCacheDirPath);
+    if (!dir)
+        return 0;
+
+    u32 num = 0;
+    while (const dirent* entry = readdir(dir))
+        num += entry->d_name[0] != '.';
+
+    closedir(dir);
+    return num;
+}
+
+f64 getMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<f64, std::milli>(end - start).count();
+}
+
+// Load and unload all shaders, returns the time taken by the loads
+f64 loadShaders(const std::vector<std::string>& fragment_shader_srcs)
+{
+    std::vector<rio::Shader> shaders(fragment_shader_srcs.size());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < shaders.size(); i++)
+        shaders[i].load(cVertexShaderSrc, fragment_shader_srcs[i].c_str());
+    const f64 ms = getMs(start, std::chrono::steady_clock::now());
+
+    for (rio::Shader& shader : shaders)
+        shader.unload();
+
+    return ms;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 shader_num = argc > 1 ? std::atoi(argv[1]) : 32;
+    if (shader_num == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    mkdir("fs", 0755);
+    mkdir("fs/content", 0755);
+
+    const u32 deleted_num = getCacheFileNum();
+    clearDir(cCacheDirPath);
+    clearDir(cDriverCacheDirPath);
+    setenv("MESA_SHADER_CACHE_DIR", cDriverCacheDirPath, 1);
+
+    rio::FileDeviceMgr::createSingleton();
+    if (!rio::Window::createSingleton(64, 64, false, true, 3, 3, true))
+    {
+        std::printf("Failed to create the window.\n");
+        return 1;
+    }
+
+    std::vector<std::string> fragment_shader_srcs(shader_num);
+    for (u32 i = 0; i < shader_num; i++)
+    {
+        char fragment_shader_src[1024];
+        std::snprintf(fragment_shader_src, sizeof(fragment_shader_src), cFragmentShaderSrcFmt, i + 1);
+        fragment_shader_srcs[i] = fragment_shader_src;
+    }
+
+    std::printf("%u shaders (%u cached binaries deleted)\n", shader_num, deleted_num);
+
+    rio::Shader::setProgramBinaryCache(rio::FileDeviceMgr::instance()->getDefaultFileDevice(), "program_cache");
+
+    const f64 cold_ms = loadShaders(fragment_shader_srcs);
+    const u32 cached_num = getCacheFileNum();
+    std::printf("Cold:              %8.2f ms (%.2f ms per shader), %u binaries stored\n", cold_ms, cold_ms / shader_num, cached_num);
+
+    const f64 warm_ms = loadShaders(fragment_shader_srcs);
+    std::printf("Warm:              %8.2f ms (%.2f ms per shader, x%.1f)\n", warm_ms, warm_ms / shader_num, cold_ms / warm_ms);
+
+    rio::Shader::setProgramBinaryCache(nullptr);
+
+    const f64 uncached_ms = loadShaders(fragment_shader_srcs);
+    std::printf("Driver cache only: %8.2f ms (%.2f ms per shader)\n", uncached_ms, uncached_ms / shader_num);
+
+    rio::Window::destroySingleton();
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
@@ -0,0 +1,185 @@
+// Frame rate of rendering frames and reading them back to memory, with a synchronous glReadPixels()
+// every frame, and with Window::requestReadback() and tryGetReadback(), which read the frames back
+// a few frames later through pixel pack buffers, without waiting for the GPU.
+// Each frame draws a full screen triangle whose fragment shader does some work (fragment_loop_num
+// iterations) and writes the frame number into its red channel, which is checked in every frame read.
+// Usage: ReadbackBench [frame_num] [fragment_loop_num] [width] [height]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/rio_Window.h>
+#include <gpu/rio_Shader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+static const char* const cVertexShaderSrc =
+    "#version 330 core\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 pos = vec2((gl_VertexID & 1) * 4 - 1, (gl_VertexID & 2) * 2 - 1);\n"
+    "    gl_Position = vec4(pos, 0.0, 1.0);\n"
+    "}\n";
+
+static const char* const cFragmentShaderSrc =
+    "#version 330 core\n"
+    "uniform float uFrame;\n"
+    "uniform int uLoopNum;\n"
+    "out vec4 oColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float x = gl_FragCoord.x * 0.001;\n"
+    "    for (int i = 0; i < uLoopNum; i++)\n"
+    "        x = fract(x * 1.7 + 0.3);\n"
+    "    oColor = vec4(uFrame, x, 0.0, 1.0);\n"
+    "}\n";
+
+struct Context
+{
+    rio::Shader shader;
+    u32         frame_location;
+    u32         loop_num_location;
+    GLuint      vao;
+    u32         loop_num;
+};
+
+void drawFrame(Context& context, u32 frame)
+{
+    rio::Window::instance()->clearColor(0.0f, 0.0f, 0.0f);
+
+    context.shader.bind();
+    rio::Shader::setUniform(f32(frame % 256) / 255.0f, u32(-1), context.frame_location);
+    rio::Shader::setUniform(s32(context.loop_num), u32(-1), context.loop_num_location);
+
+    RIO_GL_CALL(glBindVertexArray(context.vao));
+    RIO_GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 3));
+    RIO_GL_CALL(glBindVertexArray(GL_NONE));
+}
+
+// Check the red channel of the center pixel against the frame it was read from
+bool checkPixels(const std::vector<u8>& pixels, u32 frame)
+{
+    const rio::Window* window = rio::Window::instance();
+    const u32 offset = ((window->getHeight() / 2) * window->getWidth() + window->getWidth() / 2) * 4;
+    return pixels[offset] == frame % 256;
+}
+
+f64 getMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<f64, std::milli>(end - start).count();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 frame_num = argc > 1 ? std::atoi(argv[1]) : 300;
+    const u32 loop_num = argc > 2 ? std::atoi(argv[2]) : 16;
+    const u32 width = argc > 3 ? std::atoi(argv[3]) : 1280;
+    const u32 height = argc > 4 ? std::atoi(argv[4]) : 720;
+    if (frame_num == 0 || width == 0 || height == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    rio::FileDeviceMgr::createSingleton();
+    if (!rio::Window::createSingleton(width, height, false, true, 3, 3, true))
+    {
+        std::printf("Failed to create the window.\n");
+        return 1;
+    }
+
+    rio::Window* window = rio::Window::instance();
+
+    Context context;
+    context.shader.load(cVertexShaderSrc, cFragmentShaderSrc);
+    context.frame_location = context.shader.getFragmentUniformLocation("uFrame");
+    context.loop_num_location = context.shader.getFragmentUniformLocation("uLoopNum");
+    context.loop_num = loop_num;
+    RIO_GL_CALL(glGenVertexArrays(1, &context.vao));
+
+    std::vector<u8> pixels(width * height * 4);
+    u32 bad_num = 0;
+
+    std::printf("%u frames of %ux%u, %u fragment shader iterations\n", frame_num, width, height, loop_num);
+
+    // Synchronous: the CPU waits for the GPU to finish each frame before reading it
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 frame = 0; frame < frame_num; frame++)
+        {
+            drawFrame(context, frame);
+
+            RIO_GL_CALL(glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+            if (!checkPixels(pixels, frame))
+                bad_num++;
+
+            window->swapBuffers();
+        }
+        const f64 ms = getMs(start, std::chrono::steady_clock::now());
+
+        std::printf("glReadPixels:  %8.1f FPS (%7.3f ms per frame), %u frames read\n", frame_num * 1000.0 / ms, ms / frame_num, frame_num);
+    }
+
+    // Asynchronous: each frame queues a readback, and the oldest ones are retrieved once ready
+    {
+        std::vector<u32> queued_frame;
+        u32 read_num = 0;
+        u32 max_latency = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 frame = 0; frame < frame_num; frame++)
+        {
+            drawFrame(context, frame);
+
+            // Retrieve the readbacks which are ready, waiting for the oldest one only if all buffers are in flight
+            while (window->getReadbackNum() != 0)
+            {
+                const bool wait = window->getReadbackNum() == rio::NativeWindow::cReadbackBufferNum;
+                if (!window->tryGetReadback(pixels.data(), nullptr, wait))
+                    break;
+
+                if (!checkPixels(pixels, queued_frame[read_num]))
+                    bad_num++;
+
+                max_latency = std::max(max_latency, frame - queued_frame[read_num]);
+                read_num++;
+            }
+
+            if (window->requestReadback())
+                queued_frame.push_back(frame);
+
+            window->swapBuffers();
+        }
+
+        while (window->tryGetReadback(pixels.data(), nullptr, true))
+        {
+            if (!checkPixels(pixels, queued_frame[read_num]))
+                bad_num++;
+
+            read_num++;
+        }
+        const f64 ms = getMs(start, std::chrono::steady_clock::now());
+
+        std::printf("Readback:      %8.1f FPS (%7.3f ms per frame), %u frames read, up to %u frames late\n", frame_num * 1000.0 / ms, ms / frame_num, read_num, max_latency);
+    }
+
+    RIO_GL_CALL(glDeleteVertexArrays(1, &context.vao));
+    context.shader.unload();
+
+    rio::Window::destroySingleton();
+    rio::FileDeviceMgr::destroySingleton();
+
+    if (bad_num != 0)
+    {
+        std::printf("%u frames read with unexpected contents.\n", bad_num);
+        return 1;
+    }
+
+    return 0;
+}
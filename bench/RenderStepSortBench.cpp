@@ -0,0 +1,184 @@
+// CPU time per frame of rendering a layer with many draw methods through lyr::Renderer, whose
+// render steps keep their draw methods in an array radix sorted by sort key, compared with the
+// std::multiset of draw methods render steps used before. The draw methods do no GPU work (they
+// only record the order they are called in), so that only the sorting and dispatching is timed.
+// Both are timed with the draw methods added again every frame, and added once and drawn every
+// frame, and the orders in which the draw methods are called are compared.
+// Usage: RenderStepSortBench [draw_method_num] [frame_num]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/lyr/rio_Renderer.h>
+#include <gfx/rio_Window.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+// Hash of the order the draw methods are called in
+u64 sOrderHash = 0;
+
+class BenchDrawable : public rio::lyr::IDrawable
+{
+public:
+    explicit BenchDrawable(u32 id)
+        : mID(id)
+    {
+    }
+
+    void draw(const rio::lyr::DrawInfo&)
+    {
+        sOrderHash = sOrderHash * 31 + mID;
+    }
+
+private:
+    u32 mID;
+};
+
+// Draw method as it was stored in the multiset of a render step
+struct MultisetDrawMethod
+{
+    bool operator<(const MultisetDrawMethod& rhs) const
+    {
+        return sort_key < rhs.sort_key;
+    }
+
+    rio::lyr::IDrawable*            obj_ptr;
+    rio::lyr::IDrawable::DrawMethod func_ptr;
+    u64                             sort_key;
+};
+
+struct DrawMethodDesc
+{
+    BenchDrawable*  drawable;
+    s32             priority;
+    u32             user_key;
+};
+
+f64 getMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<f64, std::milli>(end - start).count();
+}
+
+void addToMultiset(std::multiset<MultisetDrawMethod>& draw_methods, const std::vector<DrawMethodDesc>& descs)
+{
+    for (const DrawMethodDesc& desc : descs)
+    {
+        const rio::lyr::DrawMethod draw_method(desc.drawable, &BenchDrawable::draw, desc.priority, desc.user_key);
+        draw_methods.insert({ desc.drawable, static_cast<rio::lyr::IDrawable::DrawMethod>(&BenchDrawable::draw), draw_method.sortKey() });
+    }
+}
+
+void renderMultiset(const std::multiset<MultisetDrawMethod>& draw_methods, const rio::lyr::Layer& layer)
+{
+    for (const MultisetDrawMethod& draw_method : draw_methods)
+        (draw_method.obj_ptr->*(draw_method.func_ptr))({ layer, 0 });
+}
+
+void addToLayer(rio::lyr::Layer& layer, const std::vector<DrawMethodDesc>& descs)
+{
+    for (const DrawMethodDesc& desc : descs)
+        layer.addDrawMethod(0, rio::lyr::DrawMethod(desc.drawable, &BenchDrawable::draw, desc.priority, desc.user_key));
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 draw_method_num = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const u32 frame_num = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (draw_method_num == 0 || frame_num == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    // The renderer sets the viewport and scissor of the window
+    rio::FileDeviceMgr::createSingleton();
+    if (!rio::Window::createSingleton(256, 256, false, true, 3, 3, true))
+    {
+        std::printf("Failed to create the window.\n");
+        return 1;
+    }
+    rio::lyr::Renderer::createSingleton();
+
+    rio::lyr::Layer::iterator layer_it = rio::lyr::Renderer::instance()->addLayer("Bench");
+    rio::lyr::Layer& layer = *rio::lyr::Layer::peelIterator(layer_it);
+    layer.addRenderStep("Bench");
+
+    // A few priorities, and user keys made of shader, material and depth bits, with duplicates
+    std::mt19937 rng(1);
+    std::vector<BenchDrawable> drawables;
+    drawables.reserve(draw_method_num);
+    std::vector<DrawMethodDesc> descs(draw_method_num);
+    for (u32 i = 0; i < draw_method_num; i++)
+    {
+        drawables.emplace_back(i);
+        descs[i].drawable = &drawables[i];
+        descs[i].priority = s32(rng() % 4);
+        descs[i].user_key = (rng() % 8) << 28 | (rng() % 64) << 16 | (rng() % 1024);
+    }
+
+    std::printf("%u draw methods, %u frames\n", draw_method_num, frame_num);
+
+    for (bool rebuild : { true, false })
+    {
+        f64 ms[2];
+        u64 order_hash[2];
+
+        // std::multiset
+        {
+            std::multiset<MultisetDrawMethod> draw_methods;
+            if (!rebuild)
+                addToMultiset(draw_methods, descs);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (u32 frame = 0; frame < frame_num; frame++)
+            {
+                sOrderHash = 0;
+                if (rebuild)
+                {
+                    draw_methods.clear();
+                    addToMultiset(draw_methods, descs);
+                }
+                renderMultiset(draw_methods, layer);
+            }
+            ms[0] = getMs(start, std::chrono::steady_clock::now()) / frame_num;
+            order_hash[0] = sOrderHash;
+        }
+
+        // RenderStep
+        {
+            layer.clearDrawMethodsAll();
+            if (!rebuild)
+                addToLayer(layer, descs);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (u32 frame = 0; frame < frame_num; frame++)
+            {
+                sOrderHash = 0;
+                if (rebuild)
+                {
+                    layer.clearDrawMethods(0);
+                    addToLayer(layer, descs);
+                }
+                rio::lyr::Renderer::instance()->render();
+            }
+            ms[1] = getMs(start, std::chrono::steady_clock::now()) / frame_num;
+            order_hash[1] = sOrderHash;
+        }
+
+        std::printf("%s\n", rebuild ? "Added every frame:" : "Added once:");
+        std::printf("  std::multiset: %8.1f us per frame\n", ms[0] * 1000.0);
+        std::printf("  RenderStep:    %8.1f us per frame (x%.2f), same order: %s\n", ms[1] * 1000.0, ms[0] / ms[1], order_hash[0] == order_hash[1] ? "yes" : "NO");
+    }
+
+    rio::lyr::Renderer::destroySingleton();
+    rio::Window::destroySingleton();
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
@@ -0,0 +1,192 @@
+// Requests per second of RenderWorkerMgr when rendering the same mesh, by number of workers.
+// Each request renders a sphere of cSegmentNum * cSegmentNum * 2 triangles into the worker's
+// render buffer, and reads the color buffer back.
+// Usage: RenderWorkerBench [max_worker_num] [request_num]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/rio_Window.h>
+#include <gfx/win/rio_RenderWorkerMgrWin.h>
+#include <gpu/rio_Drawer.h>
+#include <gpu/rio_RenderState.h>
+#include <gpu/rio_Shader.h>
+#include <gpu/rio_VertexArray.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+static const u32 cSegmentNum = 192;
+static const u32 cBufferSize = 256;
+
+static const char* const cVertexShaderSrc =
+    "#version 330 core\n"
+    "layout(location = 0) in vec3 aPos;\n"
+    "uniform float uAngle;\n"
+    "out vec3 vNormal;\n"
+    "void main()\n"
+    "{\n"
+    "    float c = cos(uAngle), s = sin(uAngle);\n"
+    "    vec3 p = vec3(c * aPos.x + s * aPos.z, aPos.y, c * aPos.z - s * aPos.x);\n"
+    "    vNormal = p;\n"
+    "    gl_Position = vec4(p.xy * 0.9, p.z * 0.5, 1.0);\n"
+    "}\n";
+
+static const char* const cFragmentShaderSrc =
+    "#version 330 core\n"
+    "in vec3 vNormal;\n"
+    "out vec4 oColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float d = max(dot(normalize(vNormal), normalize(vec3(0.3, 0.5, -1.0))), 0.0);\n"
+    "    oColor = vec4(vec3(0.1 + 0.9 * d), 1.0);\n"
+    "}\n";
+
+struct Scene
+{
+    rio::Shader         shader;
+    u32                 angle_location;
+    rio::VertexBuffer*  vertex_buffer;
+    rio::IndexBuffer*   index_buffer;
+    rio::VertexArray*   vertex_array;
+};
+
+struct Request
+{
+    const Scene*    scene;
+    f32             angle;
+    std::vector<u8> pixels;
+};
+
+void createScene(Scene* scene, std::vector<f32>* vertices, std::vector<u32>* indices)
+{
+    for (u32 y = 0; y <= cSegmentNum; y++)
+    {
+        const f32 theta = 3.14159265f * y / cSegmentNum;
+        for (u32 x = 0; x <= cSegmentNum; x++)
+        {
+            const f32 phi = 6.28318531f * x / cSegmentNum;
+            vertices->push_back(std::sin(theta) * std::cos(phi));
+            vertices->push_back(std::cos(theta));
+            vertices->push_back(std::sin(theta) * std::sin(phi));
+        }
+    }
+
+    for (u32 y = 0; y < cSegmentNum; y++)
+    {
+        for (u32 x = 0; x < cSegmentNum; x++)
+        {
+            const u32 i = y * (cSegmentNum + 1) + x;
+            indices->insert(indices->end(), { i, i + cSegmentNum + 1, i + 1, i + 1, i + cSegmentNum + 1, i + cSegmentNum + 2 });
+        }
+    }
+
+    static rio::VertexStream pos_stream(0, rio::VertexStream::FORMAT_32_32_32_FLOAT, 0);
+
+    scene->shader.load(cVertexShaderSrc, cFragmentShaderSrc);
+    scene->angle_location = scene->shader.getVertexUniformLocation("uAngle");
+
+    scene->vertex_buffer = new rio::VertexBuffer(vertices->data(), vertices->size() * sizeof(f32), 3 * sizeof(f32));
+    scene->index_buffer = new rio::IndexBuffer(indices->data(), indices->size());
+
+    scene->vertex_array = new rio::VertexArray();
+    scene->vertex_array->initialize();
+    scene->vertex_array->addAttribute(pos_stream, *scene->vertex_buffer);
+    scene->vertex_array->setIndexBuffer(scene->index_buffer);
+    scene->vertex_array->process();
+}
+
+void render(rio::RenderWorker& worker, void* arg)
+{
+    Request& request = *static_cast<Request*>(arg);
+    const Scene& scene = *request.scene;
+
+    worker.getRenderBuffer().clear(rio::RenderBuffer::CLEAR_FLAG_COLOR_DEPTH_STENCIL, rio::Color4f::cBlack);
+
+    rio::RenderState render_state;
+    render_state.setDepthEnable(true, true);
+    render_state.apply();
+
+    scene.shader.bind();
+    rio::Shader::setUniform(request.angle, scene.angle_location, u32(-1));
+    scene.vertex_array->bind();
+    rio::Drawer::DrawElements(rio::Drawer::TRIANGLES, *scene.index_buffer);
+
+    worker.readColor(request.pixels.data());
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    u32 max_worker_num = argc > 1 ? std::atoi(argv[1]) : rio::RenderWorkerMgr::cWorkerMaxNum;
+    const u32 request_num = argc > 2 ? std::atoi(argv[2]) : 256;
+
+    if (max_worker_num == 0 || max_worker_num > rio::RenderWorkerMgr::cWorkerMaxNum)
+        max_worker_num = rio::RenderWorkerMgr::cWorkerMaxNum;
+
+    rio::FileDeviceMgr::createSingleton();
+    if (!rio::Window::createSingleton(cBufferSize, cBufferSize, false, true, 3, 3, true))
+    {
+        std::printf("Failed to create the window.\n");
+        return 1;
+    }
+
+    Scene scene;
+    std::vector<f32> vertices;
+    std::vector<u32> indices;
+    createScene(&scene, &vertices, &indices);
+
+    std::vector<Request> requests(request_num);
+    for (u32 i = 0; i < request_num; i++)
+    {
+        requests[i].scene = &scene;
+        requests[i].angle = 0.01f * i;
+        requests[i].pixels.resize(cBufferSize * cBufferSize * 4);
+    }
+
+    std::printf("%u triangles, %ux%u, %u requests\n", u32(indices.size() / 3), cBufferSize, cBufferSize, request_num);
+
+    f64 base_rate = 0.0;
+    for (u32 worker_num = 1; worker_num <= max_worker_num; worker_num *= 2)
+    {
+        // The pool is recreated for each run, along with the vertex arrays of its workers
+        if (!rio::RenderWorkerMgr::createSingleton(worker_num, cBufferSize, cBufferSize))
+        {
+            std::printf("Failed to create %u workers.\n", worker_num);
+            break;
+        }
+        rio::RenderWorkerMgr* mgr = rio::RenderWorkerMgr::instance();
+
+        // Warm up (creates the vertex arrays of the workers)
+        for (u32 i = 0; i < worker_num; i++)
+            mgr->submit(&render, &requests[i]);
+        mgr->wait();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < request_num; i++)
+            mgr->submit(&render, &requests[i]);
+        mgr->wait();
+        const f64 seconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+
+        const f64 rate = request_num / seconds;
+        if (worker_num == 1)
+            base_rate = rate;
+
+        std::printf("%2u workers: %8.1f requests/s (x%.2f)\n", worker_num, rate, rate / base_rate);
+
+        rio::RenderWorkerMgr::destroySingleton();
+    }
+
+    delete scene.vertex_array;
+    delete scene.index_buffer;
+    delete scene.vertex_buffer;
+    scene.shader.unload();
+
+    rio::Window::destroySingleton();
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
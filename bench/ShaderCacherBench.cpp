@@ -0,0 +1,271 @@
+// Load time and resident memory growth of many models whose materials share a few shaders, with
+// ShaderCacher, compared with loading one shader per material (as materials did before ShaderCacher).
+// (Resident memory is only reported on Linux.)
+// The models and shaders are generated into fs/content/models and fs/content/shaders,
+// so run it from a scratch directory.
+// Usage: ShaderCacherBench [model_num] [shader_num]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/mdl/res/rio_ModelCacher.h>
+#include <gfx/mdl/rio_Model.h>
+#include <gfx/rio_Window.h>
+#include <gpu/rio_ShaderCacher.h>
+#include <gpu/rio_TextureCacher.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+static const char* const cVertexShaderSrc =
+    "#version 330 core\n"
+    "layout(location = 0) in vec3 aPos;\n"
+    "layout(location = 1) in vec2 aTexCoord;\n"
+    "layout(location = 2) in vec3 aNormal;\n"
+    "uniform mat4 uViewProj;\n"
+    "out vec2 vTexCoord;\n"
+    "out vec3 vNormal;\n"
+    "void main()\n"
+    "{\n"
+    "    vTexCoord = aTexCoord;\n"
+    "    vNormal = aNormal;\n"
+    "    gl_Position = uViewProj * vec4(aPos, 1.0);\n"
+    "}\n";
+
+// Each shader gets a different constant, so that the driver can not share them
+static const char* const cFragmentShaderSrcFmt =
+    "#version 330 core\n"
+    "in vec2 vTexCoord;\n"
+    "in vec3 vNormal;\n"
+    "out vec4 oColor;\n"
+    "uniform vec3 uLightDir[4];\n"
+    "void main()\n"
+    "{\n"
+    "    vec3 n = normalize(vNormal);\n"
+    "    float d = 0.0;\n"
+    "    for (int i = 0; i < 4; i++)\n"
+    "        d += pow(max(dot(n, normalize(uLightDir[i])), 0.0), 8.0 + float(i));\n"
+    "    oColor = vec4(vec3(d * %u.0 / 16.0) * vec3(vTexCoord, 1.0), 1.0);\n"
+    "}\n";
+
+void writeFile(const std::string& path, const void* data, size_t size)
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        std::printf("Failed to write %s.\n", path.c_str());
+        std::exit(1);
+    }
+
+    std::fwrite(data, 1, size, file);
+    std::fclose(file);
+}
+
+template <typename T>
+void put(std::vector<u8>& data, u32 offset, T value)
+{
+    std::memcpy(&data[offset], &value, sizeof(T));
+}
+
+// Set the relative offset and count of a res::Buffer field
+void putBuffer(std::vector<u8>& data, u32 field_offset, u32 target_offset, u32 count)
+{
+    put<s32>(data, field_offset, s32(target_offset - field_offset));
+    put<u32>(data, field_offset + 4, count);
+}
+
+// Write a model with one quad mesh and one material using the given shader
+// (see the layouts of res::Model, res::Mesh and res::Material)
+void writeModel(const std::string& path, const char* shader_name)
+{
+    static const char cMaterialName[] = "material";
+    const u32 shader_name_size = std::strlen(shader_name) + 1;
+
+    const u32 mesh_offset = 0x20;
+    const u32 material_offset = mesh_offset + sizeof(rio::mdl::res::Mesh);
+    const u32 material_name_offset = material_offset + sizeof(rio::mdl::res::Material);
+    const u32 shader_name_offset = material_name_offset + sizeof(cMaterialName);
+    const u32 vertex_offset = (shader_name_offset + shader_name_size + 3) & ~3u;
+    const u32 index_offset = vertex_offset + 4 * sizeof(rio::mdl::res::Vertex);
+    const u32 size = index_offset + 6 * sizeof(u32);
+
+    std::vector<u8> data(size, 0);
+
+    std::memcpy(&data[0], "riomodel", 8);
+    put<u32>(data, 0x08, rio::mdl::res::Model::cVersionCurrent);
+    put<u32>(data, 0x0C, size);
+    putBuffer(data, 0x10, mesh_offset, 1);
+    putBuffer(data, 0x18, material_offset, 1);
+
+    putBuffer(data, mesh_offset + 0x00, vertex_offset, 4);
+    putBuffer(data, mesh_offset + 0x08, index_offset, 6);
+    for (u32 i = 0; i < 3; i++)
+        put<f32>(data, mesh_offset + 0x10 + i * 4, 1.0f);      // Scale
+
+    putBuffer(data, material_offset + 0x00, material_name_offset, sizeof(cMaterialName));
+    putBuffer(data, material_offset + 0x08, shader_name_offset, shader_name_size);
+    put<u16>(data, material_offset + 0x28, 1);                  // Visible
+    put<u16>(data, material_offset + 0x2A, rio::mdl::res::Material::DEPTH_TEST_ENABLE | rio::mdl::res::Material::DEPTH_WRITE_ENABLE |
+                                           rio::mdl::res::Material::COLOR_MASK_R | rio::mdl::res::Material::COLOR_MASK_G |
+                                           rio::mdl::res::Material::COLOR_MASK_B | rio::mdl::res::Material::COLOR_MASK_A);
+    put<u32>(data, material_offset + 0x2C, rio::mdl::res::Material::COMPARE_FUNC_LEQUAL);
+    put<u32>(data, material_offset + 0x30, rio::mdl::res::Material::CULLING_MODE_BACK);
+    put<u32>(data, material_offset + 0x34, rio::mdl::res::Material::BLEND_MODE_ONE);
+    put<u32>(data, material_offset + 0x38, rio::mdl::res::Material::BLEND_MODE_ONE);
+    put<u32>(data, material_offset + 0x7C, rio::mdl::res::Material::POLYGON_MODE_FILL);
+
+    std::memcpy(&data[material_name_offset], cMaterialName, sizeof(cMaterialName));
+    std::memcpy(&data[shader_name_offset], shader_name, shader_name_size);
+
+    static const f32 cVertices[4][8] = {
+        { -1.0f, -1.0f, 0.0f,   0.0f, 0.0f,   0.0f, 0.0f, 1.0f },
+        {  1.0f, -1.0f, 0.0f,   1.0f, 0.0f,   0.0f, 0.0f, 1.0f },
+        {  1.0f,  1.0f, 0.0f,   1.0f, 1.0f,   0.0f, 0.0f, 1.0f },
+        { -1.0f,  1.0f, 0.0f,   0.0f, 1.0f,   0.0f, 0.0f, 1.0f }
+    };
+    static const u32 cIndices[6] = { 0, 1, 2, 2, 3, 0 };
+
+    std::memcpy(&data[vertex_offset], cVertices, sizeof(cVertices));
+    std::memcpy(&data[index_offset], cIndices, sizeof(cIndices));
+
+    writeFile(path, data.data(), size);
+}
+
+std::string getShaderName(u32 index)
+{
+    return "bench_shader" + std::to_string(index);
+}
+
+std::string getModelName(u32 index)
+{
+    return "bench_model" + std::to_string(index);
+}
+
+void writeContent(u32 model_num, u32 shader_num)
+{
+    mkdir("fs", 0755);
+    mkdir("fs/content", 0755);
+    mkdir("fs/content/shaders", 0755);
+    mkdir("fs/content/models", 0755);
+
+    for (u32 i = 0; i < shader_num; i++)
+    {
+        char fragment_shader_src[1024];
+        const u32 len = std::snprintf(fragment_shader_src, sizeof(fragment_shader_src), cFragmentShaderSrcFmt, i + 1);
+
+        const std::string base_path = "fs/content/shaders/" + getShaderName(i);
+        writeFile(base_path + ".vert", cVertexShaderSrc, std::strlen(cVertexShaderSrc));
+        writeFile(base_path + ".frag", fragment_shader_src, len);
+    }
+
+    for (u32 i = 0; i < model_num; i++)
+        writeModel("fs/content/models/" + getModelName(i) + "_LE.rmdl", getShaderName(i % shader_num).c_str());
+}
+
+// Resident memory of the process in KiB, including the driver's (0 if unknown)
+u64 getResidentKiB()
+{
+#ifdef __linux__
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file)
+        return 0;
+
+    unsigned long long size, resident;
+    const bool success = std::fscanf(file, "%llu %llu", &size, &resident) == 2;
+    std::fclose(file);
+
+    return success ? resident * sysconf(_SC_PAGESIZE) / 1024 : 0;
+#else
+    return 0;
+#endif // __linux__
+}
+
+f64 getElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 model_num = argc > 1 ? std::atoi(argv[1]) : 200;
+    u32 shader_num = argc > 2 ? std::atoi(argv[2]) : 3;
+    if (shader_num == 0)
+        shader_num = 1;
+
+    writeContent(model_num, shader_num);
+
+    rio::FileDeviceMgr::createSingleton();
+    if (!rio::Window::createSingleton(64, 64, false, true, 3, 3, true))
+    {
+        std::printf("Failed to create the window.\n");
+        return 1;
+    }
+    rio::mdl::res::ModelCacher::createSingleton();
+    rio::ShaderCacher::createSingleton();
+    rio::TextureCacher::createSingleton();
+
+    std::printf("%u models sharing %u shaders\n", model_num, shader_num);
+
+    // Before ShaderCacher: one shader compiled and linked per material
+    {
+        const u64 resident = getResidentKiB();
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<rio::Shader*> shaders(model_num);
+        for (u32 i = 0; i < model_num; i++)
+        {
+            shaders[i] = new rio::Shader();
+            shaders[i]->loadAsync(getShaderName(i % shader_num).c_str());
+        }
+        for (u32 i = 0; i < model_num; i++)
+            shaders[i]->getVertexUniformLocation("uViewProj");  // Waits for the link
+
+        const f64 ms = getElapsedMs(start);
+        std::printf("One shader per material: %8.2f ms, %6lld KiB (%u programs)\n", ms, (long long)(getResidentKiB() - resident), model_num);
+
+        for (u32 i = 0; i < model_num; i++)
+            delete shaders[i];
+    }
+
+    // Models loaded through ModelCacher, with their materials using ShaderCacher
+    {
+        const u64 resident = getResidentKiB();
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<rio::mdl::Model*> models(model_num);
+        for (u32 i = 0; i < model_num; i++)
+        {
+            const std::string name = getModelName(i);
+            const rio::mdl::res::Model* res_model = rio::mdl::res::ModelCacher::instance()->loadModel(name.c_str(), name.c_str());
+            RIO_ASSERT(res_model);
+            models[i] = new rio::mdl::Model(res_model);
+        }
+        for (u32 i = 0; i < model_num; i++)
+            while (!models[i]->material(0).isReady())
+                ;
+
+        const f64 ms = getElapsedMs(start);
+        std::printf("ShaderCacher:            %8.2f ms, %6lld KiB (%u programs)\n", ms, (long long)(getResidentKiB() - resident), rio::ShaderCacher::instance()->getShaderNum());
+
+        for (u32 i = 0; i < model_num; i++)
+        {
+            delete models[i];
+            rio::mdl::res::ModelCacher::instance()->releaseModel(getModelName(i).c_str());
+        }
+    }
+
+    rio::TextureCacher::destroySingleton();
+    rio::ShaderCacher::destroySingleton();
+    rio::mdl::res::ModelCacher::destroySingleton();
+    rio::Window::destroySingleton();
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
@@ -0,0 +1,172 @@
+// Time per task of creating and destroying tasks through TaskMgr, whose tasks are allocated from
+// a pool per task type, compared with allocating the same objects with new and delete. Each frame
+// creates a batch of short-lived tasks, runs them once and destroys them, with a task type whose
+// ITask base is not its first base (so that it does not start at the address of its block).
+// Usage: TaskPoolBench [task_num] [frame_num]
+
+#include <task/rio_TaskMgr.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+class SimpleTask : public rio::ITask
+{
+public:
+    SimpleTask()
+        : rio::ITask("SimpleTask")
+        , mValue(0)
+    {
+    }
+
+    static u32 sCalcNum;
+
+protected:
+    void calc_() override
+    {
+        mValue++;
+        sCalcNum++;
+    }
+
+    u32 mValue;
+};
+
+u32 SimpleTask::sCalcNum = 0;
+
+struct Payload
+{
+    virtual ~Payload()
+    {
+    }
+
+    f32 data[6];
+};
+
+class PayloadTask : public Payload, public rio::ITask
+{
+public:
+    PayloadTask()
+        : rio::ITask("PayloadTask")
+    {
+        for (f32& x : data)
+            x = 0.0f;
+    }
+
+    static u32 sCalcNum;
+
+protected:
+    void calc_() override
+    {
+        data[0] += 1.0f;
+        sCalcNum++;
+    }
+};
+
+u32 PayloadTask::sCalcNum = 0;
+
+// Frame of the pool case: create the tasks, run them once, then destroy them
+template <typename T>
+void poolFrame(rio::TaskMgr* mgr, std::vector<T*>* tasks)
+{
+    for (T*& task : *tasks)
+        task = mgr->createTask<T>();
+
+    mgr->calc();
+
+    for (T* task : *tasks)
+        mgr->requestDestroyTask(task);
+
+    mgr->calc();
+}
+
+// Task type with calc_() exposed, for the new and delete case
+template <typename T>
+struct HeapTask : T
+{
+    void calc() { this->calc_(); }
+};
+
+// Frame of the new and delete case, doing the same work without TaskMgr
+template <typename T>
+void heapFrame(std::vector<HeapTask<T>*>* tasks)
+{
+    for (HeapTask<T>*& task : *tasks)
+        task = new HeapTask<T>;
+
+    for (HeapTask<T>* task : *tasks)
+        task->calc();
+
+    for (HeapTask<T>* task : *tasks)
+        delete task;
+}
+
+template <typename T>
+void run(const char* name, rio::TaskMgr* mgr, u32 task_num, u32 frame_num, bool reserve)
+{
+    if (reserve)
+        mgr->reserveTask<T>(task_num);
+
+    std::vector<T*> pool_tasks(task_num);
+    std::vector<HeapTask<T>*> heap_tasks(task_num);
+
+    // Warm up
+    poolFrame(mgr, &pool_tasks);
+    heapFrame(&heap_tasks);
+
+    auto start = std::chrono::steady_clock::now();
+    for (u32 frame = 0; frame < frame_num; frame++)
+        poolFrame(mgr, &pool_tasks);
+    const f64 pool_ns = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count() / (u64(frame_num) * task_num);
+
+    start = std::chrono::steady_clock::now();
+    for (u32 frame = 0; frame < frame_num; frame++)
+        heapFrame(&heap_tasks);
+    const f64 heap_ns = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count() / (u64(frame_num) * task_num);
+
+    std::printf("%-12s %9s %14.1f %14.1f %8.2fx\n", name, reserve ? "yes" : "no", pool_ns, heap_ns, heap_ns / pool_ns);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 task_num = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const u32 frame_num = argc > 2 ? std::atoi(argv[2]) : 500;
+    if (task_num == 0 || frame_num == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    // Everything on the main thread, so that only allocation and bookkeeping are measured
+    if (!rio::TaskMgr::createSingleton(0))
+    {
+        std::printf("Failed to create the task manager.\n");
+        return 1;
+    }
+
+    rio::TaskMgr* mgr = rio::TaskMgr::instance();
+
+    std::printf("%u tasks per frame, %u frames\n", task_num, frame_num);
+    std::printf("%-12s %9s %14s %14s %9s\n", "task", "reserved", "TaskMgr ns", "new/delete ns", "speedup");
+
+    run<SimpleTask>("SimpleTask", mgr, task_num, frame_num, false);
+    run<PayloadTask>("PayloadTask", mgr, task_num, frame_num, false);
+    run<SimpleTask>("SimpleTask", mgr, task_num, frame_num, true);
+    run<PayloadTask>("PayloadTask", mgr, task_num, frame_num, true);
+
+    rio::TaskMgr::destroySingleton();
+
+    // Each task is run once per frame in both cases, plus once for the warm-up
+    const u32 expected_num = 2 * 2 * (frame_num + 1) * task_num;
+    if (SimpleTask::sCalcNum != expected_num || PayloadTask::sCalcNum != expected_num)
+    {
+        std::printf("Unexpected number of calc_() calls.\n");
+        return 1;
+    }
+
+    return 0;
+}
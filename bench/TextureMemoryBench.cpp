@@ -0,0 +1,159 @@
+// Peak and final resident memory when loading textures, keeping their image data in memory
+// (as Texture2D does by default), and releasing it after the upload (keep_image_data = false).
+// Each mode is run in its own child process, so that each peak is measured from a clean process.
+// The memory of the GL driver is included, so with a software renderer (such as llvmpipe) the
+// textures themselves are counted in both modes: the difference is the CPU-side copies.
+// The textures are generated into fs/content/textures, so run it from a scratch directory.
+// (Linux only.)
+// Usage: TextureMemoryBench [texture_num] [texture_size]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/rio_Window.h>
+#include <gpu/rio_Texture.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+std::string getTextureName(u32 index)
+{
+    return "bench_texture" + std::to_string(index);
+}
+
+// Write RGBA8 textures without mipmaps
+void writeTextures(u32 texture_num, u32 texture_size)
+{
+    mkdir("fs", 0755);
+    mkdir("fs/content", 0755);
+    mkdir("fs/content/textures", 0755);
+
+    const u32 image_size = texture_size * texture_size * 4;
+
+    rio::NativeTexture2D header;
+    std::memset(&header, 0, sizeof(header));
+
+    rio::NativeSurface2D& surface = header.surface;
+    surface.width = texture_size;
+    surface.height = texture_size;
+    surface.mipLevels = 1;
+    surface.format = rio::TEXTURE_FORMAT_R8_G8_B8_A8_UNORM;
+    rio::TextureFormatUtil::getNativeTextureFormat(surface.nativeFormat, surface.format);
+    surface.imageSize = image_size;
+    surface._imageOffset = sizeof(rio::NativeTexture2D);
+
+    header.compMap = rio::TextureFormatUtil::getDefaultCompMap(surface.format);
+    header._footer.magic = 0x5101382D;
+    header._footer.version = 0x01000000;
+
+    std::vector<u8> data(sizeof(header) + image_size);
+    std::memcpy(&data[0], &header, sizeof(header));
+    for (u32 i = 0; i < image_size; i++)
+        data[sizeof(header) + i] = u8(i * 7);
+
+    for (u32 i = 0; i < texture_num; i++)
+    {
+        const std::string path = "fs/content/textures/" + getTextureName(i) + ".rtx";
+
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            std::printf("Failed to write %s.\n", path.c_str());
+            std::exit(1);
+        }
+
+        std::fwrite(data.data(), 1, data.size(), file);
+        std::fclose(file);
+    }
+}
+
+// Value of a field of /proc/self/status in KiB (0 if unknown)
+u64 getStatusKiB(const char* field)
+{
+    FILE* file = std::fopen("/proc/self/status", "r");
+    if (!file)
+        return 0;
+
+    const size_t field_len = std::strlen(field);
+    u64 value = 0;
+
+    char line[256];
+    while (std::fgets(line, sizeof(line), file))
+    {
+        if (std::strncmp(line, field, field_len) == 0 && line[field_len] == ':')
+        {
+            value = std::strtoull(line + field_len + 1, nullptr, 10);
+            break;
+        }
+    }
+
+    std::fclose(file);
+    return value;
+}
+
+int run(u32 texture_num, bool keep_image_data)
+{
+    rio::FileDeviceMgr::createSingleton();
+    if (!rio::Window::createSingleton(64, 64, false, true, 3, 3, true))
+    {
+        std::printf("Failed to create the window.\n");
+        return 1;
+    }
+
+    const u64 base_resident = getStatusKiB("VmRSS");
+
+    std::vector<rio::Texture2D*> textures(texture_num);
+    for (u32 i = 0; i < texture_num; i++)
+        textures[i] = new rio::Texture2D(getTextureName(i).c_str(), keep_image_data);
+
+    // Make sure the driver is done with the uploads
+    RIO_GL_CALL(glFinish());
+
+    std::printf("%-22s peak %8llu KiB, resident %8llu KiB (%+lld KiB while loaded)\n",
+                keep_image_data ? "Keep image data:" : "Release after upload:",
+                (unsigned long long)getStatusKiB("VmHWM"), (unsigned long long)getStatusKiB("VmRSS"),
+                (long long)(getStatusKiB("VmRSS") - base_resident));
+
+    for (u32 i = 0; i < texture_num; i++)
+        delete textures[i];
+
+    rio::Window::destroySingleton();
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 texture_num = argc > 1 ? std::atoi(argv[1]) : 64;
+    const u32 texture_size = argc > 2 ? std::atoi(argv[2]) : 1024;
+
+    writeTextures(texture_num, texture_size);
+
+    std::printf("%u textures of %ux%u RGBA8 (%u MiB)\n", texture_num, texture_size, texture_size,
+                u32((u64(texture_num) * texture_size * texture_size * 4) >> 20));
+    std::fflush(stdout);
+
+    for (bool keep_image_data : { true, false })
+    {
+        const pid_t pid = fork();
+        if (pid == 0)
+            std::exit(run(texture_num, keep_image_data));
+
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            std::printf("Run failed.\n");
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,229 @@
+// Frame times while textures are loaded in the middle of rendering, with the data uploaded right away
+// by the Texture2D constructor, and through TextureUploader (async_upload), which spreads it over the
+// next frames, with the files read by the constructor or streamed by the I/O threads of AsyncLoader
+// (async_load). Each frame delivers the loaded files as the main loop does, clears the window, and
+// ends with swapBuffers() (which runs the uploader) and glFinish(), so that the GPU side of the
+// uploads is counted in the frame it happens in.
+// The files are either mapped (keep_image_data = false, the image data is then released after the
+// upload) or read into memory (keep_image_data = true), and are dropped from the page cache before
+// each run, so that they are read from the disk again.
+// A texture is loaded every few frames; the mean, 99th percentile and worst frame times are reported,
+// along with the worst time spent loading (the constructor and the delivery of the streamed files:
+// file loading, texture creation and, without the uploader, the upload) and in swapBuffers() (the
+// uploader's work), and the page faults of the main thread (Linux only), which include the reads of
+// mapped files which are accessed before being read.
+// The textures are generated into fs/content/textures, so run it from a scratch directory.
+// Usage: TextureUploadBench [texture_num] [texture_size] [frames_per_texture]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/rio_Window.h>
+#include <gpu/rio_Texture.h>
+#include <gpu/win/rio_TextureUploaderWin.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+std::string getTextureName(u32 index)
+{
+    return "bench_texture" + std::to_string(index);
+}
+
+// Write RGBA8 textures without mipmaps
+void writeTextures(u32 texture_num, u32 texture_size)
+{
+    mkdir("fs", 0755);
+    mkdir("fs/content", 0755);
+    mkdir("fs/content/textures", 0755);
+
+    const u32 image_size = texture_size * texture_size * 4;
+
+    rio::NativeTexture2D header;
+    std::memset(&header, 0, sizeof(header));
+
+    rio::NativeSurface2D& surface = header.surface;
+    surface.width = texture_size;
+    surface.height = texture_size;
+    surface.mipLevels = 1;
+    surface.format = rio::TEXTURE_FORMAT_R8_G8_B8_A8_UNORM;
+    rio::TextureFormatUtil::getNativeTextureFormat(surface.nativeFormat, surface.format);
+    surface.imageSize = image_size;
+    surface._imageOffset = sizeof(rio::NativeTexture2D);
+
+    header.compMap = rio::TextureFormatUtil::getDefaultCompMap(surface.format);
+    header._footer.magic = 0x5101382D;
+    header._footer.version = 0x01000000;
+
+    std::vector<u8> data(sizeof(header) + image_size);
+    std::memcpy(&data[0], &header, sizeof(header));
+    for (u32 i = 0; i < image_size; i++)
+        data[sizeof(header) + i] = u8(i * 7);
+
+    for (u32 i = 0; i < texture_num; i++)
+    {
+        const std::string path = "fs/content/textures/" + getTextureName(i) + ".rtx";
+
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            std::printf("Failed to write %s.\n", path.c_str());
+            std::exit(1);
+        }
+
+        std::fwrite(data.data(), 1, data.size(), file);
+        std::fclose(file);
+    }
+}
+
+// Drop the texture files from the page cache
+void evictTextures(u32 texture_num)
+{
+    for (u32 i = 0; i < texture_num; i++)
+    {
+        const std::string path = "fs/content/textures/" + getTextureName(i) + ".rtx";
+
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            continue;
+
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+// Page faults of the calling thread so far (0 if unknown)
+u64 getThreadFaultNum()
+{
+#ifdef RUSAGE_THREAD
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0)
+        return usage.ru_minflt + usage.ru_majflt;
+#endif // RUSAGE_THREAD
+    return 0;
+}
+
+f64 getMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<f64, std::milli>(end - start).count();
+}
+
+void run(const char* name, u32 texture_num, u32 frames_per_texture, bool async_upload, bool async_load, bool map)
+{
+    rio::Window* window = rio::Window::instance();
+
+    evictTextures(texture_num);
+    const u64 fault_num = getThreadFaultNum();
+
+    std::vector<rio::Texture2D*> textures;
+    std::vector<f64> frame_ms;
+    f64 max_load_ms = 0.0;
+    f64 max_swap_ms = 0.0;
+
+    const u32 frame_num = texture_num * frames_per_texture;
+    u32 frame = 0;
+
+    // Keep rendering until all textures are loaded and uploaded
+    while (frame < frame_num || rio::FileDeviceMgr::instance()->getAsyncLoader().getPendingNum() != 0 ||
+           (rio::TextureUploader::instance() && rio::TextureUploader::instance()->getPendingNum() != 0))
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        rio::FileDeviceMgr::instance()->deliverAsync();
+
+        const auto clear_start = std::chrono::steady_clock::now();
+        window->clearColor(0.2f, 0.3f, 0.4f);
+
+        const auto ctor_start = std::chrono::steady_clock::now();
+        if (frame < frame_num && frame % frames_per_texture == 0)
+            textures.push_back(new rio::Texture2D(getTextureName(frame / frames_per_texture).c_str(), !map, async_upload, async_load));
+
+        const auto swap_start = std::chrono::steady_clock::now();
+        window->swapBuffers();
+        RIO_GL_CALL(glFinish());
+
+        const auto end = std::chrono::steady_clock::now();
+        max_load_ms = std::max(max_load_ms, getMs(start, clear_start) + getMs(ctor_start, swap_start));
+        max_swap_ms = std::max(max_swap_ms, getMs(swap_start, end));
+        frame_ms.push_back(getMs(start, end));
+        frame++;
+    }
+
+    const u64 frame_fault_num = getThreadFaultNum() - fault_num;
+
+    u32 failed_num = 0;
+    for (rio::Texture2D* texture : textures)
+    {
+        if (texture->isLoadFailed())
+            failed_num++;
+        else
+            RIO_ASSERT(texture->isReady());
+
+        delete texture;
+    }
+
+    f64 total_ms = 0.0;
+    for (f64 ms : frame_ms)
+        total_ms += ms;
+
+    std::sort(frame_ms.begin(), frame_ms.end());
+
+    std::printf("%-37s %5u frames, mean %7.3f ms, p99 %7.3f ms, worst %7.3f ms (load %7.3f ms, swap %7.3f ms), %7llu faults\n", name, u32(frame_ms.size()),
+                total_ms / frame_ms.size(), frame_ms[frame_ms.size() * 99 / 100], frame_ms.back(), max_load_ms, max_swap_ms, (unsigned long long)frame_fault_num);
+    if (failed_num != 0)
+        std::printf("%u textures failed to load.\n", failed_num);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 texture_num = argc > 1 ? std::atoi(argv[1]) : 16;
+    const u32 texture_size = argc > 2 ? std::atoi(argv[2]) : 2048;
+    u32 frames_per_texture = argc > 3 ? std::atoi(argv[3]) : 30;
+    if (frames_per_texture == 0)
+        frames_per_texture = 1;
+
+    writeTextures(texture_num, texture_size);
+
+    rio::FileDeviceMgr::createSingleton();
+    if (!rio::Window::createSingleton(1280, 720, false, true, 3, 3, true))
+    {
+        std::printf("Failed to create the window.\n");
+        return 1;
+    }
+
+    std::printf("%u textures of %ux%u RGBA8, one every %u frames\n", texture_num, texture_size, texture_size, frames_per_texture);
+
+    // Warm up (page cache, driver)
+    run("Warm up:", 2, 1, false, false, true);
+
+    run("Immediate (mapped):", texture_num, frames_per_texture, false, false, true);
+    run("AsyncLoader (read):", texture_num, frames_per_texture, false, true, false);
+    run("AsyncLoader (mapped):", texture_num, frames_per_texture, false, true, true);
+
+    if (rio::TextureUploader::isSupported() && rio::TextureUploader::createSingleton())
+    {
+        run("TextureUploader (mapped):", texture_num, frames_per_texture, true, false, true);
+        run("AsyncLoader+TextureUploader (read):", texture_num, frames_per_texture, true, true, false);
+        run("AsyncLoader+TextureUploader (mapped):", texture_num, frames_per_texture, true, true, true);
+        rio::TextureUploader::destroySingleton();
+    }
+    else
+    {
+        std::printf("TextureUploader is not supported.\n");
+    }
+
+    rio::Window::destroySingleton();
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
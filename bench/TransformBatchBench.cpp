@@ -0,0 +1,83 @@
+// Time per matrix of computing the world matrices of the meshes of a model (model matrix * local
+// matrices), as Model::setModelWorldMtx() does, with the local and world matrices stored:
+// - as arrays of Matrix34f (TransformBatch::mul() on arrays, one Matrix34f::setMul() per matrix),
+// - as Mtx34SoA batches, converted back to an array of Matrix34f (Mesh::worldMtx() returns a Matrix34f),
+// - as Mtx34SoA batches only (the cost of the kernel itself).
+// Only the math sources are needed, e.g.:
+//   g++ -std=gnu++17 -O2 -DRIO_RELEASE -Iinclude bench/TransformBatchBench.cpp src/math/impl/*.cpp
+// Usage: TransformBatchBench [matrix_num_per_size]
+
+#include <math/rio_TransformBatch.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+f64 getNsPerMatrix(std::chrono::steady_clock::time_point start, u32 iteration_num, u32 num)
+{
+    return std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count() / (f64(iteration_num) * num);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 matrix_num = argc > 1 ? std::atoi(argv[1]) : 4000000;
+
+    std::printf("%6s %12s %16s %12s (ns per matrix)\n", "meshes", "array", "batch + array", "batch");
+
+    for (u32 num : { 1u, 4u, 16u, 64u, 256u })
+    {
+        const u32 iteration_num = matrix_num / num;
+
+        std::vector<rio::Matrix34f> local_mtx(num);
+        std::vector<rio::Matrix34f> world_mtx(num);
+        for (u32 i = 0; i < num; i++)
+            local_mtx[i].makeSRT({ 1.0f, 1.0f, 1.0f }, { 0.1f * i, 0.2f, 0.3f }, { f32(i), 0.0f, -f32(i) });
+
+        std::vector<f32> local_buffer(num * 12);
+        std::vector<f32> world_buffer(num * 12);
+        const rio::Mtx34SoAf local_soa = rio::Mtx34SoAf::fromBuffer(local_buffer.data(), num);
+        const rio::Mtx34SoAf world_soa = rio::Mtx34SoAf::fromBuffer(world_buffer.data(), num);
+        rio::TransformBatchf::toSoA(local_soa, local_mtx.data(), num);
+
+        rio::Matrix34f model_mtx;
+        model_mtx.makeSRT({ 2.0f, 2.0f, 2.0f }, { 0.5f, 0.25f, 0.0f }, { 0.0f, 0.0f, 0.0f });
+
+        auto start = std::chrono::steady_clock::now();
+        for (u32 n = 0; n < iteration_num; n++)
+        {
+            model_mtx.m[0][3] = f32(n);
+            rio::TransformBatchf::mul(world_mtx.data(), model_mtx, local_mtx.data(), num);
+        }
+        const f64 array_ns = getNsPerMatrix(start, iteration_num, num);
+
+        start = std::chrono::steady_clock::now();
+        for (u32 n = 0; n < iteration_num; n++)
+        {
+            model_mtx.m[0][3] = f32(n);
+            rio::TransformBatchf::mul(world_soa, model_mtx, local_soa, num);
+            rio::TransformBatchf::fromSoA(world_mtx.data(), world_soa, num);
+        }
+        const f64 batch_array_ns = getNsPerMatrix(start, iteration_num, num);
+
+        start = std::chrono::steady_clock::now();
+        for (u32 n = 0; n < iteration_num; n++)
+        {
+            model_mtx.m[0][3] = f32(n);
+            rio::TransformBatchf::mul(world_soa, model_mtx, local_soa, num);
+        }
+        const f64 batch_ns = getNsPerMatrix(start, iteration_num, num);
+
+        // Keep the results alive
+        volatile f32 sink = world_mtx[num - 1].m[0][3] + world_buffer[num * 12 - 1];
+        (void)sink;
+
+        std::printf("%6u %12.2f %16.2f %12.2f\n", num, array_ns, batch_array_ns, batch_ns);
+    }
+
+    return 0;
+}
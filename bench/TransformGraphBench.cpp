@@ -0,0 +1,111 @@
+// Time per frame of TransformGraph::update() on a scene of small trees of nodes, when a given
+// ratio of the nodes moves each frame, compared with recomputing the whole graph every frame
+// (all roots marked dirty, as without dirty-subtree tracking).
+// Usage: TransformGraphBench [tree_num] [frame_num]
+
+#include <gfx/mdl/rio_TransformGraph.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Each tree has a root, 3 children, and 2 children under each child
+static const u32 cTreeNodeNum = 1 + 3 + 3 * 2;
+
+void buildScene(rio::mdl::TransformGraph* graph, u32 tree_num, std::vector<rio::mdl::TransformGraph::NodeID>* nodes,
+                std::vector<rio::mdl::TransformGraph::NodeID>* roots)
+{
+    graph->reserve(tree_num * cTreeNodeNum);
+
+    for (u32 i = 0; i < tree_num; i++)
+    {
+        const rio::mdl::TransformGraph::NodeID root = graph->createNode();
+        graph->setTranslation(root, { f32(i % 100), 0.0f, f32(i / 100) });
+        roots->push_back(root);
+        nodes->push_back(root);
+
+        for (u32 j = 0; j < 3; j++)
+        {
+            const rio::mdl::TransformGraph::NodeID child = graph->createNode(root);
+            graph->setSRT(child, { 0.5f, 0.5f, 0.5f }, { 0.0f, 0.5f * j, 0.0f }, { 1.0f, 0.0f, 0.0f });
+            nodes->push_back(child);
+
+            for (u32 k = 0; k < 2; k++)
+            {
+                const rio::mdl::TransformGraph::NodeID leaf = graph->createNode(child);
+                graph->setTranslation(leaf, { 0.0f, 1.0f + k, 0.0f });
+                nodes->push_back(leaf);
+            }
+        }
+    }
+
+    graph->update();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 tree_num = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const u32 frame_num = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (tree_num == 0 || frame_num == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    rio::mdl::TransformGraph graph;
+    std::vector<rio::mdl::TransformGraph::NodeID> nodes;
+    std::vector<rio::mdl::TransformGraph::NodeID> roots;
+    buildScene(&graph, tree_num, &nodes, &roots);
+
+    std::printf("%u nodes in %u trees, %u frames\n", graph.getNodeNum(), tree_num, frame_num);
+    std::printf("%7s %14s %12s %12s %8s\n", "moved", "recomputed", "dirty ms", "full ms", "speedup");
+
+    std::mt19937 rng(1);
+
+    for (u32 percent : { 0u, 1u, 10u, 50u, 100u })
+    {
+        const u32 moved_num = u32(u64(nodes.size()) * percent / 100);
+
+        f64 ms[2] = { 0.0, 0.0 };
+        u64 updated_num = 0;
+
+        for (u32 full = 0; full < 2; full++)
+        {
+            for (u32 frame = 0; frame < frame_num; frame++)
+            {
+                // Pick the moved nodes outside of the measured time
+                std::vector<rio::mdl::TransformGraph::NodeID> moved(moved_num);
+                for (u32 i = 0; i < moved_num; i++)
+                    moved[i] = nodes[rng() % nodes.size()];
+
+                const auto start = std::chrono::steady_clock::now();
+
+                for (rio::mdl::TransformGraph::NodeID node : moved)
+                    graph.setRotation(node, { 0.0f, 0.001f * frame, 0.0f });
+
+                if (full)
+                    for (rio::mdl::TransformGraph::NodeID root : roots)
+                        graph.markDirty(root);
+
+                graph.update();
+
+                ms[full] += std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (!full)
+                    updated_num += graph.getUpdatedNum();
+            }
+        }
+
+        std::printf("%6u%% %14u %12.3f %12.3f", percent, u32(updated_num / frame_num), ms[0] / frame_num, ms[1] / frame_num);
+        if (updated_num != 0)
+            std::printf(" %7.1fx", ms[1] / ms[0]);
+        std::printf("\n");
+    }
+
+    return 0;
+}
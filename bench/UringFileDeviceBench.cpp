@@ -0,0 +1,220 @@
+// Throughput of loading a directory of many small files, one file at a time through StdIOFileDevice
+// (the native file device) and UringFileDevice (read with pread()), and all at once through
+// UringFileDevice::tryLoadBatch() (read through an io_uring on Linux, by groups of up to
+// UringFileDevice::cBatchMaxNum files).
+// Each load is timed with the files dropped from the page cache first (cold, read from the disk),
+// and with them in the page cache (warm, where only the system calls and copies are left), and the
+// data loaded is checked against the data written.
+// The files are generated into fs/content/uring_bench, so run it from a scratch directory.
+// Usage: UringFileDeviceBench [file_num] [file_size]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <filedevice/rio_NativeFileDevice.h>
+#include <filedevice/rio_UringFileDevice.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+static const char* const cDirPath = "fs/content/uring_bench";
+
+u8 getFileByte(u32 file_index, u32 offset)
+{
+    return u8(file_index * 31 + offset * 7);
+}
+
+// Names of the files of the directory, sorted
+std::vector<std::string> listFiles()
+{
+    std::vector<std::string> names;
+
+    DIR* dir = opendir(cDirPath);
+    if (!dir)
+        return names;
+
+    while (const dirent* entry = readdir(dir))
+        if (entry->d_name[0] != '.')
+            names.push_back(entry->d_name);
+
+    closedir(dir);
+
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+// Write the files, each with its own contents, into the emptied directory
+void writeFiles(u32 file_num, u32 file_size)
+{
+    mkdir("fs", 0755);
+    mkdir("fs/content", 0755);
+    mkdir(cDirPath, 0755);
+
+    for (const std::string& name : listFiles())
+        unlink((std::string(cDirPath) + '/' + name).c_str());
+
+    std::vector<u8> data(file_size);
+    for (u32 i = 0; i < file_num; i++)
+    {
+        for (u32 j = 0; j < file_size; j++)
+            data[j] = getFileByte(i, j);
+
+        const std::string path = std::string(cDirPath) + "/file" + std::to_string(i) + ".bin";
+
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            std::printf("Failed to write %s.\n", path.c_str());
+            std::exit(1);
+        }
+
+        std::fwrite(data.data(), 1, data.size(), file);
+        std::fclose(file);
+    }
+
+    // Dirty pages can not be dropped from the page cache, so write the files to the disk now
+    sync();
+}
+
+// Drop the files from the page cache
+void evictFiles(const std::vector<std::string>& names)
+{
+    for (const std::string& name : names)
+    {
+        const std::string path = std::string(cDirPath) + '/' + name;
+
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            continue;
+
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+// Check the data of a file against the data written (its index is in its name)
+bool checkFile(const std::string& name, const u8* data, u32 size, u32 file_size)
+{
+    if (!data || size != file_size)
+        return false;
+
+    const u32 file_index = std::atoi(name.c_str() + 4);
+    for (u32 i = 0; i < size; i++)
+        if (data[i] != getFileByte(file_index, i))
+            return false;
+
+    return true;
+}
+
+f64 getMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<f64, std::milli>(end - start).count();
+}
+
+// Load all files, with a single batch or one by one, and free them
+// Returns the time taken by the loads, and sets the number of files loaded correctly
+f64 loadFiles(rio::FileDevice* device, const std::string& dir_path, const std::vector<std::string>& names, u32 file_size, bool batch, u32* ok_num)
+{
+    const u32 file_num = names.size();
+
+    std::vector<rio::FileDevice::LoadArg> args(file_num);
+    for (u32 i = 0; i < file_num; i++)
+        args[i].path = dir_path + names[i];
+
+    std::vector<u8*> data(file_num, nullptr);
+
+    const auto start = std::chrono::steady_clock::now();
+    if (batch)
+    {
+        device->tryLoadBatch(args.data(), data.data(), file_num);
+    }
+    else
+    {
+        for (u32 i = 0; i < file_num; i++)
+            data[i] = device->tryLoad(args[i]);
+    }
+    const f64 ms = getMs(start, std::chrono::steady_clock::now());
+
+    *ok_num = 0;
+    for (u32 i = 0; i < file_num; i++)
+    {
+        if (checkFile(names[i], data[i], args[i].read_size, file_size))
+            (*ok_num)++;
+
+        if (data[i] && args[i].need_unload)
+            rio::FileDevice::unload(data[i]);
+    }
+
+    return ms;
+}
+
+void run(const char* name, rio::FileDevice* device, const std::string& dir_path, const std::vector<std::string>& names, u32 file_size, bool batch)
+{
+    const u32 file_num = names.size();
+    const f64 total_mb = f64(file_num) * file_size / (1024.0 * 1024.0);
+
+    for (bool cold : { true, false })
+    {
+        if (cold)
+            evictFiles(names);
+
+        u32 ok_num = 0;
+        const f64 ms = loadFiles(device, dir_path, names, file_size, batch, &ok_num);
+
+        std::printf("%-30s %s %9.2f ms, %8.1f MB/s, %9.0f files/s", name, cold ? "cold:" : "warm:", ms, total_mb / (ms / 1000.0), file_num / (ms / 1000.0));
+        if (ok_num != file_num)
+            std::printf(", %u files NOT loaded correctly", file_num - ok_num);
+        std::printf("\n");
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 file_num = argc > 1 ? std::atoi(argv[1]) : 4096;
+    const u32 file_size = argc > 2 ? std::atoi(argv[2]) : 16 * 1024;
+    if (file_num == 0 || file_size == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+    writeFiles(file_num, file_size);
+
+    const std::vector<std::string> names = listFiles();
+    if (names.size() != file_num)
+    {
+        std::printf("Failed to list %s.\n", cDirPath);
+        return 1;
+    }
+
+    rio::FileDeviceMgr::createSingleton();
+
+    rio::FileDevice* stdio_device = rio::FileDeviceMgr::instance()->getNativeFileDevice();
+    rio::UringFileDevice* uring_device = new rio::UringFileDevice("uring_bench", cDirPath);
+
+    std::printf("%u files of %u bytes, io_uring %s\n", file_num, file_size, uring_device->isRingAvailable() ? "available" : "NOT available");
+
+    // Warm up
+    {
+        u32 ok_num = 0;
+        loadFiles(stdio_device, std::string(cDirPath) + '/', names, file_size, false, &ok_num);
+    }
+
+    run("StdIOFileDevice", stdio_device, std::string(cDirPath) + '/', names, file_size, false);
+    run("UringFileDevice", uring_device, "", names, file_size, false);
+    run("UringFileDevice (batch)", uring_device, "", names, file_size, true);
+
+    delete uring_device;
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Time taken by Window::createSingleton() (context creation, GL loading and frame buffer setup)
+// and Window::destroySingleton(), with the backend this is built with: EGL with RIO_USE_EGL,
+// GLFW otherwise. Build it both ways to compare them. The first creation, which also loads the
+// driver, is reported apart from the following ones.
+// Usage: WindowStartupBench [run_num] [width] [height]
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gfx/rio_Window.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+f64 getMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<f64, std::milli>(end - start).count();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const u32 run_num = argc > 1 ? std::atoi(argv[1]) : 10;
+    const u32 width = argc > 2 ? std::atoi(argv[2]) : 1280;
+    const u32 height = argc > 3 ? std::atoi(argv[3]) : 720;
+    if (run_num == 0 || width == 0 || height == 0)
+    {
+        std::printf("Invalid arguments.\n");
+        return 1;
+    }
+
+#ifdef RIO_USE_EGL
+    static const char* const cBackend = "EGL";
+#else
+    static const char* const cBackend = "GLFW";
+#endif // RIO_USE_EGL
+
+    rio::FileDeviceMgr::createSingleton();
+
+    std::printf("%s backend, %ux%u, %u runs\n", cBackend, width, height, run_num);
+
+    f64 first_ms = 0.0;
+    f64 create_ms = 0.0;
+    f64 min_create_ms = 0.0;
+    f64 destroy_ms = 0.0;
+
+    for (u32 i = 0; i < run_num; i++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (!rio::Window::createSingleton(width, height, false, true, 3, 3, true))
+        {
+            std::printf("Failed to create the window.\n");
+            return 1;
+        }
+
+        // Make sure the context is usable
+        rio::Window::instance()->clearColor(0.0f, 0.0f, 0.0f);
+        RIO_GL_CALL(glFinish());
+
+        const auto created = std::chrono::steady_clock::now();
+        rio::Window::destroySingleton();
+        const auto end = std::chrono::steady_clock::now();
+
+        const f64 ms = getMs(start, created);
+        destroy_ms += getMs(created, end);
+
+        if (i == 0)
+        {
+            first_ms = ms;
+        }
+        else
+        {
+            create_ms += ms;
+            min_create_ms = i == 1 ? ms : std::min(min_create_ms, ms);
+        }
+    }
+
+    std::printf("First creation:  %8.3f ms\n", first_ms);
+    if (run_num > 1)
+        std::printf("Next creations:  %8.3f ms mean, %8.3f ms best\n", create_ms / (run_num - 1), min_create_ms);
+    std::printf("Destruction:     %8.3f ms mean\n", destroy_ms / run_num);
+
+    rio::FileDeviceMgr::destroySingleton();
+    return 0;
+}
@@ -0,0 +1,141 @@
+#ifndef RIO_FILE_ASYNC_LOADER_H
+#define RIO_FILE_ASYNC_LOADER_H
+
+#include <filedevice/rio_FileDevice.h>
+
+#include <deque>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#if RIO_IS_WIN
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif // RIO_IS_WIN
+
+namespace rio {
+
+// Loads files through FileDeviceMgr::tryLoad() on I/O threads, and delivers them to callbacks on the
+// main thread, so that their data can be used right away (e.g. uploaded to the GPU).
+// Queued requests are loaded by decreasing priority, then in the order they were queued.
+// Notes:
+// - All functions must be called from the main thread.
+// - File devices must not be mounted or unmounted while requests are pending.
+// - Without I/O threads (and on platforms without them), the queued files are loaded by deliver().
+class AsyncLoader
+{
+public:
+    typedef u32 Handle;
+    static constexpr Handle cInvalidHandle = 0;
+
+    static constexpr u32 cDefaultThreadNum = 2;
+
+    // Called by deliver() once a file is loaded (data is nullptr on failure), with the output
+    // members of arg set as by FileDeviceMgr::tryLoad(). The callback takes ownership of the data,
+    // which must be released with FileDeviceMgr::unmap() if arg.is_mapped, or unload() if arg.need_unload.
+    typedef void (*Callback)(Handle handle, const FileDevice::LoadArg& arg, u8* data, void* user_data);
+
+    enum Status
+    {
+        STATUS_NONE,        // Unknown handle, canceled or delivered
+        STATUS_QUEUED,
+        STATUS_LOADING,
+        STATUS_LOADED       // Waiting to be delivered
+    };
+
+public:
+    AsyncLoader();
+    ~AsyncLoader();
+
+    // Start the I/O threads
+    void initialize(u32 thread_num = cDefaultThreadNum);
+    // Wait for the I/O threads to end, dropping the pending requests
+    void terminate();
+
+    u32 getThreadNum() const;
+
+    // Queue the loading of a file (arg.path is the full path, with the drive name if any)
+    Handle load(const FileDevice::LoadArg& arg, Callback callback, void* user_data, s32 priority = 0);
+
+    // Cancel a request: its callback is not called, and the file is released if it is loaded
+    // (once it is done loading if it is being loaded). Returns false if the request is not pending.
+    bool cancel(Handle handle);
+
+    // Load and deliver a request now, blocking until it is done
+    void wait(Handle handle);
+
+    // Call the callbacks of the loaded requests, in the order they were loaded
+    void deliver();
+
+    // Load and deliver all pending requests, blocking until they are done
+    // (The requests queued by the callbacks are not delivered.)
+    void flush();
+
+    Status getStatus(Handle handle) const;
+
+    // Number of requests queued, being loaded or waiting to be delivered
+    u32 getPendingNum() const;
+
+private:
+    AsyncLoader(const AsyncLoader&);
+    AsyncLoader& operator=(const AsyncLoader&);
+
+    struct Request
+    {
+        FileDevice::LoadArg arg;
+        Callback            callback;
+        void*               user_data;
+        Status              status;
+        bool                canceled;   // Canceled while being loaded
+        u8*                 data;
+    };
+
+    struct QueueEntry
+    {
+        s32     priority;
+        Handle  handle;
+
+        bool operator<(const QueueEntry& rhs) const
+        {
+            // Highest priority first, then lowest handle
+            if (priority != rhs.priority)
+                return priority < rhs.priority;
+
+            return handle > rhs.handle;
+        }
+    };
+
+    // Pop the next queued request, and mark it as being loaded (returns false if there is none)
+    bool pop_(Handle* handle, FileDevice::LoadArg* arg);
+    // Store the result of a request which was being loaded
+    void setLoaded_(Handle handle, const FileDevice::LoadArg& arg, u8* data);
+    // Load the queued requests on the calling thread
+    void loadQueued_();
+    // Remove a loaded request and call its callback
+    void deliver_(Handle handle);
+
+    static u8* loadFile_(FileDevice::LoadArg& arg);
+    static void releaseFile_(const FileDevice::LoadArg& arg, u8* data);
+
+#if RIO_IS_WIN
+    void threadMain_();
+#endif // RIO_IS_WIN
+
+private:
+    std::unordered_map<Handle, Request> mRequest;
+    std::priority_queue<QueueEntry>     mQueue;     // (May hold canceled requests, which are skipped)
+    std::deque<Handle>                  mLoaded;    // Loaded requests waiting to be delivered
+    Handle                              mNextHandle;
+#if RIO_IS_WIN
+    mutable std::mutex                  mMutex;
+    std::condition_variable             mQueueCondition;    // Requests were queued, or the threads must exit
+    std::condition_variable             mLoadedCondition;   // A request is done loading
+    std::vector<std::thread>            mThread;
+    bool                                mExit;
+#endif // RIO_IS_WIN
+};
+
+}
+
+#endif // RIO_FILE_ASYNC_LOADER_H
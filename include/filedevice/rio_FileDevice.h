@@ -59,9 +59,12 @@ public:
             , buffer(nullptr)
             , buffer_size(0)
             , alignment(cBufferMinAlignment)
+            , map(false)
+            , heap_type(MemUtil::HEAP_TYPE_FILE)
             , read_size(0)
             , roundup_size(0)
             , need_unload(false)
+            , is_mapped(false)
         {
         }
 
@@ -70,11 +73,15 @@ public:
         u8*         buffer;
         u32         buffer_size;
         u32         alignment;
+        bool        map;            // Map the file read-only instead of reading it, if the device supports it
+                                    // (buffer must be null, falls back to reading the file otherwise)
+        MemUtil::HeapType heap_type;    // Heap to allocate the buffer from, if buffer is null
 
         // Out
         u32         read_size;
         u32         roundup_size;
         bool        need_unload;
+        bool        is_mapped;      // The file was mapped, and must be released with unmap() instead of unload()
     };
 
 public:
@@ -113,6 +120,17 @@ public:
         MemUtil::free(data);
     }
 
+    // Release a file mapped by tryLoad() (size is LoadArg::read_size)
+    static void unmap(u8* data, u32 size);
+
+    // Let the system drop the pages of a range of a mapped file from memory
+    // (they are read again from the file if accessed afterwards)
+    static void discardMappedPages(const u8* data, u32 size);
+
+    // Read the pages of a range of a mapped file into memory now, on the calling thread
+    // (so that the thread using the data later does not wait for the reads, as page faults)
+    static void prefaultMappedPages(const u8* data, u32 size);
+
     FileDevice* open(FileHandle* handle, const std::string& filename, FileOpenFlag flag)
     {
         FileDevice* device = tryOpen(handle, filename, flag);
@@ -191,6 +209,9 @@ public:
     RawErrorCode getLastRawError() const;
 
     u8* tryLoad(LoadArg& arg);
+    // Load several files at once, as tryLoad() does for each of them
+    // data[i] is set to the data of args[i], or nullptr on failure. Returns the number of files loaded.
+    u32 tryLoadBatch(LoadArg* args, u8** data, u32 num);
     FileDevice* tryOpen(FileHandle* handle, const std::string& filename, FileOpenFlag flag);
     bool tryClose(FileHandle* handle);
     bool tryRead(u32* read_size, FileHandle* handle, u8* buf, u32 size);
@@ -203,6 +224,7 @@ public:
 
 protected:
     virtual u8* doLoad_(LoadArg& arg);
+    virtual u32 doLoadBatch_(LoadArg* args, u8** data, u32 num);
     virtual FileDevice* doOpen_(FileHandle* handle, const std::string& filename, FileOpenFlag flag) = 0;
     virtual bool doClose_(FileHandle* handle) = 0;
     virtual bool doRead_(u32* read_size, FileHandle* handle, u8* buf, u32 size) = 0;
@@ -1,6 +1,7 @@
 #ifndef RIO_FILE_DEVICE_MANAGER_H
 #define RIO_FILE_DEVICE_MANAGER_H
 
+#include <filedevice/rio_AsyncLoader.h>
 #include <filedevice/rio_MainFileDevice.h>
 #include <filedevice/rio_NativeFileDevice.h>
 
@@ -16,7 +17,10 @@ private:
     typedef TList<FileDevice*> DeviceList;
 
 public:
-    static bool createSingleton();
+    // Create file device manager singleton instance
+    // Parameters:
+    // - io_thread_num: Number of I/O threads of the asynchronous loader (see AsyncLoader)
+    static bool createSingleton(u32 io_thread_num = AsyncLoader::cDefaultThreadNum);
     static void destroySingleton();
     static FileDeviceMgr* instance() { return sInstance; }
 
@@ -48,6 +52,11 @@ public:
         FileDevice::unload(data);
     }
 
+    static void unmap(u8* data, u32 size)
+    {
+        FileDevice::unmap(data, size);
+    }
+
     FileDevice* open(FileHandle* handle, const std::string& filename, FileDevice::FileOpenFlag flag)
     {
         FileDevice* device = tryOpen(handle, filename, flag);
@@ -60,6 +69,27 @@ public:
     }
 
     u8* tryLoad(FileDevice::LoadArg& arg);
+
+    // Queue the loading of a file on the I/O threads, see AsyncLoader::load()
+    // Loaded files are delivered to their callbacks by deliverAsync(), which is called every frame by the main loop.
+    AsyncLoader::Handle loadAsync(const FileDevice::LoadArg& arg, AsyncLoader::Callback callback, void* user_data, s32 priority = 0)
+    {
+        return mAsyncLoader.load(arg, callback, user_data, priority);
+    }
+
+    bool cancelAsync(AsyncLoader::Handle handle)
+    {
+        return mAsyncLoader.cancel(handle);
+    }
+
+    void deliverAsync()
+    {
+        mAsyncLoader.deliver();
+    }
+
+    AsyncLoader& getAsyncLoader() { return mAsyncLoader; }
+    const AsyncLoader& getAsyncLoader() const { return mAsyncLoader; }
+
     FileDevice* tryOpen(FileHandle* handle, const std::string& filename, FileDevice::FileOpenFlag flag);
 
     void mount(FileDevice* device, const std::string& drive_name = "");
@@ -100,6 +130,7 @@ public:
 
 private:
     DeviceList          mDeviceList;
+    AsyncLoader         mAsyncLoader;
     FileDevice*         mDefaultFileDevice;
     MainFileDevice*     mMainFileDevice;
     NativeFileDevice*   mNativeFileDevice;
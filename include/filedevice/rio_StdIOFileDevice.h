@@ -16,6 +16,7 @@ public:
 protected:
     StdIOFileDevice(const std::string& drive_name, const std::string& cwd);
 
+    virtual u8* doLoad_(LoadArg& arg);
     virtual FileDevice* doOpen_(FileHandle* handle, const std::string& filename, FileOpenFlag flag);
     virtual bool doClose_(FileHandle* handle);
     virtual bool doRead_(u32* read_size, FileHandle* handle, u8* buf, u32 size);
@@ -27,9 +28,19 @@ protected:
     virtual bool doIsExistFile_(bool* is_exist, const std::string& path);
     virtual RawErrorCode doGetLastRawError_() const;
 
+#if RIO_IS_WIN
+    // Map the file read-only (returns nullptr on failure)
+    u8* doMap_(LoadArg& arg);
+#endif // RIO_IS_WIN
+
+    // Per device and per thread, like errno, as the AsyncLoader threads use the device concurrently
+    // with the main thread: getLastRawError() returns the result of the last operation of the
+    // calling thread on this device
+    void setLastRawError_(RawErrorCode error);
+
 protected:
     std::string     mCWD;
-    RawErrorCode    mLastRawError;
+    const u32       mID;    // Unique ID, keying the results of this device in the per thread results
 };
 
 }
@@ -0,0 +1,72 @@
+#ifndef RIO_FILE_URING_DEVICE_H
+#define RIO_FILE_URING_DEVICE_H
+
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+
+#include <filedevice/rio_StdIOFileDevice.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace rio {
+
+// File device loading files with few system calls, for preloading many files at once with tryLoadBatch().
+// On Linux, the files of a batch are opened, read and closed through an io_uring, by groups of up to
+// cBatchMaxNum files, each step of a group being a single system call.
+// Otherwise (single files, older kernels, while the ring is used by another thread, or once the ring
+// has failed), files are read with pread(), and on Windows, as by StdIOFileDevice.
+// Files are read straight into their buffers. Files opened with a FileHandle always go through stdio.
+class UringFileDevice : public StdIOFileDevice
+{
+public:
+    static constexpr u32 cBatchMaxNum = 64;
+
+public:
+    // Relative paths are resolved from root_path
+    UringFileDevice(const std::string& drive_name, const std::string& root_path);
+    virtual ~UringFileDevice();
+
+    virtual std::string getNativePath(const std::string& path) const
+    {
+        if (mCWD.empty() || (!path.empty() && path[0] == '/'))
+            return path;
+
+        return mCWD + '/' + path;
+    }
+
+    // Whether files are loaded through an io_uring
+    bool isRingAvailable() const
+    {
+        return mRing != nullptr;
+    }
+
+protected:
+    virtual u8* doLoad_(LoadArg& arg);
+    virtual u32 doLoadBatch_(LoadArg* args, u8** data, u32 num);
+
+private:
+    struct Ring;
+
+    // Load up to cBatchMaxNum files through the ring
+    u32 loadRing_(LoadArg* args, u8** data, u32 num);
+    // Delete the ring after a failure of io_uring_enter(), the files being read with pread() from then on
+    void dropRing_();
+    // Load a file with pread()
+    u8* loadPread_(LoadArg& arg);
+
+    // Check the file size, and get the buffer to read the file into (returns nullptr on failure)
+    u8* allocBuffer_(LoadArg& arg, u64 file_size);
+    void setLastRawErrorFromErrno_(int error);
+
+private:
+    std::atomic<Ring*>  mRing;      // (nullptr if io_uring is not available)
+    std::mutex          mRingMutex;
+};
+
+}
+
+#endif // RIO_IS_WIN
+
+#endif // RIO_FILE_URING_DEVICE_H
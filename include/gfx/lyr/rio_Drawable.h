@@ -27,22 +27,32 @@ class Renderer;
 class DrawMethod
 {
     // Class for holding a draw method function pointer for use with the Renderer.
+    // Draw methods of a render step are drawn in order of their sort key, which is made of
+    // their priority and a user-defined key (e.g. shader, material and depth bits) used to
+    // order draw methods of the same priority. Equal keys are drawn in insertion order.
 
 public:
-    DrawMethod(IDrawable* obj_ptr, IDrawable::DrawMethod func_ptr, s32 priority = 0);
+    DrawMethod(IDrawable* obj_ptr, IDrawable::DrawMethod func_ptr, s32 priority = 0, u32 user_key = 0);
 
     template <typename T>
-    DrawMethod(T* obj_ptr, void (T::*func_ptr)(const DrawInfo&), s32 priority = 0)
-        : DrawMethod(static_cast<IDrawable*>(obj_ptr), static_cast<IDrawable::DrawMethod>(func_ptr), priority)
+    DrawMethod(T* obj_ptr, void (T::*func_ptr)(const DrawInfo&), s32 priority = 0, u32 user_key = 0)
+        : DrawMethod(static_cast<IDrawable*>(obj_ptr), static_cast<IDrawable::DrawMethod>(func_ptr), priority, user_key)
     {
     }
 
     bool operator<(const DrawMethod& rhs) const;
 
+    // Get the priority of this draw method.
+    s32 priority() const { return mPriority; }
+
+    // Get the sort key of this draw method. (Smaller value = drawn earlier)
+    u64 sortKey() const { return mSortKey; }
+
 private:
     IDrawable*              mObjPtr;    // Draw method owner object pointer.
     IDrawable::DrawMethod   mFuncPtr;   // Draw method function pointer.
-    const s32               mPriority;  // Priority of this draw method. (Smaller value = drawn later)
+    s32                     mPriority;  // Priority of this draw method. (Smaller value = drawn later)
+    u64                     mSortKey;   // Sort key. (Inverted priority in the upper 32 bits, user key in the lower 32 bits)
 
     friend class Renderer;
 };
@@ -22,16 +22,26 @@ class RenderStep
 {
     // Class representing a "render step", that is, a set of draw methods
     // for helping with organizing layers.
+    // Draw methods are stored in a contiguous array, which is radix sorted
+    // by sort key before rendering whenever draw methods were added.
 
 public:
     RenderStep(const char* name)
         : mName(name)
+        , mIsSorted(true)
     {
     }
 
 private:
-    const char* mName;
-    std::multiset<DrawMethod> mDrawMethods;
+    void addDrawMethod_(const DrawMethod& draw_method);
+    void clearDrawMethods_();
+    void sort_() const;
+
+private:
+    const char*                         mName;
+    mutable std::vector<DrawMethod>     mDrawMethods;   // Draw methods. (Sorted if mIsSorted is true)
+    mutable std::vector<DrawMethod>     mSortBuffer;    // Radix sort scratch buffer.
+    mutable bool                        mIsSorted;
 
     friend class Layer;
     friend class Renderer;
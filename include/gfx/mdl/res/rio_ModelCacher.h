@@ -1,8 +1,9 @@
 #ifndef RIO_GFX_MDL_RES_MODEL_CACHER_H
 #define RIO_GFX_MDL_RES_MODEL_CACHER_H
 
-#include <misc/rio_Types.h>
+#include <filedevice/rio_AsyncLoader.h>
 
+#include <list>
 #include <unordered_map>
 #include <string>
 
@@ -13,7 +14,11 @@ class Model;
 class ModelCacher
 {
     // Model resource cache manager class
-    // TODO: Reference counter + unload
+    // On PC, model files are mapped read-only into memory when the file device supports it,
+    // so that the model resource points directly into the file's pages.
+    // Models are reference-counted. Models which are no longer referenced are kept in the cache for reuse,
+    // as long as the size of all cached model files fits in the budget. Past that, the least recently used
+    // of them are unloaded.
 
 public:
     static bool createSingleton();
@@ -30,11 +35,93 @@ private:
     ModelCacher& operator=(const ModelCacher&);
 
 public:
+    // Get the model cached with the given key, loading it from the given filename if it is not in the cache,
+    // and increment its reference count.
+    // Every call should be paired with a call to releaseModel(), after which the model must not be used anymore.
+    // (Models which are never released are kept until the cacher is destroyed.)
+    // If the model is being loaded asynchronously, waits for it to be loaded.
     Model* loadModel(const char* base_fname, const char* key);
+
+    // Same as loadModel(), but the file is loaded by the I/O threads of FileDeviceMgr (see AsyncLoader), with the given
+    // priority, and the model is added to the cache on the main thread once loaded. Until then, isLoading() returns true
+    // and get() returns nullptr. Releasing the model before it is loaded cancels the loading.
+    // If the loading fails, the model is not added to the cache, and releaseModel() must not be called.
+    void loadModelAsync(const char* base_fname, const char* key, s32 priority = 0);
+
+    // Check if a model is being loaded asynchronously
+    bool isLoading(const char* key) const;
+
+    // Decrement the reference count of a model obtained with loadModel().
+    // Once it reaches zero, the model stays in the cache until evicted.
+    void releaseModel(const char* key);
+
+    // Get a cached model, without changing its reference count (nullptr if not in the cache)
     Model* get(const char* key) const;
 
+    // Unload a model now, if it is in the cache and unreferenced
+    // Returns false if the model is still referenced.
+    bool unload(const char* key);
+
+    // Unload the least recently used unreferenced models until the size of the cached model files is at most the given size
+    void trim(size_t size = 0);
+
+    // Set the budget of the cache (maximum size of the cached model files), in bytes, evicting unreferenced models as needed
+    // (Default: 0, i.e. models are unloaded as soon as they are no longer referenced)
+    void setBudget(size_t budget);
+    size_t getBudget() const { return mBudget; }
+
+    // Get the size of all cached model files, in bytes
+    size_t getSize() const { return mSize; }
+
+    // Get the number of models in the cache, including unreferenced ones
+    u32 getModelNum() const { return mModelCache.size(); }
+
+    // Statistics since the creation of the cache
+    u32 getHitNum() const { return mHitNum; }           // Calls of loadModel() finding the model in the cache
+    u32 getMissNum() const { return mMissNum; }         // Calls of loadModel() or loadModelAsync() loading the model
+    u32 getEvictedNum() const { return mEvictedNum; }   // Models unloaded to fit in the budget or by trim() / unload()
+
+    // Let the system drop the vertex and index data of a mapped model from memory,
+    // once all mdl::Model instances using it have been created (and their buffers uploaded)
+    // (The data is read again from the file if accessed afterwards. Does nothing if the model is not mapped.)
+    void discardMeshData(const char* key) const;
+
+private:
+    typedef std::list<std::string> LRUList;
+
+    struct Entry
+    {
+        Model*              model;
+        u32                 size;       // File size
+        bool                is_mapped;  // Model file is mapped (else, it was loaded to the heap)
+        u32                 ref_count;
+        LRUList::iterator   lru_it;     // Position in mLRUList (if unreferenced)
+        AsyncLoader::Handle load_handle;    // Asynchronous loading (model is nullptr until it is done)
+    };
+
+    typedef std::unordered_map<std::string, Entry> Cache;
+    typedef std::unordered_map<AsyncLoader::Handle, std::string> LoadingMap;
+
+    static void freeModel_(const Entry& entry);
+    void erase_(Cache::iterator it);
+
+    static FileDevice::LoadArg makeLoadArg_(const char* base_fname);
+    // Check the model file, releasing it if it is invalid
+    static Model* checkModel_(u8* file, const FileDevice::LoadArg& arg);
+    // Add a loaded model to the cache
+    void addModel_(Entry& entry, Model* model, bool is_mapped);
+
+    static void onModelLoaded_(AsyncLoader::Handle handle, const FileDevice::LoadArg& arg, u8* data, void* user_data);
+
 private:
-    std::unordered_map<std::string, Model*> mModelCache;
+    Cache       mModelCache;
+    LoadingMap  mLoadingKey;    // Key of the model of each asynchronous loading
+    LRUList     mLRUList;       // Unreferenced models, most recently used first
+    size_t  mBudget;
+    size_t  mSize;
+    u32     mHitNum;
+    u32     mMissNum;
+    u32     mEvictedNum;
 };
 
 } } }
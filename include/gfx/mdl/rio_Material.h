@@ -97,10 +97,15 @@ public:
         return mMeshes;
     }
 
+    // Check if the shader and textures of this material are ready, without blocking (see Shader::isReady() and Texture2D::isReady())
+    // The shader locations of the textures and uniforms are set up once it is, or when the material is first bound.
+    bool isReady() const;
+
     void bind() const;
 
 private:
     void pushBackMesh_(Mesh* mesh);
+    void setupShaderLocations_() const;
 
 private:
     const res::Material&    mResMaterial;       // Material resource.
@@ -122,6 +127,8 @@ private:
 
     RenderState             mRenderState;       // Render state.
 
+    mutable bool            mIsShaderSetup;     // Shader locations are set up.
+
     friend class Model;
 };
 
@@ -2,9 +2,14 @@
 #define RIO_GFX_MDL_MESH_H
 
 #include <gfx/mdl/res/rio_MeshData.h>
+#include <gfx/rio_Frustum.h>
 #include <gpu/rio_VertexArray.h>
 #include <math/rio_Matrix.h>
 
+#if RIO_IS_WIN
+#include <misc/gl/rio_GL.h>
+#endif // RIO_IS_WIN
+
 namespace rio { namespace mdl {
 
 class Material;
@@ -13,7 +18,8 @@ class Model;
 class Mesh
 {
 public:
-    Mesh(const res::Mesh* res_mesh, Model* parent_mdl);
+    // The local and world matrices are stored by the parent model, contiguously for all of its meshes
+    Mesh(const res::Mesh* res_mesh, Model* parent_mdl, Matrix34f* local_mtx, Matrix34f* world_mtx);
 
     const res::Mesh& resMesh() const
     {
@@ -30,17 +36,55 @@ public:
         return mMaterial;
     }
 
+    const Matrix34f& localMtx() const
+    {
+        return *mLocalMtx;
+    }
+
     const Matrix34f& worldMtx() const
     {
-        return mWorldMtx;
+        return *mWorldMtx;
+    }
+
+    // Bounds of the vertices, in mesh space (computed at creation)
+    const Bounds& localBounds() const
+    {
+        return mLocalBounds;
+    }
+
+    // Bounds of the vertices, transformed by worldMtx()
+    const Bounds& worldBounds() const
+    {
+        return mWorldBounds;
+    }
+
+    // Check if the world bounds are (at least partly) inside the frustum
+    bool isVisible(const Frustum& frustum) const
+    {
+        return frustum.isVisible(mWorldBounds);
     }
 
     void draw() const;
 
+    // Draw only if visible in the frustum, returns true if drawn
+    bool draw(const Frustum& frustum) const;
+
+#if RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    // Draw all instances set with Model::setInstanceWorldMtx() in a single draw call
+    // The shader is expected to read the instance world matrix from the attributes at
+    // Model::cInstanceMtxLocation (one row per location) and to apply localMtx() itself
+    // (Not available with OpenGL ES 2.0, which has no instanced draw calls.)
+    void drawInstanced() const;
+#endif // RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
 private:
     void setMaterial_(Material* material);
     void calcLocalMtx_();
     void calcWorldMtx_(const Matrix34f& mdl_world_mtx);
+    void calcWorldBounds_();
+#if RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    void enableInstancing_(VertexBuffer& instance_vbo, VertexStream* instance_mtx_stream);
+#endif // RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
 
 private:
     const res::Mesh&    mResMesh;           // Mesh resource.
@@ -48,12 +92,13 @@ private:
 
     Material*           mMaterial;          // Material to use.
 
-    Matrix34f           mLocalMtx;          // Local transformation matrix.
-    Matrix34f           mWorldMtx;          // World transformation matrix. (Model x Local)
+    Matrix34f*          mLocalMtx;          // Local transformation matrix.
+    Matrix34f*          mWorldMtx;          // World transformation matrix. (Model x Local)
 
-    const u32*          mIdxBuf;            // Index buffer.
-    u32                 mIdxNum;            // Indices count.
+    Bounds              mLocalBounds;       // Bounds in mesh space.
+    Bounds              mWorldBounds;       // Bounds in world space.
 
+    IndexBuffer         mIBO;               // Index buffer object.
     VertexBuffer        mVBO;               // Vertex buffer object.
     VertexStream        mPosStream;         // Position vertex attribute stream.
     VertexStream        mTexCoordStream;    // Texture coordinates vertex attribute stream layout.
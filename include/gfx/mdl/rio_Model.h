@@ -13,6 +13,13 @@ class Mesh;
 
 class Model
 {
+public:
+    // First vertex attribute location of the instance world matrix (3 locations, one per row)
+    static constexpr u32 cInstanceMtxLocation = 3;
+
+    // Called by draw() before drawing a mesh, once its material is bound (e.g. to set its world matrix uniform)
+    typedef void (*MeshDrawCallback)(const Mesh& mesh, void* user_data);
+
 public:
     Model(const res::Model* res_mdl);
     ~Model();
@@ -57,16 +64,40 @@ public:
     const Matrix34f& getModelWorldMtx() const { return mModelMtx; }
     void setModelWorldMtx(const Matrix34f& srt);
 
+    // Draw the meshes visible in the frustum, material by material, only binding the materials of visible meshes
+    // The visibility tests are counted by the frustum (see Frustum::getVisibleNum() and Frustum::getCulledNum()).
+    // Returns the number of meshes drawn.
+    u32 draw(const Frustum& frustum, MeshDrawCallback callback = nullptr, void* user_data = nullptr) const;
+
+#if RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    // Set the world matrices of the instances drawn by Mesh::drawInstanced()
+    // Note: On Cafe, the array is passed directly to the GPU, therefore it must not be
+    //       modified or freed as long as the instances are being drawn.
+    void setInstanceWorldMtx(const Matrix34f* mtx, u32 num);
+#endif // RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+    u32 numInstances() const
+    {
+        return mNumInstances;
+    }
+
 private:
     const res::Model& mResModel;
 
     Mesh* mMeshes;
     u32 mNumMeshes;
 
+    Matrix34f* mMeshLocalMtx;
+    Matrix34f* mMeshWorldMtx;
+
     Material* mMaterials;
     u32 mNumMaterials;
 
     Matrix34f mModelMtx;
+
+    VertexBuffer mInstanceVBO;
+    VertexStream mInstanceMtxStream[3];     // Instance world matrix rows, shared by the vertex arrays of all meshes
+    u32 mNumInstances;
 };
 
 } }
@@ -0,0 +1,118 @@
+#ifndef RIO_GFX_MDL_TRANSFORM_GRAPH_H
+#define RIO_GFX_MDL_TRANSFORM_GRAPH_H
+
+#include <math/rio_Matrix.h>
+
+#include <vector>
+
+namespace rio { namespace mdl {
+
+class Model;
+
+class TransformGraph
+{
+    // Hierarchy of transform nodes, each with a local SRT, a parent and optionally an attached model.
+    // Nodes are stored in flat arrays in depth-first order, so that every node comes after its parent
+    // and the subtree of a node is contiguous. Changing the SRT of a node marks it dirty, and update()
+    // only recomputes the world matrices of the subtrees of dirty nodes (and of their attached models).
+    // Creating, destroying and reparenting nodes moves the nodes after them in the arrays; they are
+    // meant to be done when building the scene rather than every frame.
+
+public:
+    typedef u32 NodeID;
+    static constexpr NodeID cInvalidNode = 0xFFFFFFFF;
+
+public:
+    TransformGraph();
+
+    // Reserve space for the given number of nodes
+    void reserve(u32 num);
+
+    // Create a node with an identity SRT, as the last child of parent (or as a root if cInvalidNode)
+    NodeID createNode(NodeID parent = cInvalidNode);
+
+    // Destroy a node and all of its descendants (their models are detached, not destroyed)
+    void destroyNode(NodeID node);
+
+    // Move a node and its descendants under another parent (or make it a root if cInvalidNode)
+    // The new parent must not be in the subtree of the node.
+    void setParent(NodeID node, NodeID parent);
+    NodeID getParent(NodeID node) const { return mNodes[index_(node)].parent; }
+
+    bool isValid(NodeID node) const
+    {
+        return node < mIndex.size() && mIndex[node] != cInvalidIndex;
+    }
+
+    u32 getNodeNum() const { return mNodes.size(); }
+
+    void setSRT(NodeID node, const Vector3f& s, const Vector3f& r, const Vector3f& t);
+    void setScale(NodeID node, const Vector3f& s);
+    void setRotation(NodeID node, const Vector3f& r);
+    void setTranslation(NodeID node, const Vector3f& t);
+
+    const Vector3f& getScale(NodeID node) const { return mNodes[index_(node)].scale; }
+    const Vector3f& getRotation(NodeID node) const { return mNodes[index_(node)].rotate; }
+    const Vector3f& getTranslation(NodeID node) const { return mNodes[index_(node)].translate; }
+
+    // Matrices as of the last update()
+    const Matrix34f& getLocalMtx(NodeID node) const { return mLocalMtx[index_(node)]; }
+    const Matrix34f& getWorldMtx(NodeID node) const { return mWorldMtx[index_(node)]; }
+
+    // Attach a model to a node, so that its world matrix is set to the world matrix of the node
+    // (nullptr to detach). The model is not owned by the graph.
+    void setModel(NodeID node, Model* model);
+    Model* getModel(NodeID node) const { return mNodes[index_(node)].model; }
+
+    // Mark a node dirty, so that its subtree is recomputed by the next update()
+    void markDirty(NodeID node);
+
+    // Recompute the local and world matrices of the dirty nodes and their descendants
+    void update();
+
+    // Number of nodes recomputed by the last update()
+    u32 getUpdatedNum() const { return mUpdatedNum; }
+
+private:
+    static constexpr u32 cInvalidIndex = 0xFFFFFFFF;
+
+    struct Node
+    {
+        NodeID      id;
+        NodeID      parent;
+        u32         subtree_size;   // Number of nodes in the subtree, including this one
+        Model*      model;
+        Vector3f    scale;
+        Vector3f    rotate;
+        Vector3f    translate;
+        bool        local_dirty;    // SRT changed since the last update
+        bool        dirty;          // In the dirty list
+    };
+
+    u32 index_(NodeID node) const
+    {
+        RIO_ASSERT(isValid(node));
+        return mIndex[node];
+    }
+
+    // Move the nodes in [first, first + num) so that they start at dst (an index in the arrays without them)
+    void moveRange_(u32 first, u32 num, u32 dst);
+    // Add to the subtree sizes of node and its ancestors
+    void addSubtreeSize_(NodeID node, s32 num);
+    // Update the indices of the IDs of the nodes in [first, end)
+    void updateIndices_(u32 first, u32 end);
+
+private:
+    std::vector<Node>       mNodes;         // Depth-first order
+    std::vector<Matrix34f>  mLocalMtx;      // Same order as mNodes
+    std::vector<Matrix34f>  mWorldMtx;      // Same order as mNodes
+    std::vector<u32>        mIndex;         // Index of each node ID in the arrays
+    std::vector<NodeID>     mFreeID;        // IDs of destroyed nodes, for reuse
+    std::vector<NodeID>     mDirtyNode;     // Nodes marked dirty since the last update
+    std::vector<u32>        mDirtyIndex;    // (Temporary used by update())
+    u32                     mUpdatedNum;
+};
+
+} }
+
+#endif // RIO_GFX_MDL_TRANSFORM_GRAPH_H
@@ -0,0 +1,78 @@
+#ifndef RIO_GFX_FRUSTUM_H
+#define RIO_GFX_FRUSTUM_H
+
+#include <math/rio_Matrix.h>
+
+namespace rio {
+
+class Camera;
+class Projection;
+
+// Axis-aligned bounding box and bounding sphere of an object
+struct Bounds
+{
+    Vector3f    min;
+    Vector3f    max;
+    Vector3f    center;     // Sphere center
+    f32         radius;     // Sphere radius
+
+    // Set to the bounds of points
+    void set(const BaseVec3f* points, u32 num, u32 stride = sizeof(BaseVec3f));
+
+    // Set to bounds b transformed by mtx
+    void setTransform(const BaseMtx34f& mtx, const Bounds& b);
+};
+
+// View frustum, made of the 6 clip planes of a view-projection matrix
+// The visibility tests count the visible and culled objects since the frustum was last set,
+// which, if it is set every frame, gives the numbers of the frame.
+class Frustum
+{
+public:
+    enum Plane
+    {
+        PLANE_LEFT = 0,
+        PLANE_RIGHT,
+        PLANE_BOTTOM,
+        PLANE_TOP,
+        PLANE_NEAR,
+        PLANE_FAR,
+        PLANE_NUM
+    };
+
+public:
+    Frustum();
+
+    void set(const Camera& camera, const Projection& projection);
+    void set(const BaseMtx44f& view_proj_mtx);
+
+    // Plane (x, y, z) = normal, w = distance, with points inside the frustum on the positive side
+    const Vector4f& getPlane(Plane plane) const
+    {
+        RIO_ASSERT(plane < PLANE_NUM);
+        return mPlane[plane];
+    }
+
+    bool isVisible(const Vector3f& center, f32 radius) const;
+    bool isVisible(const Vector3f& min, const Vector3f& max) const;
+    // Sphere test, then box test
+    bool isVisible(const Bounds& bounds) const;
+
+    u32 getVisibleNum() const { return mVisibleNum; }
+    u32 getCulledNum() const { return mCulledNum; }
+    void resetCounters();
+
+private:
+    bool isSphereVisible_(const Vector3f& center, f32 radius) const;
+    bool isBoxVisible_(const Vector3f& min, const Vector3f& max) const;
+    bool count_(bool visible) const;
+
+private:
+    Vector4f    mPlane[PLANE_NUM];
+    mutable u32 mVisibleNum;
+    mutable u32 mCulledNum;
+};
+
+}
+
+#endif // RIO_GFX_FRUSTUM_H
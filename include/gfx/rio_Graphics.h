@@ -108,11 +108,12 @@ public:
     };
 
 private:
-    static s32  sViewportX,     sViewportY;
-    static u32  sViewportWidth, sViewportHeight;
-    static f32  sViewportNear,  sViewportFar;
-    static s32  sScissorX,      sScissorY;
-    static u32  sScissorWidth,  sScissorHeight;
+    // Per thread, as each render worker thread has its own context
+    static thread_local s32  sViewportX,     sViewportY;
+    static thread_local u32  sViewportWidth, sViewportHeight;
+    static thread_local f32  sViewportNear,  sViewportFar;
+    static thread_local s32  sScissorX,      sScissorY;
+    static thread_local u32  sScissorWidth,  sScissorHeight;
 
     friend class Window;
 };
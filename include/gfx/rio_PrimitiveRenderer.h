@@ -3,6 +3,7 @@
 
 #include <gfx/rio_Color.h>
 #include <gpu/rio_Drawer.h>
+#include <gpu/rio_IndexBuffer.h>
 #include <gpu/rio_Shader.h>
 #include <gpu/rio_TextureSampler.h>
 #include <gpu/rio_VertexArray.h>
@@ -157,8 +158,15 @@ private:
     };
     static_assert(sizeof(Vertex) == 0x24, "Vertex size mismatch");
 
-    void drawTriangles_(const BaseMtx34f& model_mtx, const Color4f& c0, const Color4f& c1, Vertex* vtx, u32 vtx_num, u16* idx, u32 idx_num, const Texture2D* texture = nullptr);
-    void drawLines_(const BaseMtx34f& model_mtx, const Color4f& c0, const Color4f& c1, Drawer::PrimitiveMode mode, Vertex* vtx, u32 vtx_num, u16* idx, u32 idx_num);
+    // Range of the index buffer used by a primitive
+    struct IndexRange
+    {
+        u32 first;
+        u32 count;
+    };
+
+    void drawTriangles_(const BaseMtx34f& model_mtx, const Color4f& c0, const Color4f& c1, const IndexRange& range, const Texture2D* texture = nullptr);
+    void drawLines_(const BaseMtx34f& model_mtx, const Color4f& c0, const Color4f& c1, Drawer::PrimitiveMode mode, const IndexRange& range);
 
     static inline void getQuadVertex(Vertex* vtx, u16* idx);
     static inline void getLineVertex(Vertex* vtx, u16* idx);
@@ -189,8 +197,13 @@ private:
     // Vertex Array Object
     VertexArray         mVertexArray;
 
-    // Vertex Buffer Object
+    // Vertex Buffer Object (vertices of all primitives)
     VertexBuffer        mVertexBuffer;
+    Vertex*             mVertexBuf;
+
+    // Index Buffer Object (indices of all primitives)
+    IndexBuffer         mIndexBuffer;
+    u16*                mIndexBuf;
 
     // Vertex Stream layouts
     VertexStream        mPosStream;
@@ -201,45 +214,35 @@ private:
     TextureSampler2D    mDrawQuadSampler;
 
     // Quad, Box
-    Vertex*             mQuadVertexBuf;
-    u16*                mQuadIndexBuf;
-    u16*                mBoxIndexBuf;
+    IndexRange          mQuadRange;
+    IndexRange          mBoxRange;
 
     // Line
-    Vertex*             mLineVertexBuf;
-    u16*                mLineIndexBuf;
+    IndexRange          mLineRange;
 
     // Cube
-    Vertex*             mCubeVertexBuf;
-    u16*                mCubeIndexBuf;
+    IndexRange          mCubeRange;
 
     // WireCube
-    Vertex*             mWireCubeVertexBuf;
-    u16*                mWireCubeIndexBuf;
+    IndexRange          mWireCubeRange;
 
     // SphereS
-    Vertex*             mSphereSVertexBuf;
-    u16*                mSphereSIndexBuf;
+    IndexRange          mSphereSRange;
 
     // SphereL
-    Vertex*             mSphereLVertexBuf;
-    u16*                mSphereLIndexBuf;
+    IndexRange          mSphereLRange;
 
     // DiskS, DiskL, CircleS, CircleL
-    Vertex*             mDiskSVertexBuf;
-    u16*                mDiskSIndexBuf;
-    Vertex*             mDiskLVertexBuf;
-    u16*                mDiskLIndexBuf;
-    u16*                mCircleSIndexBuf;
-    u16*                mCircleLIndexBuf;
+    IndexRange          mDiskSRange;
+    IndexRange          mDiskLRange;
+    IndexRange          mCircleSRange;
+    IndexRange          mCircleLRange;
 
     // CylinderS
-    Vertex*             mCylinderSVertexBuf;
-    u16*                mCylinderSIndexBuf;
+    IndexRange          mCylinderSRange;
 
     // CylinderL
-    Vertex*             mCylinderLVertexBuf;
-    u16*                mCylinderLIndexBuf;
+    IndexRange          mCylinderLRange;
 };
 
 }
@@ -21,8 +21,10 @@ public:
     // - width: The desired width
     // - height: The desired height
     // - resizable: Should window be resizable
+    // - invisible: Should window be hidden
     // - gl_major: OpenGL Context Major Version
     // - gl_minor: OpenGL Context Minor Version
+    // - offscreen: Never present the frame buffer to the screen (implies invisible)
     static bool createSingleton(
         u32 width = 1280, u32 height = 720
 #if RIO_IS_WIN
@@ -30,6 +32,7 @@ public:
         , bool invisible = false
         , u32 gl_major = 4
         , u32 gl_minor = 0
+        , bool offscreen = false
 #endif // RIO_IS_WIN
     );
 
@@ -69,11 +72,25 @@ public:
     // Check if window is still running
     bool isRunning() const;
 
+#if RIO_IS_WIN
+    // Request the window to close (isRunning() will return false from now on)
+    void close();
+#endif // RIO_IS_WIN
+
     // Swap the front and back buffers
     // This function will perform a GPU flush and block until swapping is done
     // For Cafe, TV output is automatically duplicated to the DRC
+    // In offscreen mode, this function only flushes the GPU commands of the frame
     void swapBuffers() const;
 
+#if RIO_IS_WIN
+    // Check if the window was created in offscreen mode
+    bool isOffscreen() const
+    {
+        return mNativeWindow.mIsOffscreen;
+    }
+#endif // RIO_IS_WIN
+
     // Clear the window's color buffer
     void clearColor(f32 r, f32 g, f32 b, f32 a = 1.0f);
 
@@ -139,6 +156,34 @@ public:
 #endif
     }
 
+#if RIO_IS_WIN && (!defined(RIO_GLES) || defined(GL_ES_VERSION_3_0))
+
+    // Queue an asynchronous readback of the window's color buffer (RGBA8) and, optionally,
+    // of its depth-stencil buffer (D24S8, copied through updateDepthBufferTexture()).
+    // The copy is done into pixel pack buffers, so this call does not wait for the GPU.
+    // Returns false if NativeWindow::cReadbackBufferNum readbacks are already in flight, or if read_depth
+    // is set with OpenGL ES, which cannot read depth-stencil pixels.
+    bool requestReadback(bool read_depth = false);
+
+    // Retrieve the oldest queued readback if the GPU is done with it.
+    // Each buffer must be at least getWidth() * getHeight() * 4 bytes.
+    // Returns false (without blocking) if no readback is queued or it is not ready yet, and also returns
+    // false if the readback could not be mapped, in which case it is dropped and the buffers must not be used.
+    // Parameters:
+    // - wait: Block until the oldest queued readback is ready
+    bool tryGetReadback(void* color_pixels, void* depth_pixels = nullptr, bool wait = false);
+
+    // Get the number of readbacks currently in flight
+    u32 getReadbackNum() const
+    {
+        return mNativeWindow.mReadbackNum;
+    }
+
+    // Discard all readbacks currently in flight
+    void discardReadbacks();
+
+#endif // RIO_IS_WIN && (!defined(RIO_GLES) || defined(GL_ES_VERSION_3_0))
+
 #if RIO_IS_WIN
     typedef NativeWindow::OnResizeCallback OnResizeCallback;
     void setOnResizeCallback(OnResizeCallback callback)
@@ -167,6 +212,7 @@ private:
         , bool invisible
         , u32 gl_major
         , u32 gl_minor
+        , bool offscreen
 #endif // RIO_IS_WIN
     );
     // Terminate the window
@@ -191,6 +237,25 @@ private:
     void resizeCallback_(s32 width, s32 height);
     static void resizeCallback_(GLFWwindow* glfw_window, s32 width, s32 height);
 
+#ifdef RIO_USE_EGL
+    // Create the context through EGL, with no window system
+    bool initializeEGL_(u32 gl_major, u32 gl_minor);
+    void terminateEGL_();
+#endif // RIO_USE_EGL
+
+    // Create an additional context sharing its objects with the window's context
+    // (Must be called from the main thread)
+    bool createSharedContext_(NativeWindow::SharedContext* p_context) const;
+    void destroySharedContext_(NativeWindow::SharedContext* p_context) const;
+    // Make a shared context current on the calling thread, or release the current one if nullptr
+    void makeSharedContextCurrent_(const NativeWindow::SharedContext* p_context) const;
+    // Set up the state of the current shared context the same way as the window's context
+    void setupSharedContext_() const;
+
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    void destroyReadbackBuffers_();
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
 #endif
 
     void updateDepthBufferTexture_();
@@ -202,6 +267,10 @@ private:
     u32             mWidth;         // Current width
     u32             mHeight;        // Current height
     NativeWindow    mNativeWindow;  // Native window instance
+
+#if RIO_IS_WIN
+    friend class RenderWorker;
+#endif // RIO_IS_WIN
 };
 
 }
@@ -14,6 +14,20 @@ class NativeWindow
 public:
     typedef void (*OnResizeCallback)(s32 width, s32 height);
 
+    // Additional context sharing its objects with the window's context
+    struct SharedContext
+    {
+#ifdef RIO_USE_EGL
+        EGLContext context;
+        EGLSurface surface;
+#else
+        GLFWwindow* pGLFWwindow;
+#endif // RIO_USE_EGL
+    };
+
+    // Number of frames that can be in flight for asynchronous readback
+    static constexpr u32 cReadbackBufferNum = 3;
+
 private:
     using Clock = std::chrono::steady_clock;
     using Duration = Clock::duration;
@@ -24,6 +38,15 @@ public:
     NativeWindow()
         : mpGLFWwindow(nullptr)
         , mpOnResizeCallback(nullptr)
+        , mIsOffscreen(false)
+#ifdef RIO_USE_EGL
+        , mEGLDisplay(EGL_NO_DISPLAY)
+        , mEGLContext(EGL_NO_CONTEXT)
+        , mEGLSurface(EGL_NO_SURFACE)
+        , mEGLConfig(nullptr)
+        , mEGLContextAttribs { EGL_NONE }
+        , mIsClosing(false)
+#endif // RIO_USE_EGL
         , mFramebufferHandle(GL_NONE)
         , mColorBufferTextureHandle(GL_NONE)
         , mColorBufferTextureFormat(TEXTURE_FORMAT_INVALID)
@@ -32,12 +55,24 @@ public:
         , mDepthBufferTextureFormat(TEXTURE_FORMAT_INVALID)
         , mDepthBufferCopyFramebufferSrc(GL_NONE)
         , mDepthBufferCopyFramebufferDst(GL_NONE)
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+        , mReadbackBuffer()
+        , mReadbackHead(0)
+        , mReadbackNum(0)
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
     {
         setSwapInterval_(1);
     }
 
     GLFWwindow* getGLFWwindow() const { return mpGLFWwindow; }
 
+#ifdef RIO_USE_EGL
+    EGLDisplay getEGLDisplay() const { return mEGLDisplay; }
+    EGLContext getEGLContext() const { return mEGLContext; }
+#endif // RIO_USE_EGL
+
+    bool isOffscreen() const { return mIsOffscreen; }
+
     GLuint getFramebufferHandle() const { return mFramebufferHandle; }
 
     GLuint getColorBufferTextureHandle() const { return mColorBufferTextureHandle; }
@@ -78,6 +113,17 @@ private:
     GLFWwindow* mpGLFWwindow;
     OnResizeCallback mpOnResizeCallback;
 
+    bool mIsOffscreen;
+
+#ifdef RIO_USE_EGL
+    EGLDisplay mEGLDisplay;
+    EGLContext mEGLContext;
+    EGLSurface mEGLSurface; // 1x1 pbuffer, unless EGL_KHR_surfaceless_context is supported
+    EGLConfig mEGLConfig;
+    EGLint mEGLContextAttribs[7];
+    bool mIsClosing;
+#endif // RIO_USE_EGL
+
     GLuint mFramebufferHandle;
 
     GLuint mColorBufferTextureHandle;
@@ -91,6 +137,21 @@ private:
     GLuint mDepthBufferCopyFramebufferSrc;
     GLuint mDepthBufferCopyFramebufferDst;
 
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    struct ReadbackBuffer
+    {
+        GLuint  colorHandle;    // Pixel pack buffer for the color buffer
+        GLuint  depthHandle;    // Pixel pack buffer for the depth-stencil buffer
+        u32     size;           // Size of each pixel pack buffer in bytes
+        GLsync  fence;          // Signaled once the copy into the buffers is done
+        bool    hasDepth;       // Was the depth-stencil buffer read as well
+    };
+
+    ReadbackBuffer mReadbackBuffer[cReadbackBufferNum];
+    u32 mReadbackHead;  // Index of the oldest in-flight readback
+    u32 mReadbackNum;   // Number of in-flight readbacks
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
     Duration mFrameDuration;
     mutable TimePoint mFrameEndTarget;
 
@@ -0,0 +1,193 @@
+#ifndef RIO_GFX_RENDER_WORKER_MGR_WIN_H
+#define RIO_GFX_RENDER_WORKER_MGR_WIN_H
+
+#include <gfx/rio_Window.h>
+#include <gpu/rio_RenderBuffer.h>
+#include <gpu/rio_RenderTarget.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+namespace rio {
+
+class RenderWorkerMgr;
+
+// A thread owning a context that shares its objects (textures, shaders, buffers)
+// with the window's context, as well as its own offscreen render buffer
+class RenderWorker
+{
+public:
+    // Get the render worker of the calling thread (nullptr for any other thread)
+    static RenderWorker* current() { return sCurrent; }
+
+public:
+    u32 getIndex() const { return mIndex; }
+    u32 getWidth() const { return mWidth; }
+    u32 getHeight() const { return mHeight; }
+
+    // Color buffer (RGBA8) and depth-stencil buffer (D24S8) of this worker
+    const Texture2D& getColorTexture() const { return *mpColorTexture; }
+    const Texture2D& getDepthTexture() const { return *mpDepthTexture; }
+
+    RenderBuffer& getRenderBuffer() { return *mpRenderBuffer; }
+    const RenderBuffer& getRenderBuffer() const { return *mpRenderBuffer; }
+
+    // Bind the render buffer of this worker
+    void bind() const { mpRenderBuffer->bind(); }
+
+    // Read the color buffer of this worker into pixels (getWidth() * getHeight() * 4 bytes)
+    bool readColor(void* pixels);
+
+private:
+    RenderWorker(RenderWorkerMgr* mgr, u32 index, u32 width, u32 height);
+    ~RenderWorker();
+
+    RenderWorker(const RenderWorker&);
+    RenderWorker& operator=(const RenderWorker&);
+
+    // Create the context (called from the main thread)
+    bool initialize_();
+    // Start the thread, once the worker is registered to the manager (called from the main thread)
+    void start_();
+    // Wait for the thread to end and destroy the context (called from the main thread)
+    void terminate_();
+
+    void threadMain_();
+
+    // Create and destroy GL objects local to this worker (called from the worker thread)
+    bool createRenderBuffer_();
+    void destroyRenderBuffer_();
+
+    // Get the vertex array of this worker's context for a VertexArray key, creating it if needed
+    u32 getVertexArray_(u32 key, bool* p_created);
+    // Delete the vertex arrays released by their VertexArray (or all of them)
+    void deleteVertexArrays_(bool all);
+
+private:
+    static thread_local RenderWorker* sCurrent;
+
+    RenderWorkerMgr*            mpMgr;
+    u32                         mIndex;
+    u32                         mWidth;
+    u32                         mHeight;
+    NativeWindow::SharedContext mContext;
+    std::thread                 mThread;
+    Texture2D*                  mpColorTexture;
+    Texture2D*                  mpDepthTexture;
+    RenderTargetColor           mColorTarget;
+    RenderTargetDepth           mDepthTarget;
+    RenderBuffer*               mpRenderBuffer;
+    std::unordered_map<u32, u32>
+                                mVertexArray;           // VertexArray key -> handle in this context
+    std::vector<u32>            mReleasedVertexArray;   // Keys to delete (guarded by the manager's mutex)
+
+    friend class RenderWorkerMgr;
+    friend class VertexArray;
+};
+
+// Pool of render workers for parallel offscreen rendering.
+// Jobs are run by the first idle worker, with the worker's context current and its render buffer bound.
+// Notes:
+// - Objects created in the window's context before a job is submitted can be used by the job.
+// - Vertex arrays are not shared between contexts, so VertexArray creates its own for each worker.
+//   Each worker deletes its own when the VertexArray is destroyed or processed again, and all of them when it exits.
+// - Singletons such as PrimitiveRenderer and the layer renderer must not be used from jobs.
+class RenderWorkerMgr
+{
+public:
+    static const u32 cWorkerMaxNum = 16;
+
+    typedef void (*JobFunc)(RenderWorker& worker, void* arg);
+
+public:
+    // Create render worker pool singleton instance
+    // Must be called from the main thread, after the window has been created
+    // Parameters:
+    // - worker_num: Number of workers (0 to use the number of hardware threads, up to cWorkerMaxNum)
+    // - width: Width of the render buffer of each worker
+    // - height: Height of the render buffer of each worker
+    static bool createSingleton(u32 worker_num, u32 width, u32 height);
+
+    // Destroy render worker pool singleton instance (waits for all jobs to be done)
+    static void destroySingleton();
+
+    // Get render worker pool singleton instance
+    static RenderWorkerMgr* instance() { return sInstance; }
+
+private:
+    static RenderWorkerMgr* sInstance;
+
+    RenderWorkerMgr();
+    ~RenderWorkerMgr();
+
+    RenderWorkerMgr(const RenderWorkerMgr&);
+    RenderWorkerMgr& operator=(const RenderWorkerMgr&);
+
+public:
+    u32 getWorkerNum() const { return mWorkerNum; }
+
+    RenderWorker* getWorker(u32 index) const
+    {
+        RIO_ASSERT(index < mWorkerNum);
+        return mpWorker[index];
+    }
+
+    // Queue a job to be run by the next idle worker
+    void submit(JobFunc func, void* arg);
+
+    // Block until all submitted jobs are done
+    void wait();
+
+    // Get the number of submitted jobs which are not done yet
+    u32 getPendingJobNum() const;
+
+private:
+    struct Job
+    {
+        JobFunc func;
+        void*   arg;
+        GLsync  fence;  // Signaled once the submitting context's commands are done
+    };
+
+    bool initialize_(u32 worker_num, u32 width, u32 height);
+    void terminate_();
+
+    // Called by the workers
+    bool popJob_(Job* p_job);
+    void onJobDone_();
+    void onWorkerReady_(bool success);
+    void onVertexArrayCreated_(u32 key, u32 worker_index);
+    void takeReleasedVertexArrays_(u32 worker_index, std::vector<u32>* p_keys);
+
+    // Called by VertexArray when the vertex arrays of a key are no longer used
+    static void releaseVertexArray_(u32 key);
+
+private:
+    mutable std::mutex      mMutex;
+    std::condition_variable mJobCondition;
+    std::condition_variable mDoneCondition;
+    std::deque<Job>         mJobs;
+    u32                     mPendingNum;    // Queued and running jobs
+    u32                     mReadyNum;      // Workers done initializing
+    bool                    mIsReady;       // All workers initialized successfully
+    bool                    mIsExiting;
+    RenderWorker*           mpWorker[cWorkerMaxNum];
+    u32                     mWorkerNum;
+    std::unordered_map<u32, u32>
+                            mVertexArrayWorkerMask; // VertexArray key -> workers which created a vertex array for it
+
+    friend class RenderWorker;
+    friend class VertexArray;
+};
+
+}
+
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+#endif // RIO_GFX_RENDER_WORKER_MGR_WIN_H
@@ -4,6 +4,8 @@
 // This file is included by rio_Drawer.h
 //#include <gpu/rio_Drawer.h>
 
+#include <gpu/rio_IndexBuffer.h>
+
 #include <gx2/draw.h>
 
 namespace rio {
@@ -38,6 +40,17 @@ inline void Drawer::DrawElementsInstanced(PrimitiveMode mode, u32 count, const u
     GX2DrawIndexedEx(static_cast<GX2PrimitiveMode>(mode), count, GX2_INDEX_TYPE_U16, indices, 0, instanceCount);
 }
 
+inline void Drawer::DrawElementsInstanced(PrimitiveMode mode, const IndexBuffer& index_buffer, u32 count, u32 instanceCount, u32 first)
+{
+    RIO_ASSERT(first + count <= index_buffer.getCount());
+    GX2DrawIndexedEx(
+        static_cast<GX2PrimitiveMode>(mode), count,
+        index_buffer.getFormat() == IndexBuffer::FORMAT_U32 ? GX2_INDEX_TYPE_U32 : GX2_INDEX_TYPE_U16,
+        (const u8*)index_buffer.getData() + first * index_buffer.getIndexSize(),
+        0, instanceCount
+    );
+}
+
 inline void Drawer::DrawArrays(PrimitiveMode mode, u32 count, u32 first)
 {
     DrawArraysInstanced(mode, count, 1, first);
@@ -53,6 +66,16 @@ inline void Drawer::DrawElements(PrimitiveMode mode, u32 count, const u16* indic
     DrawElementsInstanced(mode, count, indices, 1);
 }
 
+inline void Drawer::DrawElements(PrimitiveMode mode, const IndexBuffer& index_buffer, u32 count, u32 first)
+{
+    DrawElementsInstanced(mode, index_buffer, count, 1, first);
+}
+
+inline void Drawer::DrawElements(PrimitiveMode mode, const IndexBuffer& index_buffer)
+{
+    DrawElements(mode, index_buffer, index_buffer.getCount());
+}
+
 }
 
 #endif // RIO_GPU_DRAWER_CAFE_H
@@ -5,6 +5,8 @@
 
 namespace rio {
 
+class IndexBuffer;
+
 class Drawer
 {
 public:
@@ -23,6 +25,15 @@ public:
     static void DrawArrays(PrimitiveMode mode, u32 count, u32 first = 0);
     static void DrawElements(PrimitiveMode mode, u32 count, const u32* indices);
     static void DrawElements(PrimitiveMode mode, u32 count, const u16* indices);
+
+    // Draw using an index buffer object
+    // The index buffer must be the one set to the currently bound vertex array
+    // Parameters:
+    // - count: Number of indices to draw
+    // - first: Index of the first index to draw
+    static void DrawElementsInstanced(PrimitiveMode mode, const IndexBuffer& index_buffer, u32 count, u32 instanceCount, u32 first = 0);
+    static void DrawElements(PrimitiveMode mode, const IndexBuffer& index_buffer, u32 count, u32 first = 0);
+    static void DrawElements(PrimitiveMode mode, const IndexBuffer& index_buffer);
 };
 
 }
@@ -0,0 +1,119 @@
+#ifndef RIO_GPU_INDEX_BUFFER_H
+#define RIO_GPU_INDEX_BUFFER_H
+
+#include <misc/rio_Types.h>
+
+namespace rio {
+
+class VertexArray;
+
+class IndexBuffer
+{
+    // Wrapper class representing a buffer of vertex indices.
+    // On PC, the indices are uploaded once to a GPU buffer object, which is bound
+    // by the VertexArray it is attached to.
+
+    // Note: On Cafe, data is passed directly to the GPU, therefore it must not be
+    //       freed as long as this index buffer is being used.
+
+public:
+    enum Format : u32
+    {
+        FORMAT_U16,
+        FORMAT_U32
+    };
+
+public:
+    IndexBuffer();
+    ~IndexBuffer();
+
+private:
+    IndexBuffer(const IndexBuffer&);
+    IndexBuffer& operator=(const IndexBuffer&);
+
+public:
+    IndexBuffer(const u16* data, u32 count)
+        : IndexBuffer()
+    {
+        setDataInvalidate(data, count);
+    }
+
+    IndexBuffer(const u32* data, u32 count)
+        : IndexBuffer()
+    {
+        setDataInvalidate(data, count);
+    }
+
+    // (On PC, the data is only in the GPU buffer object, and this returns nullptr.)
+    const void* getData() const { return mpData; }
+    u32 getCount() const { return mCount; }
+    Format getFormat() const { return mFormat; }
+
+    u32 getIndexSize() const
+    {
+        return mFormat == FORMAT_U32 ? sizeof(u32) : sizeof(u16);
+    }
+
+    u32 getSize() const
+    {
+        return mCount * getIndexSize();
+    }
+
+    // Sets the passed data pointer as this object's data buffer.
+    // (On PC, the data is copied and can be freed afterwards.)
+    void setData(const u16* data, u32 count)
+    {
+        setData_(data, count, FORMAT_U16);
+    }
+
+    void setData(const u32* data, u32 count)
+    {
+        setData_(data, count, FORMAT_U32);
+    }
+
+    // Setter functions with cache invalidation (same rules as above apply, currently only useful for Cafe):
+    void setDataInvalidate(const u16* data, u32 count)
+    {
+        setData(data, count);
+        invalidateCache(data, count * sizeof(u16));
+    }
+
+    void setDataInvalidate(const u32* data, u32 count)
+    {
+        setData(data, count);
+        invalidateCache(data, count * sizeof(u32));
+    }
+
+    static void invalidateCache(const void* data, u32 size);
+
+#if RIO_IS_WIN
+    u32 getNativeHandle() const { return mHandle; }
+#endif // RIO_IS_WIN
+
+    // This object is bound by VertexArray
+
+private:
+    void setData_(const void* data, u32 count, Format format);
+
+private:
+#if RIO_IS_WIN
+    u32                 mHandle;    // Buffer handle (for OpenGL)
+#endif // RIO_IS_WIN
+    const void*         mpData;     // Buffer data
+    u32                 mCount;     // Indices count
+    Format              mFormat;    // Index format
+
+    friend class VertexArray;
+};
+
+#if RIO_IS_WIN
+
+inline void IndexBuffer::invalidateCache(const void* data, u32 size)
+{
+}
+
+#endif // RIO_IS_WIN
+
+}
+
+#endif // RIO_GPU_INDEX_BUFFER_H
@@ -10,6 +10,10 @@ typedef struct GX2PixelShader GX2PixelShader;
 
 namespace rio {
 
+#if RIO_IS_WIN
+class FileDevice;
+#endif // RIO_IS_WIN
+
 class Shader
 {
 public:
@@ -44,6 +48,12 @@ public:
     // The expected shader mode is used on Cafe to verify that the loaded shader matches that shader mode.
     void load(const char* base_fname, ShaderMode exp_mode = MODE_INVALID);
 
+    // Same as load(), but without waiting for the shaders to be compiled and linked.
+    // On PC, with GL_KHR_parallel_shader_compile, the driver compiles them on its own threads, so that
+    // the compilation of many shaders overlaps. Until isReady() returns true, using the shader (binding it,
+    // getting locations...) waits for the compilation to complete. (On Cafe, this is the same as load().)
+    void loadAsync(const char* base_fname, ShaderMode exp_mode = MODE_INVALID);
+
 #if RIO_IS_CAFE
 
     // Wrap pre-existing GX2VertexShader and GX2PixelShader instances
@@ -53,6 +63,15 @@ public:
 
     // Load shader resource by source strings.
     void load(const char* c_vertex_shader_src, const char* c_fragment_shader_src);
+    void loadAsync(const char* c_vertex_shader_src, const char* c_fragment_shader_src);
+
+    // Store the binaries of the linked programs in the given directory of the given file device,
+    // so that later loads of the same sources with the same driver skip compiling and linking.
+    // (Binaries rejected by the driver are replaced by compiling the sources again.)
+    // Parameters:
+    // - device: File device to store the binaries through (nullptr to disable the cache, which is the default)
+    // - dir_path: Directory of the binaries on the file device (must exist)
+    static void setProgramBinaryCache(FileDevice* device, const char* dir_path = "");
 
 #endif
 
@@ -62,6 +81,10 @@ public:
     // Check if the shader resource has been loaded.
     bool isLoaded() const { return mLoaded; }
 
+    // Check if the shader resource has been loaded and its compilation is complete, without blocking
+    // (On PC, without GL_KHR_parallel_shader_compile, this waits for the compilation instead.)
+    bool isReady() const;
+
 #if RIO_IS_CAFE
 
     // Get the GX2 Vertex Shader pointer.
@@ -278,6 +301,17 @@ public:
 
 private:
     void initialize_();
+#if RIO_IS_WIN
+    // Wait for the compilation started by loadAsync() and finish loading, if not done yet
+    void waitReady_() const
+    {
+        if (mPendingVertexShader != 0)
+            finishLoad_();
+    }
+
+    // Check the compilation, release the shaders and set up the linked program (uniform block bindings)
+    void finishLoad_() const;
+#endif // RIO_IS_WIN
 
 private:
     bool                mLoaded;
@@ -289,6 +323,9 @@ private:
     static ShaderMode   sCurrentShaderMode;
 #elif RIO_IS_WIN
     u32                 mShaderProgram;
+    mutable u32         mPendingVertexShader;   // Shaders being compiled after loadAsync() (0 once ready)
+    mutable u32         mPendingFragmentShader;
+    mutable u64         mPendingBinaryKey;      // Program binary cache key, if the binary should be saved once ready
 #endif
 };
 
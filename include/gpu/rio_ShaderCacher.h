@@ -0,0 +1,91 @@
+#ifndef RIO_GPU_SHADER_CACHER_H
+#define RIO_GPU_SHADER_CACHER_H
+
+#include <gpu/rio_Shader.h>
+
+#include <string>
+#include <unordered_map>
+
+namespace rio {
+
+class ShaderCacher
+{
+    // Shader cache manager class
+    // Shaders are shared by shader filename and shader mode, and reference-counted,
+    // so that each shader is only loaded (and, on PC, compiled and linked) once.
+
+public:
+    static bool createSingleton();
+    static void destroySingleton();
+    static ShaderCacher* instance() { return sInstance; }
+
+private:
+    static ShaderCacher* sInstance;
+
+    ShaderCacher();
+    ~ShaderCacher();
+
+    ShaderCacher(const ShaderCacher&);
+    ShaderCacher& operator=(const ShaderCacher&);
+
+public:
+    // Get the shader loaded from the given filename with the given shader mode (see Shader::load()),
+    // loading it if it is not in the cache, and increment its reference count.
+    // Every call must be paired with a call to releaseShader().
+    Shader* loadShader(const char* base_fname, Shader::ShaderMode mode = Shader::MODE_INVALID)
+    {
+        return loadShader_(base_fname, mode, false);
+    }
+
+    // Same as loadShader(), but a shader which is not in the cache is loaded with Shader::loadAsync()
+    // (see Shader::isReady())
+    Shader* loadShaderAsync(const char* base_fname, Shader::ShaderMode mode = Shader::MODE_INVALID)
+    {
+        return loadShader_(base_fname, mode, true);
+    }
+
+    // Decrement the reference count of a shader obtained with loadShader(),
+    // and unload it once it reaches zero.
+    void releaseShader(const char* base_fname, Shader::ShaderMode mode = Shader::MODE_INVALID);
+
+    // Get a cached shader, without changing its reference count (nullptr if not in the cache)
+    Shader* get(const char* base_fname, Shader::ShaderMode mode = Shader::MODE_INVALID) const;
+
+    // Get the number of shaders in the cache
+    u32 getShaderNum() const { return mShaderCache.size(); }
+
+private:
+    Shader* loadShader_(const char* base_fname, Shader::ShaderMode mode, bool async);
+
+private:
+    struct Key
+    {
+        std::string         name;
+        Shader::ShaderMode  mode;
+
+        bool operator==(const Key& rhs) const
+        {
+            return mode == rhs.mode && name == rhs.name;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return std::hash<std::string>()(key.name) ^ size_t(key.mode);
+        }
+    };
+
+    struct Entry
+    {
+        Shader* shader;
+        u32     ref_count;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> mShaderCache;
+};
+
+}
+
+#endif // RIO_GPU_SHADER_CACHER_H
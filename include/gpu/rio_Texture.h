@@ -6,6 +6,7 @@
 #if RIO_IS_CAFE
 #include <gx2/texture.h>
 #elif RIO_IS_WIN
+#include <filedevice/rio_FileDevice.h>
 #include <misc/gl/rio_GL.h>
 #endif
 
@@ -180,12 +181,22 @@ class TextureSampler2D;
 class Texture2D
 {
 public:
-    Texture2D(const char* base_fname);
-
-    Texture2D(const u8* file, u32 file_size)
+    // Load texture by filename or from file data
+    // Parameters:
+    // - keep_image_data: On PC, keep a copy of the image and mipmaps data in memory once they are uploaded to the GPU.
+    //                    Otherwise, the texture is uploaded straight from the file data, and the surface of the native
+    //                    texture has no image and mipmaps pointers. (Ignored on Cafe, where the GPU reads the data from memory.)
+    // - async_upload: On PC, if the TextureUploader singleton exists, upload the data over the next frames instead of
+    //                 right away (see isReady()). (Ignored on Cafe.)
+    // - async_load: On PC, load the file on the I/O threads of FileDeviceMgr (see AsyncLoader), the texture being created
+    //               on the main thread once the file is delivered. Until then, the texture has no handle or size, and
+    //               isReady() returns false, so it must only be linked to samplers once ready. (Ignored on Cafe.)
+    Texture2D(const char* base_fname, bool keep_image_data = true, bool async_upload = false, bool async_load = false);
+
+    Texture2D(const u8* file, u32 file_size, bool keep_image_data = true)
         : mSelfAllocated(true)
     {
-        load_(file, file_size);
+        load_(file, file_size, keep_image_data);
     }
 
     Texture2D(NativeTexture2D& native_texture)
@@ -215,14 +226,34 @@ public:
     const NativeTexture2D& getNativeTexture() const { return mTextureInner; }
     NativeTexture2DHandle getNativeTextureHandle() const { return mHandle; }
 
+    // Check if the data of this texture is loaded and uploaded, without blocking
+    // (Always true unless the texture was created with async_upload or async_load.)
+    bool isReady() const;
+
+    // Check if the file of a texture created with async_load failed to load, in which case it never
+    // becomes ready, and has no handle
+    bool isLoadFailed() const;
+
 private:
-    void load_(const u8* file, u32 file_size);
+    void load_(const u8* file, u32 file_size, bool keep_image_data);
     void createHandle_();
+#if RIO_IS_WIN
+    // Takes ownership of the file
+    void loadAsync_(u8* file, u32 file_size, bool file_is_mapped, bool keep_image_data);
+    // Create the texture from the file loaded by the constructor with async_load
+    static void onFileLoaded_(u32 handle, const FileDevice::LoadArg& arg, u8* data, void* user_data);
+#endif // RIO_IS_WIN
 
 private:
     NativeTexture2D         mTextureInner;  // Native texture.
     NativeTexture2DHandle   mHandle;        // Native texture handle.
     bool                    mSelfAllocated; // Is native texture allocated by this instance?
+#if RIO_IS_WIN
+    u32                     mLoadHandle = 0;            // AsyncLoader handle of the file being loaded (0: none)
+    bool                    mKeepImageData = true;      // (Arguments of the constructor, for the file being loaded)
+    bool                    mAsyncUpload = false;
+    bool                    mLoadFailed = false;
+#endif // RIO_IS_WIN
 };
 
 }
@@ -0,0 +1,87 @@
+#ifndef RIO_GPU_TEXTURE_CACHER_H
+#define RIO_GPU_TEXTURE_CACHER_H
+
+#include <gpu/rio_Texture.h>
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace rio {
+
+class TextureCacher
+{
+    // Texture cache manager class
+    // Textures are shared by filename and reference-counted.
+    // Textures which are no longer referenced are kept in the cache for reuse, as long as the GPU memory
+    // used by all cached textures fits in the budget. Past that, the least recently used of them are destroyed.
+
+public:
+    static bool createSingleton();
+    static void destroySingleton();
+    static TextureCacher* instance() { return sInstance; }
+
+private:
+    static TextureCacher* sInstance;
+
+    TextureCacher();
+    ~TextureCacher();
+
+    TextureCacher(const TextureCacher&);
+    TextureCacher& operator=(const TextureCacher&);
+
+public:
+    // Get the texture loaded from the given filename (see Texture2D),
+    // loading it if it is not in the cache, and increment its reference count.
+    // Every call must be paired with a call to releaseTexture().
+    Texture2D* loadTexture(const char* base_fname);
+
+    // Decrement the reference count of a texture obtained with loadTexture().
+    // Once it reaches zero, the texture stays in the cache until evicted.
+    void releaseTexture(const char* base_fname);
+
+    // Get a cached texture, without changing its reference count (nullptr if not in the cache)
+    Texture2D* get(const char* base_fname) const;
+
+    // Set the GPU memory budget of the cache, in bytes, evicting unreferenced textures as needed
+    // (Default: 0, i.e. textures are destroyed as soon as they are no longer referenced)
+    void setBudget(size_t budget);
+    size_t getBudget() const { return mBudget; }
+
+    // Destroy all unreferenced textures
+    void evictUnreferenced();
+
+    // Get the GPU memory used by all cached textures, in bytes
+    size_t getSize() const { return mSize; }
+
+    // Get the number of textures in the cache, including unreferenced ones
+    u32 getTextureNum() const { return mTextureCache.size(); }
+
+    // Get the number of textures evicted since the creation of the cache
+    u32 getEvictedNum() const { return mEvictedNum; }
+
+private:
+    // Evict the least recently used unreferenced textures until the cache fits in the budget
+    void evict_(size_t budget);
+
+private:
+    typedef std::list<std::string> LRUList;
+
+    struct Entry
+    {
+        Texture2D*          texture;
+        u32                 size;       // GPU memory size
+        u32                 ref_count;
+        LRUList::iterator   lru_it;     // Position in mLRUList (if unreferenced)
+    };
+
+    std::unordered_map<std::string, Entry>  mTextureCache;
+    LRUList                                 mLRUList;       // Unreferenced textures, most recently used first
+    size_t                                  mBudget;
+    size_t                                  mSize;
+    u32                                     mEvictedNum;
+};
+
+}
+
+#endif // RIO_GPU_TEXTURE_CACHER_H
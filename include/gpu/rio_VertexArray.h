@@ -1,6 +1,7 @@
 #ifndef RIO_GPU_VERTEX_ARRAY_H
 #define RIO_GPU_VERTEX_ARRAY_H
 
+#include <gpu/rio_IndexBuffer.h>
 #include <gpu/rio_VertexBuffer.h>
 
 #include <cstring>
@@ -11,11 +12,13 @@ class VertexArray
 {
 public:
     VertexArray()
+        : mpIndexBuffer(nullptr)
 #if RIO_IS_CAFE
-        : mpFetchShaderBuf(nullptr)
+        , mpFetchShaderBuf(nullptr)
         , mFetchShaderBufSize(0)
 #elif RIO_IS_WIN
-        : mHandle(0)
+        , mHandle(0)
+        , mWorkerKey(0)
 #endif
     {
         // Clear vertex buffers list
@@ -42,6 +45,27 @@ public:
         mpVertexBuffer[vertex_buffer.mBuffer] = &vertex_buffer;
     }
 
+    // Use a vertex buffer whose streams were already added with addAttribute() (e.g. by another
+    // vertex array), with all of its streams
+    // (A stream can only be added to one buffer once, so this is how vertex arrays share streams.)
+    void addVertexBuffer(VertexBuffer& vertex_buffer)
+    {
+        RIO_ASSERT(!vertex_buffer.mStreams.isEmpty());
+        mpVertexBuffer[vertex_buffer.mBuffer] = &vertex_buffer;
+    }
+
+    // Set the index buffer to use with this vertex array (nullptr for none)
+    // On PC, it is bound along with the vertex array, once process() has been called
+    void setIndexBuffer(const IndexBuffer* index_buffer)
+    {
+        mpIndexBuffer = index_buffer;
+    }
+
+    const IndexBuffer* getIndexBuffer() const
+    {
+        return mpIndexBuffer;
+    }
+
     // Process all added vertex attribute streams
     void process();
 
@@ -52,12 +76,19 @@ public:
 
 private:
     VertexBuffer*   mpVertexBuffer[VertexBuffer::NUM_MAX_BUFFERS];  // Vertex buffers
+    const IndexBuffer*
+                    mpIndexBuffer;                                  // Index buffer
 #if RIO_IS_CAFE
     u8              mFetchShader[0x20];                             // GX2FetchShader
     u8*             mpFetchShaderBuf;                               // Fetch shader buffer
     u32             mFetchShaderBufSize;                            // Fetch shader buffer size
 #elif RIO_IS_WIN
+    void setupAttributes_() const;
+    // Let render workers delete their vertex arrays for the current key
+    void releaseWorkerKey_();
+
     u32             mHandle;                                        // OpenGL handle
+    u32             mWorkerKey;                                     // Key of the vertex arrays created by render workers (changes on process())
 #endif
 };
 
@@ -40,6 +40,7 @@ public:
     const void* getData() const { return mpData; }
     u32 getSize() const { return mSize; }
     u32 getStride() const { return mStride; }
+    u32 getInstanceStepRate() const { return mInstanceStepRate; }
 
     void setStride(u32 stride)
     {
@@ -47,6 +48,14 @@ public:
         mStride = stride;
     }
 
+    // Set the number of instances drawn before advancing to the next element of this buffer
+    // (0 = advance per vertex, which is the default)
+    // Must be set before the vertex array using this buffer is processed
+    void setInstanceStepRate(u32 rate)
+    {
+        mInstanceStepRate = rate;
+    }
+
     // Sets the passed data pointer as this object's data buffer.
     void setData(const void* data, u32 size);
     // Copies the passed data into the specified range.
@@ -68,6 +77,7 @@ private:
     const void*         mpData;     // Buffer data
     u32                 mSize;      // Buffer size
     u32                 mStride;    // Vertex Stride
+    u32                 mInstanceStepRate;  // Instance step rate (0 = per vertex)
     VertexStream::List  mStreams;   // List of streams contained in this buffer
                                     // (Managed by VertexArray)
 
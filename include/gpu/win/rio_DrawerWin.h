@@ -4,6 +4,7 @@
 // This file is included by rio_Drawer.h
 //#include <gpu/rio_Drawer.h>
 
+#include <gpu/rio_IndexBuffer.h>
 #include <misc/gl/rio_GL.h>
 
 namespace rio {
@@ -42,6 +43,17 @@ inline void Drawer::DrawElementsInstanced(PrimitiveMode mode, u32 count, const u
 
     RIO_GL_CALL(glDrawElementsInstanced(mode, count, GL_UNSIGNED_SHORT, indices, instanceCount));
 }
+
+inline void Drawer::DrawElementsInstanced(PrimitiveMode mode, const IndexBuffer& index_buffer, u32 count, u32 instanceCount, u32 first)
+{
+    RIO_ASSERT(first + count <= index_buffer.getCount());
+    RIO_GL_CALL(glDrawElementsInstanced(
+        mode, count,
+        index_buffer.getFormat() == IndexBuffer::FORMAT_U32 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT,
+        (void*)(uintptr_t)(first * index_buffer.getIndexSize()),
+        instanceCount
+    ));
+}
 #endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
 
 inline void Drawer::DrawArrays(PrimitiveMode mode, u32 count, u32 first)
@@ -81,6 +93,21 @@ inline void Drawer::DrawElements(PrimitiveMode mode, u32 count, const u16* indic
 #endif
 }
 
+inline void Drawer::DrawElements(PrimitiveMode mode, const IndexBuffer& index_buffer, u32 count, u32 first)
+{
+    RIO_ASSERT(first + count <= index_buffer.getCount());
+    RIO_GL_CALL(glDrawElements(
+        mode, count,
+        index_buffer.getFormat() == IndexBuffer::FORMAT_U32 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT,
+        (void*)(uintptr_t)(first * index_buffer.getIndexSize())
+    ));
+}
+
+inline void Drawer::DrawElements(PrimitiveMode mode, const IndexBuffer& index_buffer)
+{
+    DrawElements(mode, index_buffer, index_buffer.getCount());
+}
+
 }
 
 #endif // RIO_GPU_DRAWER_WIN_H
@@ -0,0 +1,108 @@
+#ifndef RIO_GPU_GL_STATE_CACHE_WIN_H
+#define RIO_GPU_GL_STATE_CACHE_WIN_H
+
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+
+#include <gfx/rio_Color.h>
+#include <gfx/rio_Graphics.h>
+
+namespace rio {
+
+// Shadow copy of the GL state set through RIO, used to skip the GL calls which would not change anything.
+// The state is tracked per thread, as each render worker thread has its own context.
+// Code changing any of the states below without going through this class must call invalidate() afterwards.
+class GLStateCache
+{
+public:
+    // Texture unit used by RIO to bind textures for modification (e.g. Texture2DUtil::bind())
+    static constexpr u32 cScratchTextureUnit    = 16;
+    static constexpr u32 cTextureUnitNum        = cScratchTextureUnit + 1;
+
+public:
+    // Forget all tracked states (the next call of each setter will be issued)
+    static void invalidate();
+
+    static void setDepthTestEnable(bool enable);
+    static void setDepthMask(bool enable);
+    static void setDepthFunc(Graphics::CompareFunc func);
+
+    static void setStencilTestEnable(bool enable);
+    static void setStencilFunc(Graphics::CompareFunc func, s32 ref, u32 mask);
+    static void setStencilOp(Graphics::StencilOp fail, Graphics::StencilOp zfail, Graphics::StencilOp zpass);
+    // Stencil write mask (stencil buffers are 8-bit)
+    static void setStencilMask(u32 mask);
+
+    static void setCullingMode(Graphics::CullingMode mode);
+
+#ifndef RIO_GLES
+    static void setPolygonMode(Graphics::PolygonMode mode);
+    static void setPolygonOffsetEnable(bool fill_enable, bool point_line_enable);
+#endif // RIO_GLES
+
+    // Blending and color mask, for all render targets
+    static void setBlendEnable(bool enable);
+    static void setBlendFactor(Graphics::BlendFactor src_rgb, Graphics::BlendFactor dst_rgb, Graphics::BlendFactor src_a, Graphics::BlendFactor dst_a);
+    static void setBlendEquation(Graphics::BlendEquation rgb, Graphics::BlendEquation a);
+    static void setColorMask(bool r, bool g, bool b, bool a);
+
+#ifndef RIO_GLES
+    // Blending and color mask, for a single render target
+    static void setBlendEnable(u32 target, bool enable);
+    static void setBlendFactor(u32 target, Graphics::BlendFactor src_rgb, Graphics::BlendFactor dst_rgb, Graphics::BlendFactor src_a, Graphics::BlendFactor dst_a);
+    static void setBlendEquation(u32 target, Graphics::BlendEquation rgb, Graphics::BlendEquation a);
+    static void setColorMask(u32 target, bool r, bool g, bool b, bool a);
+#endif // RIO_GLES
+
+    static void setBlendConstantColor(const Color4f& color);
+
+    static void setSampleAlphaToCoverageEnable(bool enable);
+
+    // Object bindings
+    static void useProgram(u32 handle);
+    static void bindVertexArray(u32 handle);
+    static void bindTexture2D(u32 unit, u32 handle);
+    static void bindSampler(u32 unit, u32 handle);
+
+    // Bind a texture to cScratchTextureUnit and make that unit active,
+    // for GL functions operating on the currently bound texture
+    static void bindTexture2DScratch(u32 handle);
+
+    // Must be called when deleting objects, as GL unbinds them
+    // (Texture and program deletions also make the caches of the other threads forget
+    // their texture and program bindings, as the names can be reused by any shared context.)
+    static void onTextureDeleted(u32 handle);
+    static void onSamplerDeleted(u32 handle);
+    static void onVertexArrayDeleted(u32 handle);
+    static void onProgramDeleted(u32 handle);
+
+public:
+    // Number of GL calls issued on the calling thread during the last frame
+    // (GL calls are only counted in debug builds or with RIO_GL_STATS defined, otherwise this is 0.)
+    static u32 getFrameCallNum();
+    // Number of GL calls skipped by this cache on the calling thread during the last frame
+    static u32 getFrameSkippedCallNum();
+
+    // Number of GL calls issued and skipped on the calling thread since the last frame
+    static u32 getCallNum();
+    static u32 getSkippedCallNum();
+
+    // End the frame of the calling thread (called by Window::swapBuffers())
+    static void endFrame();
+
+private:
+    static void activeTexture_(u32 unit);
+    static void syncDeletions_();
+    static void onDeletion_();
+
+private:
+    struct State;
+    static thread_local State sState;
+};
+
+}
+
+#endif // RIO_IS_WIN
+
+#endif // RIO_GPU_GL_STATE_CACHE_WIN_H
@@ -164,6 +164,55 @@ public:
         return handle;
     }
 
+    // Check if textures can be allocated with immutable storage (glTexStorage2D)
+    static bool isStorageSupported();
+
+    // Allocate the storage of all mip levels of the current texture, without uploading any data
+    static void allocateStorageCurrent(
+        TextureFormat format,
+        const NativeTextureFormat& nativeFormat,
+        u32 width,
+        u32 height,
+        u32 mipLevels
+    );
+
+    // Upload the data of rows of a mip level of the current texture, whose storage is allocated
+    // (data is an offset if a pixel unpack buffer is bound)
+    static void uploadLevelCurrent(
+        TextureFormat format,
+        const NativeTextureFormat& nativeFormat,
+        u32 level,
+        u32 y,
+        u32 width,
+        u32 height,
+        u32 size,
+        const void* data
+    );
+
+    // Create a texture and allocate its storage, for its data to be uploaded afterwards (e.g. by TextureUploader)
+    static u32 createHandleStorage(
+        TextureFormat format,
+        const NativeTextureFormat& nativeFormat,
+        u32 width,
+        u32 height,
+        u32 mipLevels,
+        u32 compMap
+    )
+    {
+        u32 handle = createHandle();
+        bind(handle);
+        setSwizzleCurrent(compMap);
+        setNumMipsCurrent(mipLevels);
+        allocateStorageCurrent(
+            format,
+            nativeFormat,
+            width,
+            height,
+            mipLevels
+        );
+        return handle;
+    }
+
     static u32 createHandle(
         TextureFormat format,
         const NativeTextureFormat& nativeFormat,
@@ -0,0 +1,172 @@
+#ifndef RIO_GPU_TEXTURE_UPLOADER_WIN_H
+#define RIO_GPU_TEXTURE_UPLOADER_WIN_H
+
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+
+#include <gpu/rio_Texture.h>
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+namespace rio {
+
+// Uploads texture data to the GPU over multiple frames, through a ring of pixel unpack buffers.
+// Textures are created with immutable storage, and the data of their mip levels is copied in chunks
+// of rows to a staging buffer, from which the GPU then copies it to the texture. A staging buffer is
+// only reused once a fence tells the GPU is done with it, so the CPU never waits for the GPU.
+// Uploads are processed by update(), which is called by Window::swapBuffers().
+// Notes:
+// - Upload requests can be queued from any thread, but texture handles must be created and
+//   destroyed on the thread of the window's context, like all other functions.
+// - The contents of a texture are undefined until its upload is done (see isPending()).
+class TextureUploader
+{
+public:
+    static const u32 cDefaultStagingBufferSize  = 4 * 1024 * 1024;
+    static const u32 cDefaultStagingBufferNum   = 3;
+
+    struct Request
+    {
+        Request()
+            : handle(GL_NONE)
+            , format(TEXTURE_FORMAT_INVALID)
+            , nativeFormat()
+            , width(0)
+            , height(0)
+            , mipLevels(1)
+            , imageSize(0)
+            , image(nullptr)
+            , mipmapSize(0)
+            , mipmaps(nullptr)
+            , mipLevelOffset()
+            , file(nullptr)
+            , file_size(0)
+            , file_is_mapped(false)
+        {
+        }
+
+        u32                 handle;             // Texture handle, with its storage allocated (see Texture2DUtil::createHandleStorage())
+        TextureFormat       format;
+        NativeTextureFormat nativeFormat;
+        u32                 width;
+        u32                 height;
+        u32                 mipLevels;
+        u32                 imageSize;
+        const void*         image;
+        u32                 mipmapSize;
+        const void*         mipmaps;
+        u32                 mipLevelOffset[13];
+        u8*                 file;               // File holding the data, released by the uploader once it is uploaded (optional)
+        u32                 file_size;          // (LoadArg::read_size)
+        bool                file_is_mapped;     // (LoadArg::is_mapped)
+    };
+
+public:
+    // Create texture uploader singleton instance
+    // Must be called from the main thread, after the window has been created
+    // Parameters:
+    // - staging_buffer_size: Size of each staging buffer, which is the maximum size of a chunk
+    // - staging_buffer_num: Number of staging buffers in the ring
+    static bool createSingleton(u32 staging_buffer_size = cDefaultStagingBufferSize, u32 staging_buffer_num = cDefaultStagingBufferNum);
+
+    // Destroy texture uploader singleton instance (the pending uploads are dropped)
+    static void destroySingleton();
+
+    // Get texture uploader singleton instance
+    static TextureUploader* instance() { return sInstance; }
+
+    // Check if uploads can be made through this class (immutable storage and fences are supported)
+    static bool isSupported();
+
+private:
+    static TextureUploader* sInstance;
+
+    TextureUploader();
+    ~TextureUploader();
+
+    TextureUploader(const TextureUploader&);
+    TextureUploader& operator=(const TextureUploader&);
+
+public:
+    // Queue the upload of the data of a texture (thread-safe)
+    // The data must stay valid until the upload is done or canceled.
+    void queue(const Request& request);
+
+    // Drop the pending upload of a texture, releasing its file (called by Texture2DUtil::destroyHandle())
+    void cancel(u32 handle);
+
+    // Check if the upload of a texture is queued or in progress (thread-safe)
+    bool isPending(u32 handle) const;
+
+    // Get the number of textures whose upload is queued or in progress (thread-safe)
+    u32 getPendingNum() const;
+
+    // Upload the data of the pending textures, within the frame budget and free staging space
+    void update();
+
+    // Upload the data of all pending textures now
+    void flush();
+
+    // Maximum number of bytes uploaded by each call of update(), at least one row being uploaded
+    // (0 for no limit other than the free staging space; the default is the size of a staging buffer)
+    void setFrameBudget(u32 size) { mFrameBudget = size; }
+    u32 getFrameBudget() const { return mFrameBudget; }
+
+    // Number of bytes uploaded by the last call of update()
+    u32 getFrameUploadedSize() const { return mFrameUploadedSize; }
+    // Number of textures whose upload is done since creation
+    u32 getUploadedNum() const { return mUploadedNum; }
+
+private:
+    struct Job
+    {
+        Request request;
+        u32     level;      // Next mip level to upload
+        u32     row;        // Next row of the level to upload (in blocks for compressed formats)
+    };
+
+    struct StagingBuffer
+    {
+        u32     handle;
+        GLsync  fence;      // Signaled once the GPU is done reading this buffer
+    };
+
+    bool initialize_(u32 staging_buffer_size, u32 staging_buffer_num);
+    void terminate_();
+
+    void update_(u32 budget);
+
+    // Upload rows of a mip level of a texture, returns false if there is no free staging space
+    bool uploadChunk_(const Request& request, u32 level, u32 y, u32 width, u32 height, u32 size, const void* data);
+    // Fence the current staging buffer and move to the next one
+    void endStagingBuffer_();
+    // Wait for the GPU to be done with all staging buffers
+    void waitStagingBuffers_();
+
+    static void releaseFile_(const Request& request);
+
+private:
+    mutable std::mutex          mMutex;
+    std::deque<Job>             mQueuedJobs;    // Jobs queued since the last update (protected by mMutex)
+    std::deque<Job>             mJobs;          // Jobs being processed (protected by mMutex)
+    std::vector<StagingBuffer>  mStagingBuffer;
+    u32                         mStagingBufferSize;
+    u32                         mStagingBufferIndex;
+    u32                         mStagingBufferOffset;
+    u32                         mFrameBudget;
+    u32                         mFrameUploadedSize;
+    u32                         mUploadedNum;
+};
+
+}
+
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+#endif // RIO_IS_WIN
+
+#endif // RIO_GPU_TEXTURE_UPLOADER_WIN_H
@@ -245,6 +245,14 @@ Matrix34<T>::setMul(const Self& a, const Self& b)
     this->m[2][3] = a31 * b14 + a32 * b24 + a33 * b34 + a34;
 }
 
+#if RIO_MATH_SIMD
+
+template <>
+void
+Matrix34<f32>::setMul(const Matrix34f& a, const Matrix34f& b);
+
+#endif // RIO_MATH_SIMD
+
 template <typename T>
 inline void
 Matrix34<T>::setTranspose(const Self& n)
@@ -1031,6 +1039,14 @@ Matrix44<T>::setMul(const Self& a, const Mtx34& b)
     this->m[3][3] = a41 * b14 + a42 * b24 + a43 * b34 + a44;
 }
 
+#if RIO_MATH_SIMD
+
+template <>
+void
+Matrix44<f32>::setMul(const Matrix44f& a, const BaseMtx34f& b);
+
+#endif // RIO_MATH_SIMD
+
 template <typename T>
 inline void
 Matrix44<T>::setTranspose(const Self& n)
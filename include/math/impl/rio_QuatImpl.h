@@ -105,6 +105,29 @@ Quat<T>::operator*(const Self& q) const
     return o;
 }
 
+template <typename T>
+inline void
+Quat<T>::setMul(const Self& a, const Self& b)
+{
+    const T w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+    const T x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+    const T y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+    const T z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+
+    this->w = w;
+    this->x = x;
+    this->y = y;
+    this->z = z;
+}
+
+#if RIO_MATH_SIMD
+
+template <>
+void
+Quat<f32>::setMul(const Quatf& a, const Quatf& b);
+
+#endif // RIO_MATH_SIMD
+
 template <typename T>
 inline Quat<T>
 Quat<T>::operator*(T s) const
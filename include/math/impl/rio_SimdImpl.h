@@ -0,0 +1,84 @@
+#ifndef RIO_MATH_SIMD_IMPL_H
+#define RIO_MATH_SIMD_IMPL_H
+
+// Thin wrappers over the SSE and NEON intrinsics used by the SIMD math implementations on PC.
+// Only included by the math implementation sources.
+
+#include <math/rio_MathTypes.h>
+
+#if RIO_MATH_SIMD_SSE
+    #include <xmmintrin.h>
+#elif RIO_MATH_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+#if RIO_MATH_SIMD
+
+namespace rio { namespace simd {
+
+#if RIO_MATH_SIMD_SSE
+
+typedef __m128 F32x4;
+
+RIO_FORCE_INLINE F32x4 Load(const f32* p)               { return _mm_loadu_ps(p); }
+RIO_FORCE_INLINE void  Store(f32* p, F32x4 v)           { _mm_storeu_ps(p, v); }
+RIO_FORCE_INLINE F32x4 Splat(f32 s)                     { return _mm_set1_ps(s); }
+RIO_FORCE_INLINE F32x4 Set(f32 x, f32 y, f32 z, f32 w)  { return _mm_setr_ps(x, y, z, w); }
+
+RIO_FORCE_INLINE F32x4 Add(F32x4 a, F32x4 b)            { return _mm_add_ps(a, b); }
+RIO_FORCE_INLINE F32x4 Sub(F32x4 a, F32x4 b)            { return _mm_sub_ps(a, b); }
+RIO_FORCE_INLINE F32x4 Mul(F32x4 a, F32x4 b)            { return _mm_mul_ps(a, b); }
+RIO_FORCE_INLINE F32x4 Neg(F32x4 v)                     { return _mm_xor_ps(v, _mm_set1_ps(-0.0f)); }
+
+// (x, y, z, w) -> (y, x, w, z)
+RIO_FORCE_INLINE F32x4 SwapPairs(F32x4 v)               { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+// (x, y, z, w) -> (z, w, x, y)
+RIO_FORCE_INLINE F32x4 SwapHalves(F32x4 v)              { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)); }
+
+RIO_FORCE_INLINE void Transpose(F32x4& r0, F32x4& r1, F32x4& r2, F32x4& r3)
+{
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+}
+
+#elif RIO_MATH_SIMD_NEON
+
+typedef float32x4_t F32x4;
+
+RIO_FORCE_INLINE F32x4 Load(const f32* p)               { return vld1q_f32(p); }
+RIO_FORCE_INLINE void  Store(f32* p, F32x4 v)           { vst1q_f32(p, v); }
+RIO_FORCE_INLINE F32x4 Splat(f32 s)                     { return vdupq_n_f32(s); }
+
+RIO_FORCE_INLINE F32x4 Set(f32 x, f32 y, f32 z, f32 w)
+{
+    const f32 v[4] = { x, y, z, w };
+    return vld1q_f32(v);
+}
+
+RIO_FORCE_INLINE F32x4 Add(F32x4 a, F32x4 b)            { return vaddq_f32(a, b); }
+RIO_FORCE_INLINE F32x4 Sub(F32x4 a, F32x4 b)            { return vsubq_f32(a, b); }
+RIO_FORCE_INLINE F32x4 Mul(F32x4 a, F32x4 b)            { return vmulq_f32(a, b); }
+RIO_FORCE_INLINE F32x4 Neg(F32x4 v)                     { return vnegq_f32(v); }
+
+// (x, y, z, w) -> (y, x, w, z)
+RIO_FORCE_INLINE F32x4 SwapPairs(F32x4 v)               { return vrev64q_f32(v); }
+// (x, y, z, w) -> (z, w, x, y)
+RIO_FORCE_INLINE F32x4 SwapHalves(F32x4 v)              { return vextq_f32(v, v, 2); }
+
+RIO_FORCE_INLINE void Transpose(F32x4& r0, F32x4& r1, F32x4& r2, F32x4& r3)
+{
+    const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+    const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+
+    r0 = vcombine_f32(vget_low_f32 (t01.val[0]), vget_low_f32 (t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32 (t01.val[1]), vget_low_f32 (t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+#endif
+
+} } // namespace rio::simd
+
+#endif // RIO_MATH_SIMD
+
+#endif // RIO_MATH_SIMD_IMPL_H
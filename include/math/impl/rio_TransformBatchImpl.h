@@ -0,0 +1,174 @@
+#ifndef RIO_MATH_TRANSFORM_BATCH_IMPL_H
+#define RIO_MATH_TRANSFORM_BATCH_IMPL_H
+
+// This file is already included in rio_TransformBatch.h
+//#include <math/rio_TransformBatch.h>
+
+#include <cmath>
+
+namespace rio {
+
+template <typename T>
+inline void
+TransformBatch<T>::mulElement_(const Mtx34SoA<T>& dst, const Mtx34& a, const Mtx34SoA<T>& b, u32 i)
+{
+    const T b11 = b.m[0][0][i];
+    const T b12 = b.m[0][1][i];
+    const T b13 = b.m[0][2][i];
+    const T b14 = b.m[0][3][i];
+
+    const T b21 = b.m[1][0][i];
+    const T b22 = b.m[1][1][i];
+    const T b23 = b.m[1][2][i];
+    const T b24 = b.m[1][3][i];
+
+    const T b31 = b.m[2][0][i];
+    const T b32 = b.m[2][1][i];
+    const T b33 = b.m[2][2][i];
+    const T b34 = b.m[2][3][i];
+
+    for (u32 r = 0; r < 3; r++)
+    {
+        dst.m[r][0][i] = a.m[r][0] * b11 + a.m[r][1] * b21 + a.m[r][2] * b31;
+        dst.m[r][1][i] = a.m[r][0] * b12 + a.m[r][1] * b22 + a.m[r][2] * b32;
+        dst.m[r][2][i] = a.m[r][0] * b13 + a.m[r][1] * b23 + a.m[r][2] * b33;
+        dst.m[r][3][i] = a.m[r][0] * b14 + a.m[r][1] * b24 + a.m[r][2] * b34 + a.m[r][3];
+    }
+}
+
+template <typename T>
+inline void
+TransformBatch<T>::mul(const Mtx34SoA<T>& dst, const Mtx34& a, const Mtx34SoA<T>& b, u32 num)
+{
+    for (u32 i = 0; i < num; i++)
+        mulElement_(dst, a, b, i);
+}
+
+#if RIO_MATH_SIMD
+
+template <>
+void
+TransformBatch<f32>::mul(const Mtx34SoA<f32>& dst, const Matrix34f& a, const Mtx34SoA<f32>& b, u32 num);
+
+#endif // RIO_MATH_SIMD
+
+template <typename T>
+inline void
+TransformBatch<T>::mul(Mtx34* dst, const Mtx34& a, const Mtx34* b, u32 num)
+{
+    for (u32 i = 0; i < num; i++)
+        dst[i].setMul(a, b[i]);
+}
+
+template <typename T>
+inline void
+TransformBatch<T>::makeSRTElement_(const Mtx34SoA<T>& dst, const Vec3SoA<T>& s, const T* sinV, const T* cosV, const Vec3SoA<T>& t, u32 i)
+{
+    // Same as Matrix34::makeSRT()
+    dst.m[0][0][i] = s.x[i] * (cosV[1] * cosV[2]);
+    dst.m[1][0][i] = s.x[i] * (cosV[1] * sinV[2]);
+    dst.m[2][0][i] = s.x[i] * -sinV[1];
+
+    dst.m[0][1][i] = s.y[i] * (sinV[0] * sinV[1] * cosV[2] - cosV[0] * sinV[2]);
+    dst.m[1][1][i] = s.y[i] * (sinV[0] * sinV[1] * sinV[2] + cosV[0] * cosV[2]);
+    dst.m[2][1][i] = s.y[i] * (sinV[0] * cosV[1]);
+
+    dst.m[0][2][i] = s.z[i] * (cosV[0] * cosV[2] * sinV[1] + sinV[0] * sinV[2]);
+    dst.m[1][2][i] = s.z[i] * (cosV[0] * sinV[2] * sinV[1] - sinV[0] * cosV[2]);
+    dst.m[2][2][i] = s.z[i] * (cosV[0] * cosV[1]);
+
+    dst.m[0][3][i] = t.x[i];
+    dst.m[1][3][i] = t.y[i];
+    dst.m[2][3][i] = t.z[i];
+}
+
+template <typename T>
+inline void
+TransformBatch<T>::makeSRT(const Mtx34SoA<T>& dst, const Vec3SoA<T>& s, const Vec3SoA<T>& r, const Vec3SoA<T>& t, u32 num)
+{
+    for (u32 i = 0; i < num; i++)
+    {
+        const T sinV[3] = { std::sin(r.x[i]),
+                            std::sin(r.y[i]),
+                            std::sin(r.z[i]) };
+
+        const T cosV[3] = { std::cos(r.x[i]),
+                            std::cos(r.y[i]),
+                            std::cos(r.z[i]) };
+
+        makeSRTElement_(dst, s, sinV, cosV, t, i);
+    }
+}
+
+#if RIO_MATH_SIMD
+
+template <>
+void
+TransformBatch<f32>::makeSRT(const Mtx34SoA<f32>& dst, const Vec3SoA<f32>& s, const Vec3SoA<f32>& r, const Vec3SoA<f32>& t, u32 num);
+
+#endif // RIO_MATH_SIMD
+
+template <typename T>
+inline void
+TransformBatch<T>::transformPointElement_(const Vec3SoA<T>& dst, const Mtx34& m, const Vec3SoA<T>& p, u32 i)
+{
+    const T x = p.x[i];
+    const T y = p.y[i];
+    const T z = p.z[i];
+
+    dst.x[i] = m.m[0][0] * x + m.m[0][1] * y + m.m[0][2] * z + m.m[0][3];
+    dst.y[i] = m.m[1][0] * x + m.m[1][1] * y + m.m[1][2] * z + m.m[1][3];
+    dst.z[i] = m.m[2][0] * x + m.m[2][1] * y + m.m[2][2] * z + m.m[2][3];
+}
+
+template <typename T>
+inline void
+TransformBatch<T>::transformPoints(const Vec3SoA<T>& dst, const Mtx34& m, const Vec3SoA<T>& p, u32 num)
+{
+    for (u32 i = 0; i < num; i++)
+        transformPointElement_(dst, m, p, i);
+}
+
+#if RIO_MATH_SIMD
+
+template <>
+void
+TransformBatch<f32>::transformPoints(const Vec3SoA<f32>& dst, const Matrix34f& m, const Vec3SoA<f32>& p, u32 num);
+
+#endif // RIO_MATH_SIMD
+
+template <typename T>
+inline void
+TransformBatch<T>::toSoA(const Mtx34SoA<T>& dst, const Mtx34* src, u32 num)
+{
+    for (u32 i = 0; i < num; i++)
+        dst.set(i, src[i]);
+}
+
+#if RIO_MATH_SIMD
+
+template <>
+void
+TransformBatch<f32>::toSoA(const Mtx34SoA<f32>& dst, const Matrix34f* src, u32 num);
+
+#endif // RIO_MATH_SIMD
+
+template <typename T>
+inline void
+TransformBatch<T>::fromSoA(Mtx34* dst, const Mtx34SoA<T>& src, u32 num)
+{
+    for (u32 i = 0; i < num; i++)
+        src.get(i, &dst[i]);
+}
+
+#if RIO_MATH_SIMD
+
+template <>
+void
+TransformBatch<f32>::fromSoA(Matrix34f* dst, const Mtx34SoA<f32>& src, u32 num);
+
+#endif // RIO_MATH_SIMD
+
+}
+
+#endif // RIO_MATH_TRANSFORM_BATCH_IMPL_H
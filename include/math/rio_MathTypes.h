@@ -3,6 +3,21 @@
 
 #include <misc/rio_Types.h>
 
+// SIMD implementations of the hot f32 operations on PC, selected at compile time
+// (define RIO_NO_MATH_SIMD to use the generic implementations instead)
+#if RIO_IS_WIN && !defined(RIO_NO_MATH_SIMD) && defined(__SSE2__)
+    #define RIO_MATH_SIMD_SSE   1
+    #define RIO_MATH_SIMD_NEON  0
+#elif RIO_IS_WIN && !defined(RIO_NO_MATH_SIMD) && defined(__ARM_NEON)
+    #define RIO_MATH_SIMD_SSE   0
+    #define RIO_MATH_SIMD_NEON  1
+#else
+    #define RIO_MATH_SIMD_SSE   0
+    #define RIO_MATH_SIMD_NEON  0
+#endif
+
+#define RIO_MATH_SIMD (RIO_MATH_SIMD_SSE || RIO_MATH_SIMD_NEON)
+
 namespace rio {
 
 template <typename T>
@@ -0,0 +1,111 @@
+#ifndef RIO_MATH_TRANSFORM_BATCH_H
+#define RIO_MATH_TRANSFORM_BATCH_H
+
+#include <math/rio_Matrix.h>
+
+namespace rio {
+
+// Batch of 3D vectors stored as a structure of arrays (one array per component)
+template <typename T>
+struct Vec3SoA
+{
+    T*  x;
+    T*  y;
+    T*  z;
+
+    // Make a batch whose components are stored one after the other in a buffer of 3 * capacity values
+    static Vec3SoA fromBuffer(T* buffer, u32 capacity)
+    {
+        return { buffer, buffer + capacity, buffer + capacity * 2 };
+    }
+
+    void set(u32 i, const BaseVec3<T>& v) const
+    {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+
+    void get(u32 i, BaseVec3<T>* v) const
+    {
+        v->x = x[i];
+        v->y = y[i];
+        v->z = z[i];
+    }
+};
+
+typedef Vec3SoA<f32> Vec3SoAf;
+
+// Batch of 3x4 matrices stored as a structure of arrays (one array per element)
+template <typename T>
+struct Mtx34SoA
+{
+    T*  m[3][4];
+
+    // Make a batch whose elements are stored one after the other in a buffer of 12 * capacity values
+    static Mtx34SoA fromBuffer(T* buffer, u32 capacity)
+    {
+        Mtx34SoA soa;
+        for (u32 i = 0; i < 3; i++)
+            for (u32 j = 0; j < 4; j++)
+                soa.m[i][j] = buffer + capacity * (i * 4 + j);
+
+        return soa;
+    }
+
+    void set(u32 idx, const BaseMtx34<T>& n) const
+    {
+        for (u32 i = 0; i < 3; i++)
+            for (u32 j = 0; j < 4; j++)
+                m[i][j][idx] = n.m[i][j];
+    }
+
+    void get(u32 idx, BaseMtx34<T>* n) const
+    {
+        for (u32 i = 0; i < 3; i++)
+            for (u32 j = 0; j < 4; j++)
+                n->m[i][j] = m[i][j][idx];
+    }
+};
+
+typedef Mtx34SoA<f32> Mtx34SoAf;
+
+// Transformations of batches of matrices and points
+// The structure of arrays batches let the SIMD implementations (see RIO_MATH_SIMD) process
+// several matrices per instruction. The results are the same as doing the same operations
+// one at a time with Matrix34.
+// The destination batch can be one of the source batches.
+template <typename T>
+class TransformBatch
+{
+public:
+    typedef Matrix34<T> Mtx34;
+
+    // dst[i] = a * b[i]
+    static void mul(const Mtx34SoA<T>& dst, const Mtx34& a, const Mtx34SoA<T>& b, u32 num);
+    // dst[i] = a * b[i], for matrices stored as an array
+    static void mul(Mtx34* dst, const Mtx34& a, const Mtx34* b, u32 num);
+
+    // dst[i].makeSRT(s[i], r[i], t[i])
+    static void makeSRT(const Mtx34SoA<T>& dst, const Vec3SoA<T>& s, const Vec3SoA<T>& r, const Vec3SoA<T>& t, u32 num);
+
+    // dst[i] = m * (p[i], 1)
+    static void transformPoints(const Vec3SoA<T>& dst, const Mtx34& m, const Vec3SoA<T>& p, u32 num);
+
+    // Conversion between arrays of matrices and batches
+    static void toSoA(const Mtx34SoA<T>& dst, const Mtx34* src, u32 num);
+    static void fromSoA(Mtx34* dst, const Mtx34SoA<T>& src, u32 num);
+
+private:
+    static void mulElement_(const Mtx34SoA<T>& dst, const Mtx34& a, const Mtx34SoA<T>& b, u32 i);
+    static void makeSRTElement_(const Mtx34SoA<T>& dst, const Vec3SoA<T>& s, const T* sinV, const T* cosV, const Vec3SoA<T>& t, u32 i);
+    static void transformPointElement_(const Vec3SoA<T>& dst, const Mtx34& m, const Vec3SoA<T>& p, u32 i);
+};
+
+typedef TransformBatch<f32> TransformBatchf;
+
+}
+
+#include <math/impl/rio_TransformBatchImpl.h>
+
+#endif // RIO_MATH_TRANSFORM_BATCH_H
@@ -25,7 +25,7 @@ inline void* MemUtil::set(void* ptr, u8 val, size_t size)
     return OSBlockSet(ptr, val, size);
 }
 
-inline void* MemUtil::alloc(size_t size, u32 alignment)
+inline void* MemUtil::alloc(size_t size, u32 alignment, HeapType)
 {
     RIO_ASSERT(size && alignment);
 
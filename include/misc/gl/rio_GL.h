@@ -23,6 +23,10 @@
     typedef void GLFWwindow;
 #endif
 
+#if defined(RIO_USE_EGL) && !defined(GLAD_EGL_H_) // (The GLES2 loader implementation includes it already)
+    #include <glad/egl.h>
+#endif
+
 // define functions that do not exist on OpenGL ES
 #ifdef RIO_GLES
     #define glDepthRange glDepthRangef
@@ -36,6 +40,29 @@
     #endif
 #endif // RIO_GLES
 
+// GL calls are counted in debug builds, or when RIO_GL_STATS is defined
+#if defined(RIO_DEBUG) && !defined(RIO_GL_STATS)
+    #define RIO_GL_STATS
+#endif // RIO_DEBUG
+
+#ifdef RIO_GL_STATS
+
+namespace rio {
+
+// Number of GL calls made with RIO_GL_CALL on the calling thread since the last frame
+// (See GLStateCache for per-frame statistics)
+inline thread_local u32 gGLCallNum = 0;
+
+}
+
+#define RIO_GL_COUNT_CALL() rio::gGLCallNum++
+
+#else
+
+#define RIO_GL_COUNT_CALL()
+
+#endif // RIO_GL_STATS
+
 #ifdef RIO_DEBUG
 
 inline void GLClearError(const char* file, s32 line)
@@ -99,6 +126,7 @@ inline void GLCheckError(const char* file, s32 line, const char* arg = nullptr)
     {                                           \
         GLClearError(__FILE__, __LINE__);       \
         RIO_GL_TRACE_LOG(ARG);                  \
+        RIO_GL_COUNT_CALL();                    \
         ARG;                                    \
         GLCheckError(__FILE__, __LINE__, #ARG); \
     } while (0)
@@ -106,7 +134,12 @@ inline void GLCheckError(const char* file, s32 line, const char* arg = nullptr)
 #else
 
 #define RIO_GL_CHECK_ERROR()
-#define RIO_GL_CALL(ARG) ARG
+#define RIO_GL_CALL(ARG)                        \
+    do                                          \
+    {                                           \
+        RIO_GL_COUNT_CALL();                    \
+        ARG;                                    \
+    } while (0)
 
 #endif // RIO_DEBUG
 
@@ -5,14 +5,43 @@
 
 namespace rio {
 
+#if RIO_IS_WIN
+class Heap;
+#endif // RIO_IS_WIN
+
 class MemUtil
 {
+public:
+    // Subsystem an allocation is made for
+    // On PC, each type has its own heap (see getHeap()), so that memory usage can be tracked per subsystem
+    enum HeapType
+    {
+        HEAP_TYPE_DEFAULT,
+        HEAP_TYPE_MODEL,
+        HEAP_TYPE_TEXTURE,
+        HEAP_TYPE_AUDIO,
+        HEAP_TYPE_FILE,
+        HEAP_TYPE_TASK,
+        HEAP_TYPE_NUM
+    };
+
 public:
     static void* copy(void* dst, const void* src, size_t size);
     static void* set(void* ptr, u8 val, size_t size);
 
-    static void* alloc(size_t size, u32 alignment);
+    static void* alloc(size_t size, u32 alignment, HeapType heap_type = HEAP_TYPE_DEFAULT);
     static void free(void* ptr);
+
+#if RIO_IS_WIN
+    // Get the heap used for allocations of the given type
+    static Heap* getHeap(HeapType heap_type);
+    // Set the heap used for allocations of the given type (nullptr to restore the default heap)
+    // Blocks are always freed to the heap they were allocated from, so the heap must outlive them.
+    static void setHeap(HeapType heap_type, Heap* heap);
+
+private:
+    static Heap* sHeap[HEAP_TYPE_NUM];
+#endif // RIO_IS_WIN
 };
 
 }
@@ -26,6 +26,16 @@
     #define RIO_IS_CAFE 0
 #endif
 
+#if RIO_IS_WIN && defined(RIO_USE_EGL)
+    // The EGL backend creates its context without GLFW (and thus without a window system)
+    #ifndef RIO_NO_GLFW_CALLS
+        #define RIO_NO_GLFW_CALLS
+    #endif
+    #ifndef RIO_NO_CONTROLLERS_WIN
+        #define RIO_NO_CONTROLLERS_WIN
+    #endif
+#endif
+
 #ifdef __cplusplus
     #include <cstdint>
     #include <cstddef>
@@ -0,0 +1,85 @@
+#ifndef RIO_HEAP_WIN_H
+#define RIO_HEAP_WIN_H
+
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+
+#include <atomic>
+
+namespace rio {
+
+class Heap
+{
+    // Base class of the heaps MemUtil allocates from on PC.
+    // Derived classes only provide raw aligned memory, while this class keeps track of
+    // the heap each block was allocated from and of the heap's usage statistics.
+
+public:
+    Heap(const char* name);
+    virtual ~Heap() { }
+
+private:
+    Heap(const Heap&);
+    Heap& operator=(const Heap&);
+
+public:
+    const char* getName() const { return mName; }
+
+    // Allocate a block of the given size and alignment (alignment must be a power of 2)
+    void* alloc(size_t size, u32 alignment);
+    // Free a block, to the heap it was allocated from
+    static void free(void* ptr);
+
+    // Get the heap a block was allocated from
+    static Heap* findHeap(const void* ptr);
+
+    // Number of bytes currently allocated (as requested)
+    size_t getLiveSize() const { return mLiveSize; }
+    // Highest number of bytes allocated at once
+    size_t getPeakSize() const { return mPeakSize; }
+    // Number of blocks currently allocated
+    u32 getLiveAllocNum() const { return mLiveAllocNum; }
+    // Total number of allocations
+    u32 getAllocNum() const { return mAllocNum; }
+
+    // Reset the peak to the current number of bytes allocated
+    void resetPeakSize()
+    {
+        mPeakSize = size_t(mLiveSize);
+    }
+
+protected:
+    virtual void* doAlloc_(size_t size, u32 alignment) = 0;
+    virtual void doFree_(void* ptr, size_t size, u32 alignment) = 0;
+
+private:
+    struct BlockHeader;
+
+    const char*         mName;
+    std::atomic<size_t> mLiveSize;
+    std::atomic<size_t> mPeakSize;
+    std::atomic<u32>    mLiveAllocNum;
+    std::atomic<u32>    mAllocNum;
+};
+
+class DefaultHeap : public Heap
+{
+    // Heap allocating from the C++ runtime, with the requested alignment
+
+public:
+    DefaultHeap(const char* name)
+        : Heap(name)
+    {
+    }
+
+protected:
+    virtual void* doAlloc_(size_t size, u32 alignment);
+    virtual void doFree_(void* ptr, size_t size, u32 alignment);
+};
+
+}
+
+#endif // RIO_IS_WIN
+
+#endif // RIO_HEAP_WIN_H
@@ -4,6 +4,8 @@
 // This file is included by rio_MemUtil.h
 //#include <misc/rio_MemUtil.h>
 
+#include <misc/win/rio_HeapWin.h>
+
 #include <cstring>
 
 namespace rio {
@@ -24,18 +26,18 @@ inline void* MemUtil::set(void* ptr, u8 val, size_t size)
     return std::memset(ptr, val, size);
 }
 
-inline void* MemUtil::alloc(size_t size, u32 alignment)
+inline void* MemUtil::alloc(size_t size, u32 alignment, HeapType heap_type)
 {
     RIO_ASSERT(size && alignment);
 
-    return new u8[size];
+    return getHeap(heap_type)->alloc(size, alignment);
 }
 
 inline void MemUtil::free(void* ptr)
 {
     RIO_ASSERT(ptr);
 
-    delete[] (u8*)ptr;
+    Heap::free(ptr);
 }
 
 }
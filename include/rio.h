@@ -1,6 +1,7 @@
 #ifndef RIO_INIT_H
 #define RIO_INIT_H
 
+#include <filedevice/rio_AsyncLoader.h>
 #include <task/rio_TaskMgr.h>
 
 namespace rio {
@@ -10,6 +11,13 @@ extern ITask* sRootTask;
 
 struct InitializeArg
 {
+    struct
+    {
+        // Number of I/O threads loading files for FileDeviceMgr::loadAsync()
+        // (0: files are loaded on the main thread when delivered)
+        // Ignored on platforms without I/O threads.
+        u32 io_thread_num = AsyncLoader::cDefaultThreadNum;
+    } file_device;
     struct
     {
         u32 width = 1280;
@@ -17,6 +25,9 @@ struct InitializeArg
 #if RIO_IS_WIN
         bool resizable = false;
         bool invisible = false;
+        // Render only to the window's own frame buffer, never presenting it to the screen
+        // (no screen blit, swap interval pacing or event polling in Window::swapBuffers())
+        bool offscreen = false;
         u32 gl_major = 3;
         #ifdef RIO_GLES
             u32 gl_minor = 0;
@@ -29,6 +40,13 @@ struct InitializeArg
     {
         const char* shader_path = "primitive_renderer";
     } primitive_renderer;
+    struct
+    {
+        // Number of worker threads running parallel-safe tasks along with the main thread
+        // (-1: one less than the number of hardware threads, 0: run all tasks on the main thread)
+        // Ignored on platforms without worker threads.
+        s32 worker_num = -1;
+    } task;
 };
 
 extern const InitializeArg cDefaultInitializeArg;
@@ -0,0 +1,86 @@
+#ifndef RIO_TASK_JOB_SCHEDULER_H
+#define RIO_TASK_JOB_SCHEDULER_H
+
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif // RIO_IS_WIN
+
+namespace rio {
+
+// Pool of worker threads running batches of jobs along with the calling thread.
+// Each thread has its own queue of jobs: it runs the jobs of its queue from the back, and once it is
+// empty, steals jobs from the front of the queues of the other threads, so that threads which got
+// cheaper jobs help with the rest of the batch.
+// Without worker threads (and on platforms without them), the jobs are simply run in order.
+class JobScheduler
+{
+public:
+    typedef void (*JobFunc)(void* arg);
+
+    struct Job
+    {
+        JobFunc func;
+        void*   arg;
+    };
+
+public:
+    JobScheduler();
+    ~JobScheduler();
+
+    // Start the worker threads
+    // (-1: one less than the number of hardware threads, 0: run all jobs on the calling thread)
+    void initialize(s32 worker_num = -1);
+    // Wait for the worker threads to end
+    void terminate();
+
+    u32 getWorkerNum() const;
+
+    // Run jobs on the worker threads and the calling thread, and return once all of them are done
+    // Jobs can run in any order and concurrently, and must not call run() themselves.
+    void run(const Job* jobs, u32 num);
+
+    // Number of jobs of the last run() which were stolen from the queue of another thread
+    u32 getStolenNum() const;
+
+private:
+    JobScheduler(const JobScheduler&);
+    JobScheduler& operator=(const JobScheduler&);
+
+#if RIO_IS_WIN
+    struct Queue
+    {
+        std::mutex      mutex;
+        std::deque<Job> jobs;
+    };
+
+    bool pop_(u32 queue, Job* job);
+    bool steal_(u32 queue, Job* job);
+    // Run jobs until there are none left to take
+    void work_(u32 queue);
+    void threadMain_(u32 queue);
+
+private:
+    std::vector<std::thread>    mWorker;
+    std::unique_ptr<Queue[]>    mQueue;         // One per worker, then one for the calling thread
+    u32                         mQueueNum;
+    std::mutex                  mMutex;
+    std::condition_variable     mCondition;
+    std::condition_variable     mDoneCondition; // Notified when the last job of the current run() is done
+    u32                         mGeneration;    // Incremented by run() to wake up the workers
+    bool                        mExit;
+    std::atomic<u32>            mRemainingNum;  // Jobs of the current run() not done yet
+    std::atomic<u32>            mStolenNum;
+#endif // RIO_IS_WIN
+};
+
+} // namespace rio
+
+#endif // RIO_TASK_JOB_SCHEDULER_H
@@ -2,16 +2,13 @@
 #define RIO_TASK_H
 
 #include <misc/rio_BitFlag.h>
-#include <container/rio_TList.h>
 
 namespace rio {
 
+class TaskPool;
+
 class ITask
 {
-public:
-    typedef TListNode<ITask*> ListNode;
-    typedef TList<ITask*> List;
-
 public:
     enum State
     {
@@ -51,10 +48,25 @@ public:
 
     State getState() const { return mState; }
 
+    // Declare calc_() parallel-safe, so that it can be run on a worker thread, concurrently with
+    // the calc_() of the other parallel-safe tasks of the same phase. It must then only access data
+    // of its own or read-only data, and must not call TaskMgr::destroyTask() (but can create tasks
+    // and request their destruction).
+    void setParallel(bool parallel) { mIsParallel = parallel; }
+    bool isParallel() const { return mIsParallel; }
+
+    // Phase in which calc_() is run (default 0): all tasks of a phase are done before the tasks
+    // of the next phase start, so tasks depending on the results of others go in a later phase
+    void setPhase(s32 phase) { mPhase = phase; }
+    s32 getPhase() const { return mPhase; }
+
 protected:
-    ListNode    mTaskListNode;
+    TaskPool*   mPool;          // Pool the task was allocated from
+    u32         mArrayIndex;    // Index in the task manager's array of tasks in the current state
     const char* mName;
     State       mState;
+    bool        mIsParallel;
+    s32         mPhase;
 
     friend class TaskMgr;
 };
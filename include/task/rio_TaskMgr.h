@@ -1,14 +1,27 @@
 #ifndef RIO_TASK_MGR_H
 #define RIO_TASK_MGR_H
 
+#include <task/rio_JobScheduler.h>
 #include <task/rio_Task.h>
+#include <task/rio_TaskPool.h>
+
+#include <new>
+#include <vector>
+
+#if RIO_IS_WIN
+#include <mutex>
+#endif // RIO_IS_WIN
 
 namespace rio {
 
 class TaskMgr
 {
 public:
-    static bool createSingleton();
+    // Create task manager singleton instance
+    // Parameters:
+    // - worker_num: Number of worker threads running parallel-safe tasks along with the main thread
+    //   (-1: one less than the number of hardware threads, 0: run all tasks on the main thread)
+    static bool createSingleton(s32 worker_num = -1);
     static void destroySingleton();
     static TaskMgr* instance() { return sInstance; }
 
@@ -16,37 +29,111 @@ private:
     static TaskMgr* sInstance;
 
     TaskMgr() { }
-    ~TaskMgr() { }
+    ~TaskMgr();
 
     TaskMgr(const TaskMgr&);
     TaskMgr& operator=(const TaskMgr&);
 
 public:
+    // Tasks are allocated from a pool per task type
     template <typename T>
     T* createTask();
 
+    // Allocate pool space for num tasks of type T in total, so that creating them does not allocate
+    template <typename T>
+    void reserveTask(u32 num);
+
     bool destroyTask(ITask* task);
     bool requestDestroyTask(ITask* task);
 
+    // Prepare the created tasks, run the calc_() of the running tasks phase by phase, then destroy
+    // the tasks requested to be destroyed. In each phase, the tasks which are not parallel-safe
+    // are run in order on the main thread, followed by the parallel-safe ones on all threads.
     void calc();
 
+    // Scheduler running the parallel-safe tasks, which can also be used for other jobs
+    // (from the main thread, outside of calc())
+    JobScheduler& getJobScheduler() { return mJobScheduler; }
+
 private:
     bool changeTaskState_(ITask* task, ITask::State state);
 
+    // Add a task to the array of tasks in the state, or clear its slot
+    void addTask_(std::vector<ITask*>& array, ITask* task);
+    void removeTask_(std::vector<ITask*>& array, ITask* task);
+    // Remove the cleared slots of the running tasks and sort them by phase
+    void sortActiveTasks_();
+
+    void freeTask_(ITask* task);
+
+    template <typename T>
+    TaskPool* getPool_();
+
+    static void calcTask_(void* task);
+
 private:
-    ITask::List  mPrepareList;
-    ITask::List  mActiveList;
-    ITask::List  mDestroyableList;
+    static u32 sTaskTypeNum;
+
+    // Tasks in each state, in the order they entered it (with cleared slots for tasks which left it)
+    std::vector<ITask*>             mPrepareTask;
+    std::vector<ITask*>             mActiveTask;        // Sorted by phase in calc()
+    std::vector<ITask*>             mDestroyableTask;
+    std::vector<TaskPool*>          mPool;              // Index: task type
+    JobScheduler                    mJobScheduler;
+    std::vector<JobScheduler::Job>  mCalcJob;           // (Temporary used by calc())
+#if RIO_IS_WIN
+    // Tasks can be created and requested to be destroyed from parallel-safe tasks
+    std::mutex                      mMutex;
+#endif // RIO_IS_WIN
 };
 
+template <typename T>
+TaskPool* TaskMgr::getPool_()
+{
+    static const u32 type = sTaskTypeNum++;
+
+    if (type >= mPool.size())
+        mPool.resize(type + 1, nullptr);
+
+    if (!mPool[type])
+        mPool[type] = new TaskPool(sizeof(T), alignof(T));
+
+    return mPool[type];
+}
+
 template <typename T>
 T* TaskMgr::createTask()
 {
-    T* task = new T;
+    TaskPool* pool;
+    void* ptr;
+    {
+#if RIO_IS_WIN
+        std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+        pool = getPool_<T>();
+        ptr = pool->alloc();
+    }
+
+    // Constructed outside of the lock, as the constructor may create tasks
+    T* task = new (ptr) T;
+    task->mPool = pool;
+
+#if RIO_IS_WIN
+    std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
     changeTaskState_(task, ITask::STATE_PREPARE);
     return task;
 }
 
+template <typename T>
+void TaskMgr::reserveTask(u32 num)
+{
+#if RIO_IS_WIN
+    std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+    getPool_<T>()->reserve(num);
+}
+
 } // namespace rio
 
 #endif // RIO_TASK_MGR_H
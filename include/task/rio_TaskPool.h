@@ -0,0 +1,53 @@
+#ifndef RIO_TASK_POOL_H
+#define RIO_TASK_POOL_H
+
+#include <misc/rio_Types.h>
+
+#include <vector>
+
+namespace rio {
+
+// Allocator of fixed-size blocks for the tasks of one type.
+// Blocks are carved from slabs which are kept until the pool is destroyed, and freed blocks are
+// reused first, so that creating and destroying tasks does not allocate once the pool is warmed up.
+class TaskPool
+{
+public:
+    static constexpr u32 cSlabBlockNum = 64;
+
+public:
+    TaskPool(size_t size, size_t alignment, u32 slab_block_num = cSlabBlockNum);
+    ~TaskPool();
+
+    void* alloc();
+    void free(void* ptr);
+
+    // Allocate slabs for at least num blocks in total
+    void reserve(u32 num);
+
+    u32 getUsedNum() const { return mUsedNum; }
+    u32 getCapacity() const { return mSlab.size() * mSlabBlockNum; }
+
+private:
+    TaskPool(const TaskPool&);
+    TaskPool& operator=(const TaskPool&);
+
+    struct FreeBlock
+    {
+        FreeBlock*  next;
+    };
+
+    void addSlab_();
+
+private:
+    size_t              mBlockSize;
+    u32                 mAlignment;
+    u32                 mSlabBlockNum;
+    FreeBlock*          mFreeList;
+    std::vector<void*>  mSlab;
+    u32                 mUsedNum;
+};
+
+} // namespace rio
+
+#endif // RIO_TASK_POOL_H
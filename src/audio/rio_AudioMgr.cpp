@@ -40,7 +40,7 @@ size_t SDLRWopsRead(SDL_RWops* context, void* ptr, size_t size, size_t maxnum)
     if (uintptr_t(ptr) % rio::FileDevice::cBufferMinAlignment == 0)
         return p_handle->read(static_cast<u8*>(ptr), total_size) / size;
 
-    u8* tmp = static_cast<u8*>(rio::MemUtil::alloc(total_size, rio::FileDevice::cBufferMinAlignment));
+    u8* tmp = static_cast<u8*>(rio::MemUtil::alloc(total_size, rio::FileDevice::cBufferMinAlignment, rio::MemUtil::HEAP_TYPE_AUDIO));
 
     u32 read_size = p_handle->read(static_cast<u8*>(tmp), total_size);
     if (read_size > 0)
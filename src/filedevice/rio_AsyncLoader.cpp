@@ -0,0 +1,413 @@
+#include <filedevice/rio_AsyncLoader.h>
+#include <filedevice/rio_FileDeviceMgr.h>
+
+namespace rio {
+
+AsyncLoader::AsyncLoader()
+    : mRequest()
+    , mQueue()
+    , mLoaded()
+    , mNextHandle(cInvalidHandle + 1)
+#if RIO_IS_WIN
+    , mThread()
+    , mExit(false)
+#endif // RIO_IS_WIN
+{
+}
+
+AsyncLoader::~AsyncLoader()
+{
+    terminate();
+}
+
+void AsyncLoader::initialize(u32 thread_num)
+{
+#if RIO_IS_WIN
+    terminate();
+
+    mExit = false;
+
+    mThread.reserve(thread_num);
+    for (u32 i = 0; i < thread_num; i++)
+        mThread.emplace_back(&AsyncLoader::threadMain_, this);
+#endif // RIO_IS_WIN
+}
+
+void AsyncLoader::terminate()
+{
+#if RIO_IS_WIN
+    if (!mThread.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mExit = true;
+        }
+        mQueueCondition.notify_all();
+
+        // The threads finish the files they are loading
+        for (std::thread& thread : mThread)
+            thread.join();
+
+        mThread.clear();
+    }
+#endif // RIO_IS_WIN
+
+    for (const auto& it : mRequest)
+        if (it.second.status == STATUS_LOADED)
+            releaseFile_(it.second.arg, it.second.data);
+
+    mRequest.clear();
+    mQueue = std::priority_queue<QueueEntry>();
+    mLoaded.clear();
+}
+
+u32 AsyncLoader::getThreadNum() const
+{
+#if RIO_IS_WIN
+    return mThread.size();
+#else
+    return 0;
+#endif // RIO_IS_WIN
+}
+
+AsyncLoader::Handle AsyncLoader::load(const FileDevice::LoadArg& arg, Callback callback, void* user_data, s32 priority)
+{
+    RIO_ASSERT(!arg.path.empty());
+    RIO_ASSERT(callback);
+
+    Handle handle;
+    {
+#if RIO_IS_WIN
+        std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+
+        handle = mNextHandle++;
+        if (mNextHandle == cInvalidHandle)
+            mNextHandle++;
+
+        mRequest.try_emplace(handle, Request{ arg, callback, user_data, STATUS_QUEUED, false, nullptr });
+        mQueue.push(QueueEntry{ priority, handle });
+    }
+#if RIO_IS_WIN
+    mQueueCondition.notify_one();
+#endif // RIO_IS_WIN
+
+    return handle;
+}
+
+bool AsyncLoader::cancel(Handle handle)
+{
+#if RIO_IS_WIN
+    std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+
+    auto it = mRequest.find(handle);
+    if (it == mRequest.end() || it->second.canceled)
+        return false;
+
+    Request& request = it->second;
+
+    switch (request.status)
+    {
+    case STATUS_QUEUED:
+        // Its queue entry is skipped
+        mRequest.erase(it);
+        break;
+
+    case STATUS_LOADING:
+        // Released by the thread loading it
+        request.canceled = true;
+        break;
+
+    case STATUS_LOADED:
+        releaseFile_(request.arg, request.data);
+        mRequest.erase(it);
+
+        for (auto loaded_it = mLoaded.begin(); loaded_it != mLoaded.end(); ++loaded_it)
+        {
+            if (*loaded_it == handle)
+            {
+                mLoaded.erase(loaded_it);
+                break;
+            }
+        }
+        break;
+
+    default:
+        RIO_ASSERT(false);
+        return false;
+    }
+
+    return true;
+}
+
+void AsyncLoader::wait(Handle handle)
+{
+    {
+#if RIO_IS_WIN
+        std::unique_lock<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+
+        // (Canceled requests are waited for until they are released)
+        auto it = mRequest.find(handle);
+        if (it == mRequest.end())
+            return;
+
+        if (it->second.status == STATUS_QUEUED)
+        {
+            // Load it on this thread rather than waiting for its turn (its queue entry is skipped)
+            it->second.status = STATUS_LOADING;
+            FileDevice::LoadArg arg = it->second.arg;
+
+#if RIO_IS_WIN
+            lock.unlock();
+#endif // RIO_IS_WIN
+            u8* data = loadFile_(arg);
+#if RIO_IS_WIN
+            lock.lock();
+#endif // RIO_IS_WIN
+
+            setLoaded_(handle, arg, data);
+        }
+#if RIO_IS_WIN
+        else if (it->second.status == STATUS_LOADING)
+        {
+            mLoadedCondition.wait(lock, [this, handle]() {
+                auto request_it = mRequest.find(handle);
+                return request_it == mRequest.end() || request_it->second.status == STATUS_LOADED;
+            });
+        }
+#endif // RIO_IS_WIN
+
+        it = mRequest.find(handle);
+        if (it == mRequest.end())
+            return;
+
+        for (auto loaded_it = mLoaded.begin(); loaded_it != mLoaded.end(); ++loaded_it)
+        {
+            if (*loaded_it == handle)
+            {
+                mLoaded.erase(loaded_it);
+                break;
+            }
+        }
+    }
+
+    deliver_(handle);
+}
+
+void AsyncLoader::deliver()
+{
+    if (getThreadNum() == 0)
+        loadQueued_();
+
+    // Only the requests loaded so far, as more may be loaded while the callbacks run
+    u32 num;
+    {
+#if RIO_IS_WIN
+        std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+        num = mLoaded.size();
+    }
+
+    for (u32 i = 0; i < num; i++)
+    {
+        Handle handle;
+        {
+#if RIO_IS_WIN
+            std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+
+            // Callbacks may have canceled or waited for other requests
+            if (mLoaded.empty())
+                break;
+
+            handle = mLoaded.front();
+            mLoaded.pop_front();
+        }
+
+        deliver_(handle);
+    }
+}
+
+void AsyncLoader::flush()
+{
+    // Help the threads with the queued requests
+    loadQueued_();
+
+#if RIO_IS_WIN
+    {
+        // Wait for the requests being loaded by the threads
+        std::unique_lock<std::mutex> lock(mMutex);
+        mLoadedCondition.wait(lock, [this]() { return mLoaded.size() == mRequest.size(); });
+    }
+#endif // RIO_IS_WIN
+
+    deliver();
+}
+
+AsyncLoader::Status AsyncLoader::getStatus(Handle handle) const
+{
+#if RIO_IS_WIN
+    std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+
+    auto it = mRequest.find(handle);
+    if (it == mRequest.end() || it->second.canceled)
+        return STATUS_NONE;
+
+    return it->second.status;
+}
+
+u32 AsyncLoader::getPendingNum() const
+{
+#if RIO_IS_WIN
+    std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+
+    return mRequest.size();
+}
+
+bool AsyncLoader::pop_(Handle* handle, FileDevice::LoadArg* arg)
+{
+    while (!mQueue.empty())
+    {
+        const Handle h = mQueue.top().handle;
+        mQueue.pop();
+
+        auto it = mRequest.find(h);
+        if (it == mRequest.end() || it->second.status != STATUS_QUEUED)
+            continue;
+
+        it->second.status = STATUS_LOADING;
+        *handle = h;
+        *arg = it->second.arg;
+        return true;
+    }
+
+    return false;
+}
+
+void AsyncLoader::setLoaded_(Handle handle, const FileDevice::LoadArg& arg, u8* data)
+{
+    auto it = mRequest.find(handle);
+    RIO_ASSERT(it != mRequest.end());
+
+    Request& request = it->second;
+    RIO_ASSERT(request.status == STATUS_LOADING);
+
+    if (request.canceled)
+    {
+        releaseFile_(arg, data);
+        mRequest.erase(it);
+    }
+    else
+    {
+        request.arg = arg;
+        request.data = data;
+        request.status = STATUS_LOADED;
+        mLoaded.push_back(handle);
+    }
+
+#if RIO_IS_WIN
+    mLoadedCondition.notify_all();
+#endif // RIO_IS_WIN
+}
+
+void AsyncLoader::deliver_(Handle handle)
+{
+    Request request;
+    {
+#if RIO_IS_WIN
+        std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+
+        auto it = mRequest.find(handle);
+        RIO_ASSERT(it != mRequest.end() && it->second.status == STATUS_LOADED);
+
+        request = std::move(it->second);
+        mRequest.erase(it);
+    }
+
+    request.callback(handle, request.arg, request.data, request.user_data);
+}
+
+void AsyncLoader::loadQueued_()
+{
+#if RIO_IS_WIN
+    std::unique_lock<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+
+    Handle handle;
+    FileDevice::LoadArg arg;
+
+    while (pop_(&handle, &arg))
+    {
+#if RIO_IS_WIN
+        lock.unlock();
+#endif // RIO_IS_WIN
+        u8* data = loadFile_(arg);
+#if RIO_IS_WIN
+        lock.lock();
+#endif // RIO_IS_WIN
+
+        setLoaded_(handle, arg, data);
+    }
+}
+
+u8* AsyncLoader::loadFile_(FileDevice::LoadArg& arg)
+{
+    u8* data = FileDeviceMgr::instance()->tryLoad(arg);
+    if (!data)
+    {
+        RIO_LOG("AsyncLoader: Failed to load \"%s\".\n", arg.path.c_str());
+        return nullptr;
+    }
+
+    // Mapped files are only read when accessed: read them here, on the loading thread,
+    // rather than as page faults on the thread using them
+    if (arg.is_mapped)
+        FileDevice::prefaultMappedPages(data, arg.read_size);
+
+    return data;
+}
+
+void AsyncLoader::releaseFile_(const FileDevice::LoadArg& arg, u8* data)
+{
+    if (!data)
+        return;
+
+    if (arg.is_mapped)
+        FileDeviceMgr::unmap(data, arg.read_size);
+    else if (arg.need_unload)
+        FileDeviceMgr::unload(data);
+}
+
+#if RIO_IS_WIN
+
+void AsyncLoader::threadMain_()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    for (;;)
+    {
+        mQueueCondition.wait(lock, [this]() { return mExit || !mQueue.empty(); });
+        if (mExit)
+            return;
+
+        Handle handle;
+        FileDevice::LoadArg arg;
+        if (!pop_(&handle, &arg))
+            continue;
+
+        lock.unlock();
+        u8* data = loadFile_(arg);
+        lock.lock();
+
+        setLoaded_(handle, arg, data);
+    }
+}
+
+#endif // RIO_IS_WIN
+
+}
@@ -2,6 +2,13 @@
 #include <filedevice/rio_FileDeviceMgr.h>
 #include <misc/rio_MemUtil.h>
 
+#if RIO_IS_WIN && defined(_WIN32)
+#include <misc/win/rio_Windows.h>
+#elif RIO_IS_WIN
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace {
 
 static inline u32 max(u32 x, u32 y)
@@ -38,6 +45,93 @@ u8* FileDevice::tryLoad(FileDevice::LoadArg& arg)
     return doLoad_(arg);
 }
 
+u32 FileDevice::tryLoadBatch(FileDevice::LoadArg* args, u8** data, u32 num)
+{
+    if (num == 0)
+        return 0;
+
+    if (args == nullptr || data == nullptr)
+    {
+        RIO_LOG("FileDevice::tryLoadBatch(): args or data is null.\n");
+        RIO_ASSERT(false);
+        return 0;
+    }
+
+    return doLoadBatch_(args, data, num);
+}
+
+void FileDevice::unmap(u8* data, u32 size)
+{
+    RIO_ASSERT(data);
+
+#if RIO_IS_WIN && defined(_WIN32)
+    [[maybe_unused]] BOOL success = UnmapViewOfFile(data);
+    RIO_ASSERT(success);
+#elif RIO_IS_WIN
+    [[maybe_unused]] int ret = munmap(data, size);
+    RIO_ASSERT(ret == 0);
+#else
+    // Files are never mapped on this platform
+    RIO_ASSERT(false);
+#endif
+}
+
+void FileDevice::discardMappedPages(const u8* data, u32 size)
+{
+#if RIO_IS_WIN
+    RIO_ASSERT(data);
+
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const uintptr_t page_size = info.dwPageSize;
+#else
+    const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+#endif
+
+    // Only whole pages can be discarded
+    const uintptr_t start = ((uintptr_t)data + page_size - 1) & ~(page_size - 1);
+    const uintptr_t end = ((uintptr_t)data + size) & ~(page_size - 1);
+    if (start >= end)
+        return;
+
+#if defined(_WIN32)
+    // Unlocking pages which are not locked removes them from the working set
+    VirtualUnlock((void*)start, end - start);
+#else
+    madvise((void*)start, end - start, MADV_DONTNEED);
+#endif
+#endif // RIO_IS_WIN
+}
+
+void FileDevice::prefaultMappedPages(const u8* data, u32 size)
+{
+#if RIO_IS_WIN
+    RIO_ASSERT(data);
+
+    if (size == 0)
+        return;
+
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const uintptr_t page_size = info.dwPageSize;
+#else
+    const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+
+    // Start reading all pages ahead, rather than one by one as they are touched
+    const uintptr_t start = (uintptr_t)data & ~(page_size - 1);
+    madvise((void*)start, (uintptr_t)data + size - start, MADV_WILLNEED);
+#endif
+
+    // Touch every page, so that they are all mapped when this returns
+    const volatile u8* const p = data;
+    for (uintptr_t offset = 0; offset < size; offset += page_size)
+        (void)p[offset];
+    (void)p[size - 1];
+#endif // RIO_IS_WIN
+}
+
 FileDevice* FileDevice::tryOpen(FileHandle* handle, const std::string& filename, FileDevice::FileOpenFlag flag)
 {
     if (handle == nullptr)
@@ -271,7 +365,7 @@ u8* FileDevice::doLoad_(FileDevice::LoadArg& arg)
 
     if (!buffer)
     {
-        buffer = (u8*)MemUtil::alloc(buffer_size, align(arg.alignment, FileDevice::cBufferMinAlignment));
+        buffer = (u8*)MemUtil::alloc(buffer_size, align(arg.alignment, FileDevice::cBufferMinAlignment), arg.heap_type);
         need_unload = true;
     }
 
@@ -299,6 +393,20 @@ u8* FileDevice::doLoad_(FileDevice::LoadArg& arg)
     return buffer;
 }
 
+u32 FileDevice::doLoadBatch_(FileDevice::LoadArg* args, u8** data, u32 num)
+{
+    u32 loaded_num = 0;
+
+    for (u32 i = 0; i < num; i++)
+    {
+        data[i] = doLoad_(args[i]);
+        if (data[i])
+            loaded_num++;
+    }
+
+    return loaded_num;
+}
+
 void FileHandle::close()
 {
     if (!isOpen())
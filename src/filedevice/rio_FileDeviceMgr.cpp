@@ -12,12 +12,13 @@ namespace rio {
 
 FileDeviceMgr* FileDeviceMgr::sInstance = nullptr;
 
-bool FileDeviceMgr::createSingleton()
+bool FileDeviceMgr::createSingleton(u32 io_thread_num)
 {
     if (sInstance)
         return false;
 
     sInstance = new FileDeviceMgr();
+    sInstance->mAsyncLoader.initialize(io_thread_num);
     return true;
 }
 
@@ -32,6 +33,7 @@ void FileDeviceMgr::destroySingleton()
 
 FileDeviceMgr::FileDeviceMgr()
     : mDeviceList()
+    , mAsyncLoader()
 {
 #if RIO_IS_CAFE
     FSInit();
@@ -59,6 +61,9 @@ FileDeviceMgr::FileDeviceMgr()
 
 FileDeviceMgr::~FileDeviceMgr()
 {
+    // The I/O threads use the devices
+    mAsyncLoader.terminate();
+
     if (mMainFileDevice)
     {
         delete mMainFileDevice;
@@ -165,6 +170,7 @@ u8* FileDeviceMgr::tryLoad(FileDevice::LoadArg& arg)
     arg.read_size = arg_.read_size;
     arg.roundup_size = arg_.roundup_size;
     arg.need_unload = arg_.need_unload;
+    arg.is_mapped = arg_.is_mapped;
 
     return ret;
 }
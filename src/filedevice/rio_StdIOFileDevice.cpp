@@ -1,21 +1,129 @@
 #include <filedevice/rio_StdIOFileDevice.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <string>
+#include <unordered_map>
 
 #include <sys/stat.h>
 
+#if RIO_IS_WIN && defined(_WIN32)
+#include <misc/win/rio_Windows.h>
+#elif RIO_IS_WIN
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// IDs are never reused, so that a device can not get the results of a destroyed one
+std::atomic<u32> sDeviceIDCounter(0);
+
+// Result of the last operation of the calling thread, by device ID
+thread_local std::unordered_map<u32, rio::RawErrorCode> sLastRawError;
+
+}
+
 namespace rio {
 
 StdIOFileDevice::StdIOFileDevice(const std::string& drive_name, const std::string& cwd)
     : FileDevice(drive_name)
     , mCWD(cwd)
-    , mLastRawError(rio::RAW_ERROR_OK)
+    , mID(++sDeviceIDCounter)
+{
+}
+
+u8*
+StdIOFileDevice::doLoad_(LoadArg& arg)
+{
+#if RIO_IS_WIN
+    if (arg.map && !arg.buffer)
+    {
+        u8* data = doMap_(arg);
+        if (data)
+            return data;
+    }
+#endif // RIO_IS_WIN
+
+    return FileDevice::doLoad_(arg);
+}
+
+#if RIO_IS_WIN
+
+u8*
+StdIOFileDevice::doMap_(LoadArg& arg)
 {
+    std::string file_path = getNativePath(arg.path);
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0 || file_size.QuadPart > 0xFFFFFFFF)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return nullptr;
+
+    // The view keeps the file mapping alive
+    u8* data = (u8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data)
+        return nullptr;
+
+    const u32 size = u32(file_size.QuadPart);
+#else
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0 || u64(st.st_size) > 0xFFFFFFFF)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const u32 size = u32(st.st_size);
+
+    // The mapping stays valid after closing the file
+    void* ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (ptr == MAP_FAILED)
+        return nullptr;
+
+    u8* data = (u8*)ptr;
+#endif
+
+    // Mappings are page-aligned, which should satisfy any sane alignment
+    if ((uintptr_t)data & (std::max(arg.alignment, 1u) - 1))
+    {
+        unmap(data, size);
+        return nullptr;
+    }
+
+    setLastRawError_(RAW_ERROR_OK);
+
+    arg.read_size = size;
+    arg.roundup_size = size;
+    arg.need_unload = false;
+    arg.is_mapped = true;
+
+    return data;
 }
 
+#endif // RIO_IS_WIN
+
 FileDevice*
 StdIOFileDevice::doOpen_(
     FileHandle* handle, const std::string& filename,
@@ -49,7 +157,7 @@ StdIOFileDevice::doOpen_(
     handle_inner->handle = (uintptr_t)std::fopen(file_path.c_str(), mode);
     if (handle_inner->handle)
     {
-        mLastRawError = RAW_ERROR_OK;
+        setLastRawError_(RAW_ERROR_OK);
         return this;
     }
 
@@ -58,22 +166,22 @@ StdIOFileDevice::doOpen_(
     switch (errno)
     {
   //case ECANCELED:
-  //    mLastRawError = RAW_ERROR_CANCELED;
+  //    setLastRawError_(RAW_ERROR_CANCELED);
   //    break;
   //case :
-  //    mLastRawError = RAW_ERROR_ALREADY_OPEN;
+  //    setLastRawError_(RAW_ERROR_ALREADY_OPEN);
   //    break;
     case ENOENT:
-        mLastRawError = RAW_ERROR_NOT_FOUND;
+        setLastRawError_(RAW_ERROR_NOT_FOUND);
         break;
     case EISDIR:
-        mLastRawError = RAW_ERROR_NOT_FILE;
+        setLastRawError_(RAW_ERROR_NOT_FILE);
         break;
     case EINVAL:
     case ENOSPC:
     case EROFS:
     case ETXTBSY:
-        mLastRawError = RAW_ERROR_ACCESS_ERROR;
+        setLastRawError_(RAW_ERROR_ACCESS_ERROR);
         break;
     case EACCES:
         {
@@ -85,13 +193,13 @@ StdIOFileDevice::doOpen_(
             errno = prev_errno;
 
             if (stat_ret == 0 && ((st.st_mode & S_IFDIR) || !(st.st_mode & S_IFREG)))
-                mLastRawError = RAW_ERROR_NOT_FILE;
+                setLastRawError_(RAW_ERROR_NOT_FILE);
             else
-                mLastRawError = RAW_ERROR_PERMISSION_ERROR;
+                setLastRawError_(RAW_ERROR_PERMISSION_ERROR);
         }
         break;
     default:
-        mLastRawError = RAW_ERROR_FATAL_ERROR;
+        setLastRawError_(RAW_ERROR_FATAL_ERROR);
         RIO_LOG("StdIOFileDevice::doOpen_(): Unexpected error: %s\n", std::strerror(errno));
         RIO_ASSERT(false);
     }
@@ -107,18 +215,18 @@ StdIOFileDevice::doClose_(FileHandle* handle)
     errno = 0;
     if (std::fclose((std::FILE*)handle_inner->handle) == 0)
     {
-        mLastRawError = RAW_ERROR_OK;
+        setLastRawError_(RAW_ERROR_OK);
         return true;
     }
 
     RIO_ASSERT(errno != 0);
 
   //if (errno == ECANCELED)
-  //    mLastRawError = RAW_ERROR_CANCELED;
+  //    setLastRawError_(RAW_ERROR_CANCELED);
   //
   //else
     {
-        mLastRawError = RAW_ERROR_FATAL_ERROR;
+        setLastRawError_(RAW_ERROR_FATAL_ERROR);
         RIO_LOG("StdIOFileDevice::doClose_(): Unexpected error: %s\n", std::strerror(errno));
         RIO_ASSERT(false);
     }
@@ -142,11 +250,11 @@ StdIOFileDevice::doRead_(
         RIO_ASSERT(errno != 0);
 
       //if (errno == ECANCELED)
-      //    mLastRawError = RAW_ERROR_CANCELED;
+      //    setLastRawError_(RAW_ERROR_CANCELED);
       //
       //else
         {
-            mLastRawError = RAW_ERROR_FATAL_ERROR;
+            setLastRawError_(RAW_ERROR_FATAL_ERROR);
             RIO_LOG("StdIOFileDevice::doRead_(): Unexpected error: %s\n", std::strerror(errno));
             RIO_ASSERT(false);
         }
@@ -154,7 +262,7 @@ StdIOFileDevice::doRead_(
         return false;
     }
 
-    mLastRawError = RAW_ERROR_OK;
+    setLastRawError_(RAW_ERROR_OK);
 
     if (read_size)
         // NOTE: will exceed and overflow past 2 GB.
@@ -181,16 +289,16 @@ StdIOFileDevice::doWrite_(
         switch (errno)
         {
       //case ECANCELED:
-      //    mLastRawError = RAW_ERROR_CANCELED;
+      //    setLastRawError_(RAW_ERROR_CANCELED);
       //    break;
         case EFBIG:
-            mLastRawError = RAW_ERROR_FILE_TOO_BIG;
+            setLastRawError_(RAW_ERROR_FILE_TOO_BIG);
             break;
         case ENOSPC:
-            mLastRawError = RAW_ERROR_STORAGE_FULL;
+            setLastRawError_(RAW_ERROR_STORAGE_FULL);
             break;
         default:
-            mLastRawError = RAW_ERROR_FATAL_ERROR;
+            setLastRawError_(RAW_ERROR_FATAL_ERROR);
             RIO_LOG("StdIOFileDevice::doWrite_(): Unexpected error: %s\n", std::strerror(errno));
             RIO_ASSERT(false);
             break;
@@ -199,7 +307,7 @@ StdIOFileDevice::doWrite_(
         return false;
     }
 
-    mLastRawError = RAW_ERROR_OK;
+    setLastRawError_(RAW_ERROR_OK);
 
     if (write_size)
         *write_size = result;
@@ -234,18 +342,18 @@ StdIOFileDevice::doSeek_(
     errno = 0;
     if (std::fseek((std::FILE*)handle_inner->handle, offset, std_origin) == 0)
     {
-        mLastRawError = RAW_ERROR_OK;
+        setLastRawError_(RAW_ERROR_OK);
         return true;
     }
 
     RIO_ASSERT(errno != 0);
 
   //if (errno == ECANCELED)
-  //    mLastRawError = RAW_ERROR_CANCELED;
+  //    setLastRawError_(RAW_ERROR_CANCELED);
   //
   //else
     {
-        mLastRawError = RAW_ERROR_FATAL_ERROR;
+        setLastRawError_(RAW_ERROR_FATAL_ERROR);
         RIO_LOG("StdIOFileDevice::doSeek_(): Unexpected error: %s\n", std::strerror(errno));
         RIO_ASSERT(false);
     }
@@ -267,11 +375,11 @@ StdIOFileDevice::doGetCurrentSeekPos_(
         RIO_ASSERT(errno != 0);
 
       //if (errno == ECANCELED)
-      //    mLastRawError = RAW_ERROR_CANCELED;
+      //    setLastRawError_(RAW_ERROR_CANCELED);
       //
       //else
         {
-            mLastRawError = RAW_ERROR_FATAL_ERROR;
+            setLastRawError_(RAW_ERROR_FATAL_ERROR);
             RIO_LOG("StdIOFileDevice::doSeek_(): Unexpected error: %s\n", std::strerror(errno));
             RIO_ASSERT(false);
         }
@@ -279,7 +387,7 @@ StdIOFileDevice::doGetCurrentSeekPos_(
         return false;
     }
 
-    mLastRawError = RAW_ERROR_OK;
+    setLastRawError_(RAW_ERROR_OK);
     *pos = result;
     return true;
 }
@@ -295,7 +403,7 @@ StdIOFileDevice::doGetFileSize_(
     errno = 0;
     if (stat(file_path.c_str(), &st) == 0)
     {
-        mLastRawError = RAW_ERROR_OK;
+        setLastRawError_(RAW_ERROR_OK);
         *size = st.st_size;
         return true;
     }
@@ -303,11 +411,11 @@ StdIOFileDevice::doGetFileSize_(
     RIO_ASSERT(errno != 0);
 
   //if (errno == ECANCELED)
-  //    mLastRawError = RAW_ERROR_CANCELED;
+  //    setLastRawError_(RAW_ERROR_CANCELED);
   //
   //else
     {
-        mLastRawError = RAW_ERROR_FATAL_ERROR;
+        setLastRawError_(RAW_ERROR_FATAL_ERROR);
         RIO_LOG("StdIOFileDevice::doGetFileSize_(): Unexpected error: %s\n", std::strerror(errno));
         RIO_ASSERT(false);
     }
@@ -331,11 +439,11 @@ StdIOFileDevice::doGetFileSize_(
         RIO_ASSERT(errno != 0);
 
       //if (errno == ECANCELED)
-      //    mLastRawError = RAW_ERROR_CANCELED;
+      //    setLastRawError_(RAW_ERROR_CANCELED);
       //
       //else
         {
-            mLastRawError = RAW_ERROR_FATAL_ERROR;
+            setLastRawError_(RAW_ERROR_FATAL_ERROR);
             RIO_LOG("StdIOFileDevice::doGetFileSize_(): Unexpected error: %s\n", std::strerror(errno));
             RIO_ASSERT(false);
         }
@@ -343,7 +451,7 @@ StdIOFileDevice::doGetFileSize_(
         return false;
     }
 
-    mLastRawError = RAW_ERROR_OK;
+    setLastRawError_(RAW_ERROR_OK);
     *size = st.st_size;
     return true;
 }
@@ -359,7 +467,7 @@ StdIOFileDevice::doIsExistFile_(
     errno = 0;
     if (stat(file_path.c_str(), &st) == 0)
     {
-        mLastRawError = RAW_ERROR_OK;
+        setLastRawError_(RAW_ERROR_OK);
         *is_exist = !(st.st_mode & S_IFDIR) && (st.st_mode & S_IFREG);
         return true;
     }
@@ -369,17 +477,17 @@ StdIOFileDevice::doIsExistFile_(
     switch (errno)
     {
   //case ECANCELED:
-  //    mLastRawError = RAW_ERROR_CANCELED;
+  //    setLastRawError_(RAW_ERROR_CANCELED);
   //    break;
     case ENOENT:
-        mLastRawError = RAW_ERROR_NOT_FOUND;
+        setLastRawError_(RAW_ERROR_NOT_FOUND);
         *is_exist = false;
         return true;
     case EACCES:
-        mLastRawError = RAW_ERROR_PERMISSION_ERROR;
+        setLastRawError_(RAW_ERROR_PERMISSION_ERROR);
         break;
     default:
-        mLastRawError = RAW_ERROR_FATAL_ERROR;
+        setLastRawError_(RAW_ERROR_FATAL_ERROR);
         RIO_LOG("StdIOFileDevice::doIsExistFile_(): Unexpected error: %s\n", std::strerror(errno));
         RIO_ASSERT(false);
         break;
@@ -388,9 +496,15 @@ StdIOFileDevice::doIsExistFile_(
     return false;
 }
 
+void StdIOFileDevice::setLastRawError_(RawErrorCode error)
+{
+    sLastRawError[mID] = error;
+}
+
 RawErrorCode StdIOFileDevice::doGetLastRawError_() const
 {
-    return mLastRawError;
+    const auto it = sLastRawError.find(mID);
+    return it != sLastRawError.end() ? it->second : RAW_ERROR_OK;
 }
 
 }
@@ -0,0 +1,705 @@
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+
+#include <filedevice/rio_UringFileDevice.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/stat.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define RIO_FILE_URING_SUPPORTED 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#else
+#define RIO_FILE_URING_SUPPORTED 0
+#endif
+
+namespace {
+
+static inline u32 align(u32 x, u32 y)
+{
+    RIO_ASSERT(((y - 1) & y) == 0);
+    return (x + y - 1) & ~(y - 1); // bitwise NOT
+}
+
+}
+
+namespace rio {
+
+#if RIO_FILE_URING_SUPPORTED
+
+struct UringFileDevice::Ring
+{
+    static constexpr u32 cEntryNum = cBatchMaxNum;
+
+    // Results of the entries which did not complete when submitAndWait() fails
+    // (neither can be the result of the operations used)
+    static constexpr s32 cInFlight = -EINPROGRESS;      // Taken by the kernel
+    static constexpr s32 cNotSubmitted = -ECANCELED;    // Withdrawn
+
+    int                 fd;
+    u8*                 sq_ptr;
+    size_t              sq_size;
+    u8*                 cq_ptr;
+    size_t              cq_size;
+    io_uring_sqe*       sqes;
+    size_t              sqes_size;
+
+    u32*                sq_head;
+    u32*                sq_tail;
+    u32                 sq_mask;
+    u32*                sq_array;
+    u32*                cq_head;
+    u32*                cq_tail;
+    u32                 cq_mask;
+    io_uring_cqe*       cqes;
+
+    // State of the files of the current batch
+    std::string         path[cBatchMaxNum];
+    struct stat         stat[cBatchMaxNum];
+    s32                 open_result[cBatchMaxNum];   // File descriptor, or -errno
+    s32                 read_result[cBatchMaxNum];   // Size read, or -errno
+    s32                 close_result[cBatchMaxNum];  // 0, or -errno
+
+    // Create a ring (returns nullptr if io_uring or the operations used are not available)
+    static Ring* create();
+    ~Ring();
+
+    io_uring_sqe* getSqe()
+    {
+        const u32 tail = *sq_tail;
+        RIO_ASSERT(tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) < cEntryNum);
+
+        const u32 index = tail & sq_mask;
+        sq_array[index] = index;
+        *sq_tail = tail + 1;    // (Published to the kernel by submitAndWait())
+
+        io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(io_uring_sqe));
+        return sqe;
+    }
+
+    // Submit the submit_num entries got since the last call, and wait for their completion, the result
+    // of each entry being stored in results[user_data], which the caller sets to cInFlight beforehand.
+    // On failure, the completions received so far are stored, and the entries which the kernel did not
+    // take are withdrawn (cNotSubmitted), so that only those left cInFlight may still be running.
+    bool submitAndWait(u32 submit_num, s32* results)
+    {
+        __atomic_store_n(sq_tail, *sq_tail, __ATOMIC_RELEASE);
+
+        u32 wait_num = submit_num;
+        u64 user_data;
+        s32 result;
+
+        for (;;)
+        {
+            while (popCqe(&user_data, &result))
+            {
+                results[user_data] = result;
+                wait_num--;
+            }
+
+            if (wait_num == 0)
+                return true;
+
+            const int ret = syscall(__NR_io_uring_enter, fd, submit_num, wait_num, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (ret < 0)
+            {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                    continue;
+
+                RIO_LOG("UringFileDevice: io_uring_enter() failed: %s\n", std::strerror(errno));
+                break;
+            }
+
+            submit_num -= u32(ret);
+        }
+
+        while (popCqe(&user_data, &result))
+            results[user_data] = result;
+
+        const u32 tail = *sq_tail;
+        for (u32 i = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE); i != tail; i++)
+            results[sqes[i & sq_mask].user_data] = cNotSubmitted;
+
+        *sq_tail = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+        return false;
+    }
+
+    bool popCqe(u64* user_data, s32* result)
+    {
+        const u32 head = *cq_head;
+        if (head == __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE))
+            return false;
+
+        const io_uring_cqe& cqe = cqes[head & cq_mask];
+        *user_data = cqe.user_data;
+        *result = cqe.res;
+
+        __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+};
+
+UringFileDevice::Ring* UringFileDevice::Ring::create()
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    const int fd = syscall(__NR_io_uring_setup, cEntryNum, &params);
+    if (fd < 0)
+        return nullptr;
+
+    // Check that the operations used are supported (io_uring_probe ends with an array of operations)
+    {
+        static const u8 cOp[] = { IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE };
+        static constexpr u32 cProbeOpNum = 64;
+
+        u8 probe_buf[sizeof(io_uring_probe) + cProbeOpNum * sizeof(io_uring_probe_op)];
+        std::memset(probe_buf, 0, sizeof(probe_buf));
+
+        io_uring_probe* probe = (io_uring_probe*)probe_buf;
+        bool supported = syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, cProbeOpNum) == 0;
+
+        for (u8 op : cOp)
+            supported = supported && op < probe->ops_len && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+
+        if (!supported)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+    }
+
+    Ring* ring = new Ring();
+    ring->fd = fd;
+    ring->sq_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+    ring->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+    // Both rings may share a single mapping
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+    {
+        if (ring->cq_size > ring->sq_size)
+            ring->sq_size = ring->cq_size;
+        ring->cq_size = ring->sq_size;
+    }
+
+    void* sq_ptr = mmap(nullptr, ring->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    void* cq_ptr = single_mmap ? sq_ptr
+                               : mmap(nullptr, ring->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    void* sqes = mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+
+    ring->sq_ptr = sq_ptr == MAP_FAILED ? nullptr : (u8*)sq_ptr;
+    ring->cq_ptr = cq_ptr == MAP_FAILED ? nullptr : (u8*)cq_ptr;
+    ring->sqes = sqes == MAP_FAILED ? nullptr : (io_uring_sqe*)sqes;
+
+    if (!ring->sq_ptr || !ring->cq_ptr || !ring->sqes)
+    {
+        delete ring;
+        return nullptr;
+    }
+
+    ring->sq_head = (u32*)(ring->sq_ptr + params.sq_off.head);
+    ring->sq_tail = (u32*)(ring->sq_ptr + params.sq_off.tail);
+    ring->sq_mask = *(u32*)(ring->sq_ptr + params.sq_off.ring_mask);
+    ring->sq_array = (u32*)(ring->sq_ptr + params.sq_off.array);
+    ring->cq_head = (u32*)(ring->cq_ptr + params.cq_off.head);
+    ring->cq_tail = (u32*)(ring->cq_ptr + params.cq_off.tail);
+    ring->cq_mask = *(u32*)(ring->cq_ptr + params.cq_off.ring_mask);
+    ring->cqes = (io_uring_cqe*)(ring->cq_ptr + params.cq_off.cqes);
+
+    return ring;
+}
+
+UringFileDevice::Ring::~Ring()
+{
+    if (sqes)
+        munmap(sqes, sqes_size);
+
+    if (cq_ptr && cq_ptr != sq_ptr)
+        munmap(cq_ptr, cq_size);
+
+    if (sq_ptr)
+        munmap(sq_ptr, sq_size);
+
+    ::close(fd);
+}
+
+UringFileDevice::UringFileDevice(const std::string& drive_name, const std::string& root_path)
+    : StdIOFileDevice(drive_name, root_path)
+    , mRing(Ring::create())
+{
+    if (!mRing)
+        RIO_LOG("UringFileDevice: io_uring is not available, files are read with pread().\n");
+}
+
+UringFileDevice::~UringFileDevice()
+{
+    delete mRing.load();
+}
+
+void UringFileDevice::dropRing_()
+{
+    RIO_LOG("UringFileDevice: Dropping the io_uring, files are read with pread() from now on.\n");
+
+    delete mRing.load();
+    mRing = nullptr;
+}
+
+#else
+
+UringFileDevice::UringFileDevice(const std::string& drive_name, const std::string& root_path)
+    : StdIOFileDevice(drive_name, root_path)
+    , mRing(nullptr)
+{
+}
+
+UringFileDevice::~UringFileDevice()
+{
+}
+
+#endif // RIO_FILE_URING_SUPPORTED
+
+u8* UringFileDevice::doLoad_(LoadArg& arg)
+{
+#if defined(_WIN32)
+    return StdIOFileDevice::doLoad_(arg);
+#else
+    if (arg.map && !arg.buffer)
+    {
+        u8* data = doMap_(arg);
+        if (data)
+            return data;
+    }
+
+    // A ring takes as many system calls as pread() for a single file
+    return loadPread_(arg);
+#endif // _WIN32
+}
+
+u32 UringFileDevice::doLoadBatch_(LoadArg* args, u8** data, u32 num)
+{
+#if RIO_FILE_URING_SUPPORTED
+    if (mRing)
+    {
+        // Other threads load their files one by one while the ring is in use
+        std::unique_lock<std::mutex> lock(mRingMutex, std::try_to_lock);
+        if (lock.owns_lock() && mRing)
+        {
+            u32 loaded_num = 0;
+
+            for (u32 i = 0; i < num; i += cBatchMaxNum)
+            {
+                const u32 group_num = std::min(num - i, cBatchMaxNum);
+
+                // (The ring may have been dropped by the previous group)
+                if (mRing)
+                    loaded_num += loadRing_(args + i, data + i, group_num);
+                else
+                    loaded_num += FileDevice::doLoadBatch_(args + i, data + i, group_num);
+            }
+
+            return loaded_num;
+        }
+    }
+#endif // RIO_FILE_URING_SUPPORTED
+
+    return FileDevice::doLoadBatch_(args, data, num);
+}
+
+#if RIO_FILE_URING_SUPPORTED
+
+u32 UringFileDevice::loadRing_(LoadArg* args, u8** data, u32 num)
+{
+    RIO_ASSERT(num <= cBatchMaxNum);
+
+    Ring& ring = *mRing.load();
+    u32 submit_num = 0;
+
+    // 1. Open the files
+    for (u32 i = 0; i < num; i++)
+    {
+        LoadArg& arg = args[i];
+        data[i] = nullptr;
+        ring.open_result[i] = -EBADF;
+
+        if (arg.map && !arg.buffer)
+        {
+            data[i] = doMap_(arg);
+            if (data[i])
+                continue;
+        }
+
+        ring.path[i] = getNativePath(arg.path);
+
+        io_uring_sqe* sqe = ring.getSqe();
+        sqe->opcode = IORING_OP_OPENAT;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = (uintptr_t)ring.path[i].c_str();
+        sqe->open_flags = O_RDONLY | O_CLOEXEC;
+        sqe->user_data = i;
+
+        ring.open_result[i] = Ring::cInFlight;
+        submit_num++;
+    }
+
+    if (submit_num == 0)
+        return num;
+
+    if (!ring.submitAndWait(submit_num, ring.open_result))
+    {
+        // Nothing was read yet: close the files opened, and load them all with pread() instead
+        // (The files still being opened are left to the kernel.)
+        for (u32 i = 0; i < num; i++)
+            if (ring.open_result[i] >= 0)
+                ::close(ring.open_result[i]);
+
+        dropRing_();
+
+        u32 loaded_num = 0;
+        for (u32 i = 0; i < num; i++)
+        {
+            if (!data[i])
+                data[i] = loadPread_(args[i]);
+
+            if (data[i])
+                loaded_num++;
+        }
+
+        return loaded_num;
+    }
+
+    // 2. Read them into their buffers
+    // (The sizes are read with fstat(): IORING_OP_STATX always runs on a kernel worker thread,
+    // which costs more than the system call for files whose inode is in memory once opened.)
+    submit_num = 0;
+
+    for (u32 i = 0; i < num; i++)
+    {
+        if (data[i])
+            continue;
+
+        LoadArg& arg = args[i];
+        const struct stat& st = ring.stat[i];
+
+        if (ring.open_result[i] < 0)
+        {
+            setLastRawErrorFromErrno_(-ring.open_result[i]);
+            continue;
+        }
+
+        if (fstat(ring.open_result[i], &ring.stat[i]) != 0)
+        {
+            setLastRawErrorFromErrno_(errno);
+            continue;
+        }
+
+        if (!S_ISREG(st.st_mode))
+        {
+            setLastRawError_(RAW_ERROR_NOT_FILE);
+            continue;
+        }
+
+        u8* buffer = allocBuffer_(arg, st.st_size);
+        if (!buffer)
+            continue;
+
+        data[i] = buffer;
+
+        io_uring_sqe* sqe = ring.getSqe();
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = ring.open_result[i];
+        sqe->addr = (uintptr_t)buffer;
+        sqe->len = u32(st.st_size);
+        sqe->off = 0;
+        sqe->user_data = i;
+
+        ring.read_result[i] = Ring::cInFlight;
+        submit_num++;
+    }
+
+    const bool ring_failed = submit_num != 0 && !ring.submitAndWait(submit_num, ring.read_result);
+
+    for (u32 i = 0; i < num; i++)
+    {
+        if (!data[i] || ring.open_result[i] < 0)
+            continue;
+
+        LoadArg& arg = args[i];
+        const u32 file_size = ring.stat[i].st_size;
+        s32 result = ring.read_result[i];
+
+        if (result == Ring::cInFlight)
+        {
+            // The kernel may still write into the buffer, so it is left to it
+            setLastRawError_(RAW_ERROR_FATAL_ERROR);
+            data[i] = nullptr;
+            arg.roundup_size = 0;
+            arg.need_unload = false;
+            continue;
+        }
+
+        // Finish short reads (files larger than what a single read can return),
+        // and the reads withdrawn from the ring after a failure
+        if (result == Ring::cNotSubmitted)
+            result = 0;
+
+        u32 read_size = result < 0 ? 0 : u32(result);
+        while (result >= 0 && read_size < file_size)
+        {
+            const ssize_t ret = pread(ring.open_result[i], data[i] + read_size, file_size - read_size, read_size);
+            if (ret < 0 && errno == EINTR)
+                continue;
+
+            if (ret <= 0)
+            {
+                result = ret < 0 ? -errno : 0;
+                break;
+            }
+
+            read_size += u32(ret);
+        }
+
+        if (result < 0)
+        {
+            setLastRawErrorFromErrno_(-result);
+
+            if (arg.need_unload)
+                MemUtil::free(data[i]);
+
+            data[i] = nullptr;
+            arg.roundup_size = 0;
+            arg.need_unload = false;
+            continue;
+        }
+
+        arg.read_size = read_size;
+    }
+
+    // 3. Close them (directly once the ring has failed)
+    if (ring_failed)
+    {
+        for (u32 i = 0; i < num; i++)
+            if (ring.open_result[i] >= 0)
+                ::close(ring.open_result[i]);
+
+        dropRing_();
+    }
+    else
+    {
+        submit_num = 0;
+
+        for (u32 i = 0; i < num; i++)
+        {
+            if (ring.open_result[i] < 0)
+                continue;
+
+            io_uring_sqe* sqe = ring.getSqe();
+            sqe->opcode = IORING_OP_CLOSE;
+            sqe->fd = ring.open_result[i];
+            sqe->user_data = i;
+
+            ring.close_result[i] = Ring::cInFlight;
+            submit_num++;
+        }
+
+        const bool closed = submit_num == 0 || ring.submitAndWait(submit_num, ring.close_result);
+
+        for (u32 i = 0; i < num; i++)
+        {
+            if (ring.open_result[i] < 0)
+                continue;
+
+            const s32 result = ring.close_result[i];
+            if (result == Ring::cNotSubmitted)
+                ::close(ring.open_result[i]);
+
+            else if (result < 0 && result != Ring::cInFlight)
+                RIO_LOG("UringFileDevice: Failed to close \"%s\": %s\n", ring.path[i].c_str(), std::strerror(-result));
+        }
+
+        if (!closed)
+            dropRing_();
+    }
+
+    u32 loaded_num = 0;
+    for (u32 i = 0; i < num; i++)
+        if (data[i])
+            loaded_num++;
+
+    if (loaded_num == num)
+        setLastRawError_(RAW_ERROR_OK);
+
+    return loaded_num;
+}
+
+#endif // RIO_FILE_URING_SUPPORTED
+
+#if !defined(_WIN32)
+
+u8* UringFileDevice::loadPread_(LoadArg& arg)
+{
+    const std::string file_path = getNativePath(arg.path);
+
+    const int fd = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        setLastRawErrorFromErrno_(errno);
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        setLastRawErrorFromErrno_(errno);
+        ::close(fd);
+        return nullptr;
+    }
+
+    if (!S_ISREG(st.st_mode))
+    {
+        setLastRawError_(RAW_ERROR_NOT_FILE);
+        ::close(fd);
+        return nullptr;
+    }
+
+    u8* buffer = allocBuffer_(arg, st.st_size);
+    if (!buffer)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const u32 file_size = st.st_size;
+    u32 read_size = 0;
+
+    while (read_size < file_size)
+    {
+        const ssize_t ret = pread(fd, buffer + read_size, file_size - read_size, read_size);
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            setLastRawErrorFromErrno_(errno);
+            ::close(fd);
+
+            if (arg.need_unload)
+                MemUtil::free(buffer);
+
+            arg.roundup_size = 0;
+            arg.need_unload = false;
+            return nullptr;
+        }
+
+        if (ret == 0)
+            break;
+
+        read_size += ret;
+    }
+
+    ::close(fd);
+
+    setLastRawError_(RAW_ERROR_OK);
+    arg.read_size = read_size;
+    return buffer;
+}
+
+#endif // _WIN32
+
+u8* UringFileDevice::allocBuffer_(LoadArg& arg, u64 file_size)
+{
+    if (arg.buffer && arg.buffer_size == 0)
+    {
+        RIO_LOG("UringFileDevice::allocBuffer_(): arg.buffer is specified, but arg.buffer_size is zero.\n");
+        return nullptr;
+    }
+
+    if (file_size == 0)
+    {
+        RIO_ASSERT(false);
+        return nullptr;
+    }
+
+    if (file_size > 0xFFFFFFFF - FileDevice::cBufferMinAlignment)
+    {
+        RIO_LOG("UringFileDevice::allocBuffer_(): \"%s\" is too big.\n", arg.path.c_str());
+        setLastRawError_(RAW_ERROR_FILE_TOO_BIG);
+        return nullptr;
+    }
+
+    u32 buffer_size = arg.buffer_size;
+    if (buffer_size == 0)
+        buffer_size = align(file_size, FileDevice::cBufferMinAlignment);
+
+    else if (buffer_size < file_size)
+    {
+        RIO_LOG("UringFileDevice::allocBuffer_(): arg.buffer_size[%u] is smaller than file size[%u].\n", buffer_size, u32(file_size));
+        return nullptr;
+    }
+
+    u8* buffer = arg.buffer;
+    bool need_unload = false;
+
+    if (!buffer)
+    {
+        const u32 alignment = arg.alignment > 1 ? arg.alignment : 1;
+        buffer = (u8*)MemUtil::alloc(buffer_size, align(alignment, FileDevice::cBufferMinAlignment), arg.heap_type);
+        need_unload = true;
+    }
+
+    arg.roundup_size = buffer_size;
+    arg.need_unload = need_unload;
+
+    return buffer;
+}
+
+void UringFileDevice::setLastRawErrorFromErrno_(int error)
+{
+    switch (error)
+    {
+    case ECANCELED:
+        setLastRawError_(RAW_ERROR_CANCELED);
+        break;
+    case ENOENT:
+    case ENOTDIR:
+        setLastRawError_(RAW_ERROR_NOT_FOUND);
+        break;
+    case EISDIR:
+        setLastRawError_(RAW_ERROR_NOT_FILE);
+        break;
+    case EINVAL:
+    case EROFS:
+    case ETXTBSY:
+        setLastRawError_(RAW_ERROR_ACCESS_ERROR);
+        break;
+    case EACCES:
+    case EPERM:
+        setLastRawError_(RAW_ERROR_PERMISSION_ERROR);
+        break;
+    case EFBIG:
+    case EOVERFLOW:
+        setLastRawError_(RAW_ERROR_FILE_TOO_BIG);
+        break;
+    default:
+        setLastRawError_(RAW_ERROR_FATAL_ERROR);
+        RIO_LOG("UringFileDevice: Unexpected error: %s\n", std::strerror(error));
+        break;
+    }
+}
+
+}
+
+#endif // RIO_IS_WIN
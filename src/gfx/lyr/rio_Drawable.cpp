@@ -2,16 +2,19 @@
 
 namespace rio { namespace lyr {
 
-DrawMethod::DrawMethod(IDrawable* obj_ptr, IDrawable::DrawMethod func_ptr, s32 priority)
+DrawMethod::DrawMethod(IDrawable* obj_ptr, IDrawable::DrawMethod func_ptr, s32 priority, u32 user_key)
     : mObjPtr(obj_ptr)
     , mFuncPtr(func_ptr)
     , mPriority(priority)
 {
+    // Flipping all bits but the sign bit maps greater priorities to smaller unsigned values
+    const u32 inv_priority = u32(priority) ^ 0x7FFFFFFF;
+    mSortKey = u64(inv_priority) << 32 | user_key;
 }
 
 bool DrawMethod::operator<(const DrawMethod& rhs) const
 {
-    return mPriority > rhs.mPriority;
+    return mSortKey < rhs.mSortKey;
 }
 
 } }
@@ -20,6 +20,65 @@ public:
 
 namespace rio { namespace lyr {
 
+void RenderStep::addDrawMethod_(const DrawMethod& draw_method)
+{
+    mDrawMethods.push_back(draw_method);
+    mIsSorted = false;
+}
+
+void RenderStep::clearDrawMethods_()
+{
+    mDrawMethods.clear();
+    mSortBuffer.clear();
+    mIsSorted = true;
+}
+
+void RenderStep::sort_() const
+{
+    if (mIsSorted)
+        return;
+
+    mIsSorted = true;
+
+    const size_t num = mDrawMethods.size();
+    if (num < 2)
+        return;
+
+    mSortBuffer = mDrawMethods;
+
+    DrawMethod* src = mDrawMethods.data();
+    DrawMethod* dst = mSortBuffer.data();
+
+    // LSD radix sort, 8 bits per pass (stable, so equal keys stay in insertion order)
+    for (u32 shift = 0; shift < 64; shift += 8)
+    {
+        size_t offset[256] = { };
+
+        for (size_t i = 0; i < num; i++)
+            offset[(src[i].sortKey() >> shift) & 0xFF]++;
+
+        // Skip the pass if all keys have the same value for this digit
+        if (offset[(src[0].sortKey() >> shift) & 0xFF] == num)
+            continue;
+
+        size_t sum = 0;
+        for (u32 digit = 0; digit < 256; digit++)
+        {
+            const size_t count = offset[digit];
+            offset[digit] = sum;
+            sum += count;
+        }
+
+        for (size_t i = 0; i < num; i++)
+            dst[offset[(src[i].sortKey() >> shift) & 0xFF]++] = src[i];
+
+        std::swap(src, dst);
+    }
+
+    if (src != mDrawMethods.data())
+        mDrawMethods.swap(mSortBuffer);
+}
+
 const Camera& Layer::defaultCamera()
 {
     static const IdentityCamera cDefaultCamera;
@@ -183,13 +242,13 @@ void Layer::addDrawMethod(u32 render_step_idx, const DrawMethod& draw_method)
         return;
     }
 
-    mRenderSteps[render_step_idx].mDrawMethods.insert(draw_method);
+    mRenderSteps[render_step_idx].addDrawMethod_(draw_method);
 }
 
 void Layer::addDrawMethodToAll(const DrawMethod& draw_method)
 {
     for (RenderStep& render_step : mRenderSteps)
-        render_step.mDrawMethods.insert(draw_method);
+        render_step.addDrawMethod_(draw_method);
 }
 
 void Layer::clearDrawMethods(u32 render_step_idx)
@@ -200,13 +259,13 @@ void Layer::clearDrawMethods(u32 render_step_idx)
         return;
     }
 
-    mRenderSteps[render_step_idx].mDrawMethods.clear();
+    mRenderSteps[render_step_idx].clearDrawMethods_();
 }
 
 void Layer::clearDrawMethodsAll()
 {
     for (RenderStep& render_step : mRenderSteps)
-        render_step.mDrawMethods.clear();
+        render_step.clearDrawMethods_();
 }
 
 } }
@@ -83,8 +83,16 @@ void Renderer::render() const
 
         for (const RenderStep& render_step : layer.mRenderSteps)
         {
-            for (const DrawMethod& draw_method : render_step.mDrawMethods)
+            render_step.sort_();
+
+            // Draw methods can add or clear draw methods of this render step, which may reallocate the array:
+            // walk it by index, up to its size before drawing (added draw methods are drawn from the next frame)
+            const size_t draw_method_num = render_step.mDrawMethods.size();
+            for (size_t i = 0; i < draw_method_num && i < render_step.mDrawMethods.size(); i++)
+            {
+                const DrawMethod draw_method = render_step.mDrawMethods[i];
                 (draw_method.mObjPtr->*(draw_method.mFuncPtr))({ layer, render_step_idx });
+            }
 
             render_step_idx++;
         }
@@ -26,23 +26,53 @@ void ModelCacher::destroySingleton()
 }
 
 ModelCacher::ModelCacher()
+    : mBudget(0)
+    , mSize(0)
+    , mHitNum(0)
+    , mMissNum(0)
+    , mEvictedNum(0)
 {
 }
 
 ModelCacher::~ModelCacher()
 {
     for (const auto& it : mModelCache)
-        MemUtil::free(it.second);
+    {
+        if (it.second.load_handle != AsyncLoader::cInvalidHandle)
+            FileDeviceMgr::instance()->cancelAsync(it.second.load_handle);
+        else
+            freeModel_(it.second);
+    }
 
     mModelCache.clear();
+    mLoadingKey.clear();
+    mLRUList.clear();
+    mSize = 0;
 }
 
-Model* ModelCacher::loadModel(const char* base_fname, const char* key)
+void ModelCacher::freeModel_(const Entry& entry)
 {
-    // Check if it exists
-    if (Model* model = get(key))
-        return model;
+    if (entry.is_mapped)
+        FileDeviceMgr::unmap((u8*)entry.model, entry.size);
+    else
+        FileDeviceMgr::unload((u8*)entry.model);
+}
+
+void ModelCacher::erase_(Cache::iterator it)
+{
+    const Entry& entry = it->second;
+    RIO_ASSERT(entry.ref_count == 0);
+
+    mSize -= entry.size;
+    freeModel_(entry);
 
+    mLRUList.erase(entry.lru_it);
+    mModelCache.erase(it);
+    mEvictedNum++;
+}
+
+FileDevice::LoadArg ModelCacher::makeLoadArg_(const char* base_fname)
+{
     FileDevice::LoadArg arg;
 #if RIO_IS_WIN
     arg.path = std::string("models/") + base_fname + "_LE.rmdl";
@@ -52,10 +82,26 @@ Model* ModelCacher::loadModel(const char* base_fname, const char* key)
     arg.path = std::string("models/") + base_fname + ".rmdl";
 #endif
     arg.alignment = Drawer::cVtxAlignment;
+    arg.heap_type = MemUtil::HEAP_TYPE_MODEL;
+#if RIO_IS_WIN
+    // The data is uploaded to the GPU by mdl::Mesh, so the CPU side is only read
+    arg.map = true;
+#endif // RIO_IS_WIN
+
+    return arg;
+}
+
+Model* ModelCacher::checkModel_(u8* file, const FileDevice::LoadArg& arg)
+{
+    if (arg.read_size < sizeof(Model))
+    {
+        if (arg.is_mapped)
+            FileDeviceMgr::unmap(file, arg.read_size);
+        else if (arg.need_unload)
+            FileDeviceMgr::unload(file);
 
-    u8* const file = FileDeviceMgr::instance()->tryLoad(arg);
-    if (!file || arg.read_size < sizeof(Model))
         return nullptr;
+    }
 
     Model* model = (Model*)file;
 
@@ -73,17 +119,199 @@ Model* ModelCacher::loadModel(const char* base_fname, const char* key)
 
     RIO_ASSERT(model->mFileSize == arg.read_size);
 
-    auto it = mModelCache.try_emplace(key, model);
-    return it.first->second;
+    return model;
+}
+
+void ModelCacher::addModel_(Entry& entry, Model* model, bool is_mapped)
+{
+    entry.model = model;
+    entry.size = model->mFileSize;
+    entry.is_mapped = is_mapped;
+    entry.load_handle = AsyncLoader::cInvalidHandle;
+
+    mSize += model->mFileSize;
+
+    // The new model may push the cache over the budget
+    trim(mBudget);
+}
+
+Model* ModelCacher::loadModel(const char* base_fname, const char* key)
+{
+    // Check if it exists
+    auto it = mModelCache.find(key);
+    if (it != mModelCache.end())
+    {
+        Entry& entry = it->second;
+        if (entry.ref_count++ == 0)
+        {
+            mLRUList.erase(entry.lru_it);
+            entry.lru_it = mLRUList.end();
+        }
+
+        mHitNum++;
+
+        if (entry.load_handle == AsyncLoader::cInvalidHandle)
+            return entry.model;
+
+        // Being loaded asynchronously, which adds it to the cache (or removes the entry on failure)
+        FileDeviceMgr::instance()->getAsyncLoader().wait(entry.load_handle);
+        return get(key);
+    }
+
+    mMissNum++;
+
+    FileDevice::LoadArg arg = makeLoadArg_(base_fname);
+
+    u8* const file = FileDeviceMgr::instance()->tryLoad(arg);
+    if (!file)
+        return nullptr;
+
+    Model* model = checkModel_(file, arg);
+    if (!model)
+        return nullptr;
+
+    auto result = mModelCache.try_emplace(key, Entry{ nullptr, 0, false, 1, mLRUList.end(), AsyncLoader::cInvalidHandle });
+    addModel_(result.first->second, model, arg.is_mapped);
+
+    return model;
+}
+
+void ModelCacher::loadModelAsync(const char* base_fname, const char* key, s32 priority)
+{
+    auto it = mModelCache.find(key);
+    if (it != mModelCache.end())
+    {
+        Entry& entry = it->second;
+        if (entry.ref_count++ == 0)
+        {
+            mLRUList.erase(entry.lru_it);
+            entry.lru_it = mLRUList.end();
+        }
+
+        mHitNum++;
+        return;
+    }
+
+    mMissNum++;
+
+    const AsyncLoader::Handle handle = FileDeviceMgr::instance()->loadAsync(makeLoadArg_(base_fname), &ModelCacher::onModelLoaded_, this, priority);
+
+    mModelCache.try_emplace(key, Entry{ nullptr, 0, false, 1, mLRUList.end(), handle });
+    mLoadingKey.try_emplace(handle, key);
+}
+
+bool ModelCacher::isLoading(const char* key) const
+{
+    auto it = mModelCache.find(key);
+    return it != mModelCache.end() && it->second.load_handle != AsyncLoader::cInvalidHandle;
+}
+
+void ModelCacher::onModelLoaded_(AsyncLoader::Handle handle, const FileDevice::LoadArg& arg, u8* data, void* user_data)
+{
+    ModelCacher* cacher = static_cast<ModelCacher*>(user_data);
+
+    auto key_it = cacher->mLoadingKey.find(handle);
+    RIO_ASSERT(key_it != cacher->mLoadingKey.end());
+
+    auto it = cacher->mModelCache.find(key_it->second);
+    RIO_ASSERT(it != cacher->mModelCache.end());
+
+    cacher->mLoadingKey.erase(key_it);
+
+    Model* model = data ? checkModel_(data, arg) : nullptr;
+    if (!model)
+    {
+        RIO_LOG("ModelCacher: Failed to load model \"%s\".\n", it->first.c_str());
+        cacher->mModelCache.erase(it);
+        return;
+    }
+
+    cacher->addModel_(it->second, model, arg.is_mapped);
+}
+
+void ModelCacher::releaseModel(const char* key)
+{
+    auto it = mModelCache.find(key);
+    if (it == mModelCache.end())
+    {
+        RIO_LOG("ModelCacher::releaseModel(): Model \"%s\" is not in the cache.\n", key);
+        RIO_ASSERT(false);
+        return;
+    }
+
+    Entry& entry = it->second;
+    RIO_ASSERT(entry.ref_count > 0);
+
+    if (--entry.ref_count == 0)
+    {
+        if (entry.load_handle != AsyncLoader::cInvalidHandle)
+        {
+            // Not loaded yet
+            FileDeviceMgr::instance()->cancelAsync(entry.load_handle);
+            mLoadingKey.erase(entry.load_handle);
+            mModelCache.erase(it);
+            return;
+        }
+
+        entry.lru_it = mLRUList.insert(mLRUList.begin(), it->first);
+        trim(mBudget);
+    }
 }
 
 Model* ModelCacher::get(const char* key) const
 {
     auto it = mModelCache.find(key);
     if (it != mModelCache.end())
-        return it->second;
+        return it->second.model;
 
     return nullptr;
 }
 
+bool ModelCacher::unload(const char* key)
+{
+    auto it = mModelCache.find(key);
+    if (it == mModelCache.end())
+        return true;
+
+    if (it->second.ref_count > 0)
+        return false;
+
+    erase_(it);
+    return true;
+}
+
+void ModelCacher::trim(size_t size)
+{
+    while (mSize > size && !mLRUList.empty())
+    {
+        auto it = mModelCache.find(mLRUList.back());
+        RIO_ASSERT(it != mModelCache.end());
+
+        erase_(it);
+    }
+}
+
+void ModelCacher::setBudget(size_t budget)
+{
+    mBudget = budget;
+    trim(mBudget);
+}
+
+void ModelCacher::discardMeshData(const char* key) const
+{
+    auto it = mModelCache.find(key);
+    if (it == mModelCache.end() || !it->second.is_mapped)
+        return;
+
+    const Model& model = *it->second.model;
+
+    for (u32 i = 0; i < model.numMeshes(); i++)
+    {
+        const Mesh& mesh = model.mesh(i);
+
+        FileDevice::discardMappedPages((const u8*)mesh.vertexBuffer().ptr(), mesh.vertexBuffer().size());
+        FileDevice::discardMappedPages((const u8*)mesh.indexBuffer().ptr(), mesh.indexBuffer().size());
+    }
+}
+
 } } }
@@ -2,6 +2,8 @@
 #include <gfx/mdl/rio_Mesh.h>
 #include <gfx/mdl/rio_Model.h>
 #include <gpu/rio_Drawer.h>
+#include <gpu/rio_ShaderCacher.h>
+#include <gpu/rio_TextureCacher.h>
 #include <misc/rio_MemUtil.h>
 
 namespace rio { namespace mdl {
@@ -11,6 +13,7 @@ Material::Material(const res::Material* res_material, Model* parent_mdl)
     , mParentModel(*parent_mdl)
     , mTextures(nullptr)
     , mUniformVars(nullptr)
+    , mIsShaderSetup(false)
 {
     RIO_ASSERT(parent_mdl && res_material);
 
@@ -28,9 +31,9 @@ Material::Material(const res::Material* res_material, Model* parent_mdl)
     else
         mShaderMode = Shader::MODE_INVALID;
 
-    // TODO: Shader cacher
-    mShader = new Shader();
-    mShader->load(mResMaterial.shaderName(), mShaderMode);
+    // The shader locations are only needed once the material is bound, so do not wait for the shader
+    // to be compiled, in order to overlap its compilation with the creation of other materials
+    mShader = ShaderCacher::instance()->loadShaderAsync(mResMaterial.shaderName(), mShaderMode);
 
     mNumTextures = mResMaterial.numTextures();
     if (mNumTextures > 0)
@@ -41,17 +44,12 @@ Material::Material(const res::Material* res_material, Model* parent_mdl)
         for (u32 i = 0; i < mNumTextures; i++)
         {
             const char* const texture_name = textures[i].name();
-            const char* const sampler_name = textures[i].samplerName();
 
             Texture& texture = mTextures[i];
 
-            // TODO: Texture cacher
-            texture.mpTexture = new Texture2D(texture_name);
+            texture.mpTexture = TextureCacher::instance()->loadTexture(texture_name);
             texture.mTextureSampler.linkTexture2D(texture.mpTexture);
 
-            texture.mVSLocation = mShader->getVertexSamplerLocation(sampler_name);
-            texture.mFSLocation = mShader->getFragmentSamplerLocation(sampler_name);
-
             textures[i].initTextureSampler(texture.mTextureSampler);
         }
     }
@@ -67,34 +65,26 @@ Material::Material(const res::Material* res_material, Model* parent_mdl)
             UniformVar& uniform_var = mUniformVars[i];
             const res::UniformVar& res_uniform_var = uniform_vars[i];
 
-            const char* const uniform_name = res_uniform_var.name();
-
             uniform_var.mType    = res_uniform_var.type();
             uniform_var.mpBuf    = res_uniform_var.values().ptr();
             uniform_var.mBufSize = res_uniform_var.values().size();
-
-            uniform_var.mVSLocation = mShader->getVertexUniformLocation(uniform_name);
-            uniform_var.mFSLocation = mShader->getFragmentUniformLocation(uniform_name);
         }
     }
 
     mNumUniformBlocks = mResMaterial.numUniformBlocks();
     if (mNumUniformBlocks > 0)
     {
-        mUniformBlocks = (UniformBlock*)MemUtil::alloc(mNumUniformBlocks * sizeof(UniformBlock), 4);
+        mUniformBlocks = (UniformBlock*)MemUtil::alloc(mNumUniformBlocks * sizeof(UniformBlock), 4, MemUtil::HEAP_TYPE_MODEL);
         const res::UniformBlock* const uniform_blocks = mResMaterial.uniformBlocks();
 
         for (u32 i = 0; i < mNumUniformBlocks; i++)
         {
             const res::UniformBlock& res_uniform_block = uniform_blocks[i];
 
-            u32 vs_index = mShader->getVertexUniformBlockIndex(res_uniform_block.name());
-            u32 fs_index = mShader->getFragmentUniformBlockIndex(res_uniform_block.name());
-
-            new (&mUniformBlocks[i]) UniformBlock(res_uniform_block.stage(), vs_index, fs_index);
+            new (&mUniformBlocks[i]) UniformBlock(res_uniform_block.stage());
             UniformBlock& uniform_block = mUniformBlocks[i];
 
-            uniform_block.setData(MemUtil::alloc(res_uniform_block.size(), Drawer::cUniformBlockAlignment),
+            uniform_block.setData(MemUtil::alloc(res_uniform_block.size(), Drawer::cUniformBlockAlignment, MemUtil::HEAP_TYPE_MODEL),
                                   res_uniform_block.size());
 
             const res::UniformVar* const uniform_vars = res_uniform_block.uniforms().ptr();
@@ -112,12 +102,14 @@ Material::Material(const res::Material* res_material, Model* parent_mdl)
 
 Material::~Material()
 {
-    delete mShader;
+    ShaderCacher::instance()->releaseShader(mResMaterial.shaderName(), mShaderMode);
 
     if (mNumTextures > 0)
     {
+        const res::TextureRef* const textures = mResMaterial.textures();
+
         for (u32 i = 0; i < mNumTextures; i++)
-            delete mTextures[i].mpTexture;
+            TextureCacher::instance()->releaseTexture(textures[i].name());
 
         delete[] mTextures;
     }
@@ -142,8 +134,61 @@ void Material::pushBackMesh_(Mesh* mesh)
     mMeshes.push_back(mesh);
 }
 
+bool Material::isReady() const
+{
+    if (!mShader->isReady())
+        return false;
+
+    setupShaderLocations_();
+
+    for (u32 i = 0; i < mNumTextures; i++)
+        if (!mTextures[i].texture()->isReady())
+            return false;
+
+    return true;
+}
+
+void Material::setupShaderLocations_() const
+{
+    if (mIsShaderSetup)
+        return;
+
+    const res::TextureRef* const textures = mResMaterial.textures();
+    for (u32 i = 0; i < mNumTextures; i++)
+    {
+        const char* const sampler_name = textures[i].samplerName();
+
+        Texture& texture = mTextures[i];
+        texture.mVSLocation = mShader->getVertexSamplerLocation(sampler_name);
+        texture.mFSLocation = mShader->getFragmentSamplerLocation(sampler_name);
+    }
+
+    const res::UniformVar* const uniform_vars = mResMaterial.uniformVars();
+    for (u32 i = 0; i < mNumUniformVars; i++)
+    {
+        const char* const uniform_name = uniform_vars[i].name();
+
+        UniformVar& uniform_var = mUniformVars[i];
+        uniform_var.mVSLocation = mShader->getVertexUniformLocation(uniform_name);
+        uniform_var.mFSLocation = mShader->getFragmentUniformLocation(uniform_name);
+    }
+
+    const res::UniformBlock* const uniform_blocks = mResMaterial.uniformBlocks();
+    for (u32 i = 0; i < mNumUniformBlocks; i++)
+    {
+        const char* const uniform_block_name = uniform_blocks[i].name();
+
+        mUniformBlocks[i].setIndex(mShader->getVertexUniformBlockIndex(uniform_block_name),
+                                   mShader->getFragmentUniformBlockIndex(uniform_block_name));
+    }
+
+    mIsShaderSetup = true;
+}
+
 void Material::bind() const
 {
+    setupShaderLocations_();
+
     mRenderState.apply();
     mShader->bind();
 
@@ -5,16 +5,16 @@
 
 namespace rio { namespace mdl {
 
-Mesh::Mesh(const res::Mesh* res_mesh, Model* parent_mdl)
+Mesh::Mesh(const res::Mesh* res_mesh, Model* parent_mdl, Matrix34f* local_mtx, Matrix34f* world_mtx)
     : mResMesh(*res_mesh)
     , mParentModel(*parent_mdl)
+    , mLocalMtx(local_mtx)
+    , mWorldMtx(world_mtx)
 {
     RIO_ASSERT(parent_mdl && res_mesh);
+    RIO_ASSERT(local_mtx && world_mtx);
 
-    mIdxBuf = mResMesh.indexBuffer().ptr();
-    mIdxNum = mResMesh.indexBuffer().count();
-
-    VertexBuffer::invalidateCache(mIdxBuf, mResMesh.indexBuffer().size());
+    mIBO.setDataInvalidate(mResMesh.indexBuffer().ptr(), mResMesh.indexBuffer().count());
 
     mVBO.setStride(sizeof(res::Vertex));
     mVBO.setDataInvalidate(mResMesh.vertexBuffer().ptr(), mResMesh.vertexBuffer().size());
@@ -26,8 +26,11 @@ Mesh::Mesh(const res::Mesh* res_mesh, Model* parent_mdl)
     mVAO.addAttribute(mPosStream, mVBO);
     mVAO.addAttribute(mTexCoordStream, mVBO);
     mVAO.addAttribute(mNormalStream, mVBO);
+    mVAO.setIndexBuffer(&mIBO);
     mVAO.process();
 
+    mLocalBounds.set(&mResMesh.vertexBuffer().ptr()->pos, mResMesh.vertexBuffer().count(), sizeof(res::Vertex));
+
     calcLocalMtx_();
     calcWorldMtx_(Matrix34f::ident);
 }
@@ -35,9 +38,32 @@ Mesh::Mesh(const res::Mesh* res_mesh, Model* parent_mdl)
 void Mesh::draw() const
 {
     mVAO.bind();
-    Drawer::DrawElements(Drawer::TRIANGLES, mIdxNum, mIdxBuf);
+    Drawer::DrawElements(Drawer::TRIANGLES, mIBO);
+}
+
+bool Mesh::draw(const Frustum& frustum) const
+{
+    if (!isVisible(frustum))
+        return false;
+
+    draw();
+    return true;
+}
+
+#if RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+void Mesh::drawInstanced() const
+{
+    const u32 instance_num = mParentModel.numInstances();
+    if (instance_num == 0)
+        return;
+
+    mVAO.bind();
+    Drawer::DrawElementsInstanced(Drawer::TRIANGLES, mIBO, mIBO.getCount(), instance_num);
 }
 
+#endif // RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
 void Mesh::setMaterial_(Material* material)
 {
     mMaterial = material;
@@ -45,7 +71,7 @@ void Mesh::setMaterial_(Material* material)
 
 void Mesh::calcLocalMtx_()
 {
-    mLocalMtx.makeSRT(
+    mLocalMtx->makeSRT(
         mResMesh.scale(),
         mResMesh.rotation(),
         mResMesh.translation()
@@ -54,7 +80,33 @@ void Mesh::calcLocalMtx_()
 
 void Mesh::calcWorldMtx_(const Matrix34f& mdl_world_mtx)
 {
-    mWorldMtx.setMul(mdl_world_mtx, mLocalMtx);
+    mWorldMtx->setMul(mdl_world_mtx, *mLocalMtx);
+    calcWorldBounds_();
+}
+
+void Mesh::calcWorldBounds_()
+{
+    mWorldBounds.setTransform(*mWorldMtx, mLocalBounds);
 }
 
+#if RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+void Mesh::enableInstancing_(VertexBuffer& instance_vbo, VertexStream* instance_mtx_stream)
+{
+    // The instance matrix streams of the model are added to the buffer by the first mesh only,
+    // the other meshes use the buffer with the streams already in it
+    if (instance_mtx_stream)
+    {
+        for (u32 i = 0; i < 3; i++)
+            mVAO.addAttribute(instance_mtx_stream[i], instance_vbo);
+    }
+    else
+    {
+        mVAO.addVertexBuffer(instance_vbo);
+    }
+    mVAO.process();
+}
+
+#endif // RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
 } }
@@ -1,6 +1,7 @@
 #include <gfx/mdl/rio_Material.h>
 #include <gfx/mdl/rio_Mesh.h>
 #include <gfx/mdl/rio_Model.h>
+#include <math/rio_TransformBatch.h>
 #include <misc/rio_MemUtil.h>
 
 #include <new>
@@ -10,25 +11,33 @@ namespace rio { namespace mdl {
 Model::Model(const res::Model* res_mdl)
     : mResModel(*res_mdl)
     , mMeshes(nullptr)
+    , mMeshLocalMtx(nullptr)
+    , mMeshWorldMtx(nullptr)
     , mMaterials(nullptr)
     , mModelMtx{Matrix34f::ident}
+    , mInstanceVBO(1)
+    , mNumInstances(0)
 {
     RIO_ASSERT(res_mdl);
 
     mNumMeshes = mResModel.numMeshes();
     if (mNumMeshes > 0)
     {
-        mMeshes = (Mesh*)MemUtil::alloc(sizeof(Mesh) * mNumMeshes, 4);
+        mMeshes = (Mesh*)MemUtil::alloc(sizeof(Mesh) * mNumMeshes, 4, MemUtil::HEAP_TYPE_MODEL);
         const res::Mesh* const meshes = mResModel.meshes();
 
+        // Mesh matrices are kept in contiguous arrays, so that they are updated in batch
+        mMeshLocalMtx = (Matrix34f*)MemUtil::alloc(sizeof(Matrix34f) * mNumMeshes * 2, 16, MemUtil::HEAP_TYPE_MODEL);
+        mMeshWorldMtx = mMeshLocalMtx + mNumMeshes;
+
         for (u32 i = 0; i < mNumMeshes; i++)
-            new (&mMeshes[i]) Mesh(&meshes[i], this);
+            new (&mMeshes[i]) Mesh(&meshes[i], this, &mMeshLocalMtx[i], &mMeshWorldMtx[i]);
     }
 
     mNumMaterials = mResModel.numMaterials();
     if (mNumMaterials > 0)
     {
-        mMaterials = (Material*)MemUtil::alloc(sizeof(Material) * mNumMaterials, 4);
+        mMaterials = (Material*)MemUtil::alloc(sizeof(Material) * mNumMaterials, 4, MemUtil::HEAP_TYPE_MODEL);
         const res::Material* const materials = mResModel.materials();
 
         for (u32 i = 0; i < mNumMaterials; i++)
@@ -58,6 +67,7 @@ Model::~Model()
             mMeshes[i].~Mesh();
 
         MemUtil::free(mMeshes);
+        MemUtil::free(mMeshLocalMtx);
     }
 
     if (mNumMaterials > 0)
@@ -69,12 +79,98 @@ Model::~Model()
     }
 }
 
+#if RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+void Model::setInstanceWorldMtx(const Matrix34f* mtx, u32 num)
+{
+    mNumInstances = num;
+    if (num == 0)
+        return;
+
+    RIO_ASSERT(mtx);
+
+    // Instancing is enabled on first use, so that models drawn normally do not
+    // carry the instance attributes
+    if (mInstanceVBO.getStride() == 0)
+    {
+        mInstanceVBO.setStride(sizeof(Matrix34f));
+        mInstanceVBO.setInstanceStepRate(1);
+        mInstanceVBO.setDataInvalidate(mtx, sizeof(Matrix34f) * num);
+
+        for (u32 i = 0; i < 3; i++)
+            mInstanceMtxStream[i].setLayout(cInstanceMtxLocation + i, VertexStream::FORMAT_32_32_32_32_FLOAT, sizeof(BaseVec4f) * i);
+
+        for (u32 i = 0; i < mNumMeshes; i++)
+            mMeshes[i].enableInstancing_(mInstanceVBO, i == 0 ? mInstanceMtxStream : nullptr);
+    }
+    else
+    {
+        mInstanceVBO.setDataInvalidate(mtx, sizeof(Matrix34f) * num);
+    }
+}
+
+#endif // RIO_IS_CAFE || !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+u32 Model::draw(const Frustum& frustum, MeshDrawCallback callback, void* user_data) const
+{
+    u32 drawn_num = 0;
+
+    if (mNumMaterials == 0)
+    {
+        for (u32 i = 0; i < mNumMeshes; i++)
+        {
+            const Mesh& mesh = mMeshes[i];
+            if (!mesh.isVisible(frustum))
+                continue;
+
+            if (callback)
+                (*callback)(mesh, user_data);
+
+            mesh.draw();
+            drawn_num++;
+        }
+
+        return drawn_num;
+    }
+
+    for (u32 i = 0; i < mNumMaterials; i++)
+    {
+        const Material& material = mMaterials[i];
+        bool bound = false;
+
+        for (const Mesh* mesh : material.meshes())
+        {
+            if (!mesh->isVisible(frustum))
+                continue;
+
+            if (!bound)
+            {
+                material.bind();
+                bound = true;
+            }
+
+            if (callback)
+                (*callback)(*mesh, user_data);
+
+            mesh->draw();
+            drawn_num++;
+        }
+    }
+
+    return drawn_num;
+}
+
 void Model::setModelWorldMtx(const Matrix34f& srt)
 {
     mModelMtx = srt;
 
+    // Mesh matrices are kept as arrays rather than Mtx34SoA batches: each mesh uses its world matrix
+    // as a Matrix34f, and converting the batch back costs as much as the batch kernel saves for the
+    // mesh counts of typical models (see bench/TransformBatchBench.cpp)
+    TransformBatchf::mul(mMeshWorldMtx, mModelMtx, mMeshLocalMtx, mNumMeshes);
+
     for (u32 i = 0; i < mNumMeshes; i++)
-        mMeshes[i].calcWorldMtx_(srt);
+        mMeshes[i].calcWorldBounds_();
 }
 
 } }
@@ -0,0 +1,269 @@
+#include <gfx/mdl/rio_Model.h>
+#include <gfx/mdl/rio_TransformGraph.h>
+
+#include <algorithm>
+
+namespace rio { namespace mdl {
+
+TransformGraph::TransformGraph()
+    : mUpdatedNum(0)
+{
+}
+
+void TransformGraph::reserve(u32 num)
+{
+    mNodes.reserve(num);
+    mLocalMtx.reserve(num);
+    mWorldMtx.reserve(num);
+    mIndex.reserve(num);
+}
+
+TransformGraph::NodeID TransformGraph::createNode(NodeID parent)
+{
+    const u32 index = parent == cInvalidNode ? mNodes.size()
+                                             : index_(parent) + mNodes[index_(parent)].subtree_size;
+
+    NodeID id;
+    if (!mFreeID.empty())
+    {
+        id = mFreeID.back();
+        mFreeID.pop_back();
+    }
+    else
+    {
+        id = mIndex.size();
+        mIndex.push_back(cInvalidIndex);
+    }
+
+    Node node;
+    node.id = id;
+    node.parent = parent;
+    node.subtree_size = 1;
+    node.model = nullptr;
+    node.scale.set(1.0f, 1.0f, 1.0f);
+    node.rotate.set(0.0f, 0.0f, 0.0f);
+    node.translate.set(0.0f, 0.0f, 0.0f);
+    node.local_dirty = false;
+    node.dirty = false;
+
+    mNodes.insert(mNodes.begin() + index, node);
+    mLocalMtx.insert(mLocalMtx.begin() + index, Matrix34f::ident);
+    mWorldMtx.insert(mWorldMtx.begin() + index, Matrix34f::ident);
+
+    addSubtreeSize_(parent, 1);
+    updateIndices_(index, mNodes.size());
+
+    markDirty(id);
+    return id;
+}
+
+void TransformGraph::destroyNode(NodeID node)
+{
+    const u32 index = index_(node);
+    const u32 num = mNodes[index].subtree_size;
+
+    for (u32 i = index; i < index + num; i++)
+    {
+        mIndex[mNodes[i].id] = cInvalidIndex;
+        mFreeID.push_back(mNodes[i].id);
+    }
+
+    addSubtreeSize_(mNodes[index].parent, -s32(num));
+
+    mNodes.erase(mNodes.begin() + index, mNodes.begin() + index + num);
+    mLocalMtx.erase(mLocalMtx.begin() + index, mLocalMtx.begin() + index + num);
+    mWorldMtx.erase(mWorldMtx.begin() + index, mWorldMtx.begin() + index + num);
+
+    updateIndices_(index, mNodes.size());
+}
+
+void TransformGraph::setParent(NodeID node, NodeID parent)
+{
+    const u32 index = index_(node);
+    const u32 num = mNodes[index].subtree_size;
+
+    if (mNodes[index].parent == parent)
+        return;
+
+    addSubtreeSize_(mNodes[index].parent, -s32(num));
+
+    // Destination, as an index in the arrays without the subtree
+    u32 dst;
+    if (parent == cInvalidNode)
+    {
+        dst = mNodes.size() - num;
+    }
+    else
+    {
+        u32 parent_index = index_(parent);
+        RIO_ASSERT(parent_index < index || parent_index >= index + num);
+
+        if (parent_index > index)
+            parent_index -= num;
+
+        dst = parent_index + mNodes[index_(parent)].subtree_size;
+    }
+
+    moveRange_(index, num, dst);
+    updateIndices_(std::min(index, dst), std::max(index, dst) + num);
+
+    mNodes[dst].parent = parent;
+    addSubtreeSize_(parent, num);
+
+    markDirty(node);
+}
+
+void TransformGraph::setSRT(NodeID node, const Vector3f& s, const Vector3f& r, const Vector3f& t)
+{
+    Node& n = mNodes[index_(node)];
+    n.scale = s;
+    n.rotate = r;
+    n.translate = t;
+    n.local_dirty = true;
+
+    markDirty(node);
+}
+
+void TransformGraph::setScale(NodeID node, const Vector3f& s)
+{
+    Node& n = mNodes[index_(node)];
+    n.scale = s;
+    n.local_dirty = true;
+
+    markDirty(node);
+}
+
+void TransformGraph::setRotation(NodeID node, const Vector3f& r)
+{
+    Node& n = mNodes[index_(node)];
+    n.rotate = r;
+    n.local_dirty = true;
+
+    markDirty(node);
+}
+
+void TransformGraph::setTranslation(NodeID node, const Vector3f& t)
+{
+    Node& n = mNodes[index_(node)];
+    n.translate = t;
+    n.local_dirty = true;
+
+    markDirty(node);
+}
+
+void TransformGraph::setModel(NodeID node, Model* model)
+{
+    mNodes[index_(node)].model = model;
+
+    if (model)
+        markDirty(node);
+}
+
+void TransformGraph::markDirty(NodeID node)
+{
+    Node& n = mNodes[index_(node)];
+    if (n.dirty)
+        return;
+
+    n.dirty = true;
+    mDirtyNode.push_back(node);
+}
+
+void TransformGraph::update()
+{
+    mUpdatedNum = 0;
+
+    mDirtyIndex.clear();
+    for (NodeID node : mDirtyNode)
+    {
+        // Skip destroyed nodes, and IDs listed twice after having been destroyed and reused
+        if (!isValid(node))
+            continue;
+
+        const u32 index = mIndex[node];
+        if (!mNodes[index].dirty)
+            continue;
+
+        mNodes[index].dirty = false;
+        mDirtyIndex.push_back(index);
+    }
+    mDirtyNode.clear();
+
+    // Parents come before their children, so the subtrees are recomputed top-down,
+    // and dirty nodes in a subtree which was already recomputed are skipped
+    std::sort(mDirtyIndex.begin(), mDirtyIndex.end());
+
+    u32 end = 0;
+
+    for (u32 dirty_index : mDirtyIndex)
+    {
+        if (dirty_index < end)
+            continue;
+
+        end = dirty_index + mNodes[dirty_index].subtree_size;
+
+        for (u32 i = dirty_index; i < end; i++)
+        {
+            Node& n = mNodes[i];
+
+            if (n.local_dirty)
+            {
+                mLocalMtx[i].makeSRT(n.scale, n.rotate, n.translate);
+                n.local_dirty = false;
+            }
+
+            if (n.parent == cInvalidNode)
+                mWorldMtx[i] = mLocalMtx[i];
+            else
+                mWorldMtx[i].setMul(mWorldMtx[mIndex[n.parent]], mLocalMtx[i]);
+
+            if (n.model)
+                n.model->setModelWorldMtx(mWorldMtx[i]);
+        }
+
+        mUpdatedNum += end - dirty_index;
+    }
+}
+
+void TransformGraph::moveRange_(u32 first, u32 num, u32 dst)
+{
+    if (dst == first)
+        return;
+
+    // Rotate the range with the nodes between it and its destination
+    u32 begin, middle, end;
+    if (dst < first)
+    {
+        begin = dst;
+        middle = first;
+        end = first + num;
+    }
+    else
+    {
+        begin = first;
+        middle = first + num;
+        end = dst + num;
+    }
+
+    std::rotate(mNodes.begin() + begin, mNodes.begin() + middle, mNodes.begin() + end);
+    std::rotate(mLocalMtx.begin() + begin, mLocalMtx.begin() + middle, mLocalMtx.begin() + end);
+    std::rotate(mWorldMtx.begin() + begin, mWorldMtx.begin() + middle, mWorldMtx.begin() + end);
+}
+
+void TransformGraph::addSubtreeSize_(NodeID node, s32 num)
+{
+    while (node != cInvalidNode)
+    {
+        Node& n = mNodes[index_(node)];
+        n.subtree_size += num;
+        node = n.parent;
+    }
+}
+
+void TransformGraph::updateIndices_(u32 first, u32 end)
+{
+    for (u32 i = first; i < end; i++)
+        mIndex[mNodes[i].id] = i;
+}
+
+} }
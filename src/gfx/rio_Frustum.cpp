@@ -0,0 +1,200 @@
+#include <gfx/rio_Camera.h>
+#include <gfx/rio_Frustum.h>
+#include <gfx/rio_Projection.h>
+#include <math/rio_Math.h>
+
+namespace rio {
+
+void Bounds::set(const BaseVec3f* points, u32 num, u32 stride)
+{
+    if (num == 0)
+    {
+        min.set(0.0f, 0.0f, 0.0f);
+        max.set(0.0f, 0.0f, 0.0f);
+        center.set(0.0f, 0.0f, 0.0f);
+        radius = 0.0f;
+        return;
+    }
+
+    RIO_ASSERT(points);
+
+    const u8* p = (const u8*)points;
+
+    min = static_cast<const Vector3f&>(*points);
+    max = min;
+
+    for (u32 i = 1; i < num; i++)
+    {
+        const BaseVec3f& v = *(const BaseVec3f*)(p + stride * i);
+
+        if (v.x < min.x) min.x = v.x;
+        if (v.y < min.y) min.y = v.y;
+        if (v.z < min.z) min.z = v.z;
+
+        if (v.x > max.x) max.x = v.x;
+        if (v.y > max.y) max.y = v.y;
+        if (v.z > max.z) max.z = v.z;
+    }
+
+    center.setAdd(min, max);
+    center *= 0.5f;
+
+    f32 radius_sq = 0.0f;
+
+    for (u32 i = 0; i < num; i++)
+    {
+        const Vector3f& v = *(const Vector3f*)(p + stride * i);
+        const f32 dist_sq = (v - center).squaredLength();
+
+        if (dist_sq > radius_sq)
+            radius_sq = dist_sq;
+    }
+
+    radius = Mathf::sqrt(radius_sq);
+}
+
+void Bounds::setTransform(const BaseMtx34f& mtx, const Bounds& b)
+{
+    const Vector3f box_center = (b.min + b.max) * 0.5f;
+    const Vector3f box_extent = (b.max - b.min) * 0.5f;
+
+    // Box: transformed center, and extent projected on the axes
+    Vector3f new_center;
+    Vector3f new_extent;
+
+    for (u32 i = 0; i < 3; i++)
+    {
+        (&new_center.x)[i] = mtx.m[i][0] * box_center.x + mtx.m[i][1] * box_center.y + mtx.m[i][2] * box_center.z + mtx.m[i][3];
+        (&new_extent.x)[i] = Mathf::abs(mtx.m[i][0]) * box_extent.x + Mathf::abs(mtx.m[i][1]) * box_extent.y + Mathf::abs(mtx.m[i][2]) * box_extent.z;
+    }
+
+    // Sphere: transformed center, and radius scaled by the largest scale of the matrix
+    Vector3f sphere_center;
+    for (u32 i = 0; i < 3; i++)
+        (&sphere_center.x)[i] = mtx.m[i][0] * b.center.x + mtx.m[i][1] * b.center.y + mtx.m[i][2] * b.center.z + mtx.m[i][3];
+
+    f32 scale_sq = 0.0f;
+    for (u32 j = 0; j < 3; j++)
+    {
+        const f32 col_sq = mtx.m[0][j] * mtx.m[0][j] + mtx.m[1][j] * mtx.m[1][j] + mtx.m[2][j] * mtx.m[2][j];
+        if (col_sq > scale_sq)
+            scale_sq = col_sq;
+    }
+
+    min = new_center - new_extent;
+    max = new_center + new_extent;
+    center = sphere_center;
+    radius = b.radius * Mathf::sqrt(scale_sq);
+}
+
+Frustum::Frustum()
+    : mVisibleNum(0)
+    , mCulledNum(0)
+{
+    // Everything is visible until set
+    for (u32 i = 0; i < PLANE_NUM; i++)
+        mPlane[i].set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+void Frustum::set(const Camera& camera, const Projection& projection)
+{
+    Matrix34f view_mtx;
+    camera.getMatrix(&view_mtx);
+
+    Matrix44f view_proj_mtx;
+    view_proj_mtx.setMul(static_cast<const Matrix44f&>(projection.getMatrix()), view_mtx);
+
+    set(view_proj_mtx);
+}
+
+void Frustum::set(const BaseMtx44f& view_proj_mtx)
+{
+    // Gribb & Hartmann: the planes are the sums and differences of the last row with the other rows
+    const Vector4f& r0 = static_cast<const Vector4f&>(view_proj_mtx.v[0]);
+    const Vector4f& r1 = static_cast<const Vector4f&>(view_proj_mtx.v[1]);
+    const Vector4f& r2 = static_cast<const Vector4f&>(view_proj_mtx.v[2]);
+    const Vector4f& r3 = static_cast<const Vector4f&>(view_proj_mtx.v[3]);
+
+    mPlane[PLANE_LEFT]   = r3 + r0;
+    mPlane[PLANE_RIGHT]  = r3 - r0;
+    mPlane[PLANE_BOTTOM] = r3 + r1;
+    mPlane[PLANE_TOP]    = r3 - r1;
+    mPlane[PLANE_NEAR]   = r3 + r2;
+    mPlane[PLANE_FAR]    = r3 - r2;
+
+    // Normalize, so that the distances to the planes can be compared to sphere radiuses
+    for (u32 i = 0; i < PLANE_NUM; i++)
+    {
+        Vector4f& plane = mPlane[i];
+
+        const f32 length = Mathf::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f)
+            plane *= 1.0f / length;
+    }
+
+    resetCounters();
+}
+
+bool Frustum::isSphereVisible_(const Vector3f& center, f32 radius) const
+{
+    for (u32 i = 0; i < PLANE_NUM; i++)
+    {
+        const Vector4f& plane = mPlane[i];
+        if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+            return false;
+    }
+
+    return true;
+}
+
+bool Frustum::isBoxVisible_(const Vector3f& min, const Vector3f& max) const
+{
+    for (u32 i = 0; i < PLANE_NUM; i++)
+    {
+        const Vector4f& plane = mPlane[i];
+
+        // Corner of the box which is the furthest along the plane normal
+        const f32 x = plane.x >= 0.0f ? max.x : min.x;
+        const f32 y = plane.y >= 0.0f ? max.y : min.y;
+        const f32 z = plane.z >= 0.0f ? max.z : min.z;
+
+        if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f)
+            return false;
+    }
+
+    return true;
+}
+
+bool Frustum::count_(bool visible) const
+{
+    if (visible)
+        mVisibleNum++;
+    else
+        mCulledNum++;
+
+    return visible;
+}
+
+bool Frustum::isVisible(const Vector3f& center, f32 radius) const
+{
+    return count_(isSphereVisible_(center, radius));
+}
+
+bool Frustum::isVisible(const Vector3f& min, const Vector3f& max) const
+{
+    return count_(isBoxVisible_(min, max));
+}
+
+bool Frustum::isVisible(const Bounds& bounds) const
+{
+    return count_(isSphereVisible_(bounds.center, bounds.radius) &&
+                  isBoxVisible_(bounds.min, bounds.max));
+}
+
+void Frustum::resetCounters()
+{
+    mVisibleNum = 0;
+    mCulledNum = 0;
+}
+
+}
@@ -33,6 +33,9 @@ PrimitiveRenderer::PrimitiveRenderer(const char* shader_path)
     , mShader()
     , mVertexArray()
     , mVertexBuffer()
+    , mVertexBuf(nullptr)
+    , mIndexBuffer()
+    , mIndexBuf(nullptr)
     , mPosStream()
     , mUVStream()
     , mColorStream()
@@ -48,240 +51,190 @@ PrimitiveRenderer::PrimitiveRenderer(const char* shader_path)
     //, mAttrVertexLocation(0xFFFFFFFF)
     //, mAttrTexCoord0Location(0xFFFFFFFF)
     //, mAttrColorRateLocation(0xFFFFFFFF)
-    //, mQuadVertexBuf(nullptr)
-    //, mQuadIndexBuf(nullptr)
-    //, mBoxIndexBuf(nullptr)
-    //, mLineVertexBuf(nullptr)
-    //, mLineIndexBuf(nullptr)
-    //, mCubeVertexBuf(nullptr)
-    //, mCubeIndexBuf(nullptr)
-    //, mWireCubeVertexBuf(nullptr)
-    //, mWireCubeIndexBuf(nullptr)
-    //, mSphereSVertexBuf(nullptr)
-    //, mSphereSIndexBuf(nullptr)
-    //, mSphereLVertexBuf(nullptr)
-    //, mSphereLIndexBuf(nullptr)
-    //, mDiskSVertexBuf(nullptr)
-    //, mDiskSIndexBuf(nullptr)
-    //, mDiskLVertexBuf(nullptr)
-    //, mDiskLIndexBuf(nullptr)
-    //, mCircleSIndexBuf(nullptr)
-    //, mCircleLIndexBuf(nullptr)
-    //, mCylinderSVertexBuf(nullptr)
-    //, mCylinderSIndexBuf(nullptr)
-    //, mCylinderLVertexBuf(nullptr)
-    //, mCylinderLIndexBuf(nullptr)
 {
     initialize_(shader_path);
 }
 
 PrimitiveRenderer::~PrimitiveRenderer()
 {
-    MemUtil::free(mQuadVertexBuf);
-    MemUtil::free(mQuadIndexBuf);
-
-    MemUtil::free(mBoxIndexBuf);
-
-    MemUtil::free(mLineVertexBuf);
-    MemUtil::free(mLineIndexBuf);
-
-    MemUtil::free(mCubeVertexBuf);
-    MemUtil::free(mCubeIndexBuf);
-
-    MemUtil::free(mWireCubeVertexBuf);
-    MemUtil::free(mWireCubeIndexBuf);
-
-    MemUtil::free(mSphereSVertexBuf);
-    MemUtil::free(mSphereSIndexBuf);
-
-    MemUtil::free(mSphereLVertexBuf);
-    MemUtil::free(mSphereLIndexBuf);
-
-    MemUtil::free(mDiskSVertexBuf);
-    MemUtil::free(mDiskSIndexBuf);
-
-    MemUtil::free(mDiskLVertexBuf);
-    MemUtil::free(mDiskLIndexBuf);
-
-    MemUtil::free(mCircleSIndexBuf);
-
-    MemUtil::free(mCircleLIndexBuf);
-
-    MemUtil::free(mCylinderSVertexBuf);
-    MemUtil::free(mCylinderSIndexBuf);
-
-    MemUtil::free(mCylinderLVertexBuf);
-    MemUtil::free(mCylinderLIndexBuf);
+    MemUtil::free(mVertexBuf);
+    MemUtil::free(mIndexBuf);
 }
 
 void PrimitiveRenderer::initialize_(const char* shader_path)
 {
-    mShader.load(shader_path, Shader::MODE_UNIFORM_REGISTER);
-
-    mParamWVPOffset = mShader.getVertexUniformLocation("wvp");
-    RIO_ASSERT(mParamWVPOffset != 0xFFFFFFFF);
-    mParamUserOffset = mShader.getVertexUniformLocation("user");
-    RIO_ASSERT(mParamUserOffset != 0xFFFFFFFF);
-    mParamColor0Offset = mShader.getVertexUniformLocation("color0");
-    RIO_ASSERT(mParamColor0Offset != 0xFFFFFFFF);
-    mParamColor1Offset = mShader.getVertexUniformLocation("color1");
-    RIO_ASSERT(mParamColor1Offset != 0xFFFFFFFF);
-
-    mParamRateOffset = mShader.getFragmentUniformLocation("rate");
-    RIO_ASSERT(mParamRateOffset != 0xFFFFFFFF);
-    mParamTexLocation = mShader.getFragmentSamplerLocation("texture0");
-    RIO_ASSERT(mParamTexLocation != 0xFFFFFFFF);
-
-    mAttrVertexLocation = mShader.getVertexAttribLocation("Vertex");
-    RIO_ASSERT(mAttrVertexLocation != 0xFFFFFFFF);
-    mAttrTexCoord0Location = mShader.getVertexAttribLocation("TexCoord0");
-    RIO_ASSERT(mAttrTexCoord0Location != 0xFFFFFFFF);
-    mAttrColorRateLocation = mShader.getVertexAttribLocation("ColorRate");
-    RIO_ASSERT(mAttrColorRateLocation != 0xFFFFFFFF);
-
-    mPosStream  .setLayout(mAttrVertexLocation,    VertexStream::FORMAT_32_32_32_FLOAT,    offsetof(Vertex, pos));
-    mUVStream   .setLayout(mAttrTexCoord0Location, VertexStream::FORMAT_32_32_FLOAT,       offsetof(Vertex, uv));
-    mColorStream.setLayout(mAttrColorRateLocation, VertexStream::FORMAT_32_32_32_32_FLOAT, offsetof(Vertex, color));
-
-    mVertexBuffer.setStride(sizeof(Vertex));
+    // Compile the shader while the primitives are generated
+    mShader.loadAsync(shader_path, Shader::MODE_UNIFORM_REGISTER);
+
+    // All primitives are stored in a single vertex buffer and a single index buffer,
+    // which are uploaded once and only need to be bound with the vertex array when drawing
+    static constexpr u32 cVtxNum = 4            // Quad, Box
+                                 + 2            // Line
+                                 + 8            // Cube
+                                 + 8            // WireCube
+                                 + (4*8 + 2)    // SphereS
+                                 + (8*16 + 2)   // SphereL
+                                 + (16 + 1)     // DiskS, CircleS
+                                 + (32 + 1)     // DiskL, CircleL
+                                 + (16*2 + 2)   // CylinderS
+                                 + (32*2 + 2);  // CylinderL
+
+    static constexpr u32 cIdxNum = 6 + 4        // Quad, Box
+                                 + 2            // Line
+                                 + 36           // Cube
+                                 + 17           // WireCube
+                                 + (4*8 * 6)    // SphereS
+                                 + (8*16 * 6)   // SphereL
+                                 + (16 * 3)     // DiskS
+                                 + (32 * 3)     // DiskL
+                                 + 16 + 32      // CircleS, CircleL
+                                 + (16 * 12)    // CylinderS
+                                 + (32 * 12);   // CylinderL
+
+    mVertexBuf = static_cast<Vertex*>(MemUtil::alloc(cVtxNum * sizeof(Vertex), Drawer::cVtxAlignment));
+    mIndexBuf  = static_cast<   u16*>(MemUtil::alloc(cIdxNum * sizeof(   u16), Drawer::cIdxAlignment));
+
+    u32 vtx_num = 0;
+    u32 idx_num = 0;
+
+    // Register the indices last written at mIndexBuf + idx_num as a primitive
+    // whose vertices start at mVertexBuf + vtx_base
+    const auto addRange = [this, &idx_num](IndexRange& range, u32 vtx_base, u32 count)
+    {
+        for (u32 i = idx_num; i < idx_num + count; i++)
+            mIndexBuf[i] += vtx_base;
 
-    mVertexArray.initialize();
-    mVertexArray.addAttribute(mPosStream, mVertexBuffer);
-    mVertexArray.addAttribute(mUVStream, mVertexBuffer);
-    mVertexArray.addAttribute(mColorStream, mVertexBuffer);
-    mVertexArray.process();
+        range.first = idx_num;
+        range.count = count;
+        idx_num += count;
+    };
 
     {
         // Quad
-        mQuadVertexBuf = static_cast<Vertex*>(MemUtil::alloc(4 * sizeof(Vertex), Drawer::cVtxAlignment));
-        mQuadIndexBuf  = static_cast<   u16*>(MemUtil::alloc(6 * sizeof(   u16), Drawer::cIdxAlignment));
-
-        getQuadVertex(mQuadVertexBuf, mQuadIndexBuf);
-
-        VertexBuffer::invalidateCache(mQuadVertexBuf, 4 * sizeof(Vertex));
-        VertexBuffer::invalidateCache(mQuadIndexBuf,  6 * sizeof(   u16));
+        getQuadVertex(mVertexBuf + vtx_num, mIndexBuf + idx_num);
+        addRange(mQuadRange, vtx_num, 6);
 
         // Box
-        mBoxIndexBuf   = static_cast<   u16*>(MemUtil::alloc(4 * sizeof(   u16), Drawer::cIdxAlignment));
-
         static const u16 idx[4] = { 0, 1, 3, 2 };
-        MemUtil::copy(mBoxIndexBuf, idx, sizeof(idx));
+        MemUtil::copy(mIndexBuf + idx_num, idx, sizeof(idx));
+        addRange(mBoxRange, vtx_num, 4);
 
-        VertexBuffer::invalidateCache(mBoxIndexBuf,   4 * sizeof(   u16));
+        vtx_num += 4;
     }
 
     {
         // Line
-        mLineVertexBuf = static_cast<Vertex*>(MemUtil::alloc(4 * sizeof(Vertex), Drawer::cVtxAlignment));
-        mLineIndexBuf  = static_cast<   u16*>(MemUtil::alloc(6 * sizeof(   u16), Drawer::cIdxAlignment));
-
-        getLineVertex(mLineVertexBuf, mLineIndexBuf);
-
-        VertexBuffer::invalidateCache(mLineVertexBuf, 4 * sizeof(Vertex));
-        VertexBuffer::invalidateCache(mLineIndexBuf,  6 * sizeof(   u16));
+        getLineVertex(mVertexBuf + vtx_num, mIndexBuf + idx_num);
+        addRange(mLineRange, vtx_num, 2);
+        vtx_num += 2;
     }
 
     {
         // Cube
-        mCubeVertexBuf = static_cast<Vertex*>(MemUtil::alloc(8  * sizeof(Vertex), Drawer::cVtxAlignment));
-        mCubeIndexBuf  = static_cast<   u16*>(MemUtil::alloc(36 * sizeof(   u16), Drawer::cIdxAlignment));
-
-        getCubeVertex(mCubeVertexBuf, mCubeIndexBuf);
-
-        VertexBuffer::invalidateCache(mCubeVertexBuf, 8  * sizeof(Vertex));
-        VertexBuffer::invalidateCache(mCubeIndexBuf,  36 * sizeof(   u16));
+        getCubeVertex(mVertexBuf + vtx_num, mIndexBuf + idx_num);
+        addRange(mCubeRange, vtx_num, 36);
+        vtx_num += 8;
     }
 
     {
         // WireCube
-        mWireCubeVertexBuf = static_cast<Vertex*>(MemUtil::alloc(8  * sizeof(Vertex), Drawer::cVtxAlignment));
-        mWireCubeIndexBuf  = static_cast<   u16*>(MemUtil::alloc(17 * sizeof(   u16), Drawer::cIdxAlignment));
-
-        getWireCubeVertex(mWireCubeVertexBuf, mWireCubeIndexBuf);
-
-        VertexBuffer::invalidateCache(mWireCubeVertexBuf, 8  * sizeof(Vertex));
-        VertexBuffer::invalidateCache(mWireCubeIndexBuf,  17 * sizeof(   u16));
+        getWireCubeVertex(mVertexBuf + vtx_num, mIndexBuf + idx_num);
+        addRange(mWireCubeRange, vtx_num, 17);
+        vtx_num += 8;
     }
 
     {
         // SphereS
-        mSphereSVertexBuf = static_cast<Vertex*>(MemUtil::alloc((4*8 + 2) * sizeof(Vertex), Drawer::cVtxAlignment));
-        mSphereSIndexBuf  = static_cast<   u16*>(MemUtil::alloc((4*8 * 6) * sizeof(   u16), Drawer::cIdxAlignment));
-
-        getSphereVertex(mSphereSVertexBuf, mSphereSIndexBuf, 8, 4);
-
-        VertexBuffer::invalidateCache(mSphereSVertexBuf, (4*8 + 2) * sizeof(Vertex));
-        VertexBuffer::invalidateCache(mSphereSIndexBuf,  (4*8 * 6) * sizeof(   u16));
+        getSphereVertex(mVertexBuf + vtx_num, mIndexBuf + idx_num, 8, 4);
+        addRange(mSphereSRange, vtx_num, 4*8 * 6);
+        vtx_num += 4*8 + 2;
     }
 
     {
         // SphereL
-        mSphereLVertexBuf = static_cast<Vertex*>(MemUtil::alloc((8*16 + 2) * sizeof(Vertex), Drawer::cVtxAlignment));
-        mSphereLIndexBuf  = static_cast<   u16*>(MemUtil::alloc((8*16 * 6) * sizeof(   u16), Drawer::cIdxAlignment));
-
-        getSphereVertex(mSphereLVertexBuf, mSphereLIndexBuf, 16, 8);
-
-        VertexBuffer::invalidateCache(mSphereLVertexBuf, (8*16 + 2) * sizeof(Vertex));
-        VertexBuffer::invalidateCache(mSphereLIndexBuf,  (8*16 * 6) * sizeof(   u16));
+        getSphereVertex(mVertexBuf + vtx_num, mIndexBuf + idx_num, 16, 8);
+        addRange(mSphereLRange, vtx_num, 8*16 * 6);
+        vtx_num += 8*16 + 2;
     }
 
     {
         // DiskS
-        mDiskSVertexBuf  = static_cast<Vertex*>(MemUtil::alloc((16 + 1) * sizeof(Vertex), Drawer::cVtxAlignment));
-        mDiskSIndexBuf   = static_cast<   u16*>(MemUtil::alloc((16 * 3) * sizeof(   u16), Drawer::cIdxAlignment));
-
-        getDiskVertex(mDiskSVertexBuf, mDiskSIndexBuf, 16);
-
-        VertexBuffer::invalidateCache(mDiskSVertexBuf,  (16 + 1) * sizeof(Vertex));
-        VertexBuffer::invalidateCache(mDiskSIndexBuf,   (16 * 3) * sizeof(   u16));
-
-        // DiskL
-        mDiskLVertexBuf  = static_cast<Vertex*>(MemUtil::alloc((32 + 1) * sizeof(Vertex), Drawer::cVtxAlignment));
-        mDiskLIndexBuf   = static_cast<   u16*>(MemUtil::alloc((32 * 3) * sizeof(   u16), Drawer::cIdxAlignment));
-
-        getDiskVertex(mDiskLVertexBuf, mDiskLIndexBuf, 32);
-
-        VertexBuffer::invalidateCache(mDiskLVertexBuf,  (32 + 1) * sizeof(Vertex));
-        VertexBuffer::invalidateCache(mDiskLIndexBuf,   (32 * 3) * sizeof(   u16));
+        getDiskVertex(mVertexBuf + vtx_num, mIndexBuf + idx_num, 16);
+        addRange(mDiskSRange, vtx_num, 16 * 3);
 
         // CircleS
-        mCircleSIndexBuf = static_cast<   u16*>(MemUtil::alloc(16       * sizeof(   u16), Drawer::cIdxAlignment));
-
         for (s32 i = 0; i < 16; i++)
-            mCircleSIndexBuf[i] = i;
+            mIndexBuf[idx_num + i] = i;
 
-        VertexBuffer::invalidateCache(mCircleSIndexBuf, 16       * sizeof(   u16));
+        addRange(mCircleSRange, vtx_num, 16);
 
-        // CircleL
-        mCircleLIndexBuf = static_cast<   u16*>(MemUtil::alloc(32       * sizeof(   u16), Drawer::cIdxAlignment));
+        vtx_num += 16 + 1;
 
+        // DiskL
+        getDiskVertex(mVertexBuf + vtx_num, mIndexBuf + idx_num, 32);
+        addRange(mDiskLRange, vtx_num, 32 * 3);
+
+        // CircleL
         for (s32 i = 0; i < 32; i++)
-            mCircleLIndexBuf[i] = i;
+            mIndexBuf[idx_num + i] = i;
 
-        VertexBuffer::invalidateCache(mCircleLIndexBuf, 32       * sizeof(   u16));
+        addRange(mCircleLRange, vtx_num, 32);
+
+        vtx_num += 32 + 1;
     }
 
     {
         // CylinderS
-        mCylinderSVertexBuf = static_cast<Vertex*>(MemUtil::alloc((16*2 +  2) * sizeof(Vertex), Drawer::cVtxAlignment));
-        mCylinderSIndexBuf  = static_cast<   u16*>(MemUtil::alloc((16   * 12) * sizeof(   u16), Drawer::cIdxAlignment));
-
-        getCylinderVertex(mCylinderSVertexBuf, mCylinderSIndexBuf, 16);
-
-        VertexBuffer::invalidateCache(mCylinderSVertexBuf, (16*2 +  2) * sizeof(Vertex));
-        VertexBuffer::invalidateCache(mCylinderSIndexBuf,  (16   * 12) * sizeof(   u16));
+        getCylinderVertex(mVertexBuf + vtx_num, mIndexBuf + idx_num, 16);
+        addRange(mCylinderSRange, vtx_num, 16 * 12);
+        vtx_num += 16*2 + 2;
     }
 
     {
         // CylinderL
-        mCylinderLVertexBuf = static_cast<Vertex*>(MemUtil::alloc((32*2 +  2) * sizeof(Vertex), Drawer::cVtxAlignment));
-        mCylinderLIndexBuf  = static_cast<   u16*>(MemUtil::alloc((32   * 12) * sizeof(   u16), Drawer::cIdxAlignment));
+        getCylinderVertex(mVertexBuf + vtx_num, mIndexBuf + idx_num, 32);
+        addRange(mCylinderLRange, vtx_num, 32 * 12);
+        vtx_num += 32*2 + 2;
+    }
 
-        getCylinderVertex(mCylinderLVertexBuf, mCylinderLIndexBuf, 32);
+    RIO_ASSERT(vtx_num == cVtxNum);
+    RIO_ASSERT(idx_num == cIdxNum);
 
-        VertexBuffer::invalidateCache(mCylinderLVertexBuf, (32*2 +  2) * sizeof(Vertex));
-        VertexBuffer::invalidateCache(mCylinderLIndexBuf,  (32   * 12) * sizeof(   u16));
-    }
+    mParamWVPOffset = mShader.getVertexUniformLocation("wvp");
+    RIO_ASSERT(mParamWVPOffset != 0xFFFFFFFF);
+    mParamUserOffset = mShader.getVertexUniformLocation("user");
+    RIO_ASSERT(mParamUserOffset != 0xFFFFFFFF);
+    mParamColor0Offset = mShader.getVertexUniformLocation("color0");
+    RIO_ASSERT(mParamColor0Offset != 0xFFFFFFFF);
+    mParamColor1Offset = mShader.getVertexUniformLocation("color1");
+    RIO_ASSERT(mParamColor1Offset != 0xFFFFFFFF);
+
+    mParamRateOffset = mShader.getFragmentUniformLocation("rate");
+    RIO_ASSERT(mParamRateOffset != 0xFFFFFFFF);
+    mParamTexLocation = mShader.getFragmentSamplerLocation("texture0");
+    RIO_ASSERT(mParamTexLocation != 0xFFFFFFFF);
+
+    mAttrVertexLocation = mShader.getVertexAttribLocation("Vertex");
+    RIO_ASSERT(mAttrVertexLocation != 0xFFFFFFFF);
+    mAttrTexCoord0Location = mShader.getVertexAttribLocation("TexCoord0");
+    RIO_ASSERT(mAttrTexCoord0Location != 0xFFFFFFFF);
+    mAttrColorRateLocation = mShader.getVertexAttribLocation("ColorRate");
+    RIO_ASSERT(mAttrColorRateLocation != 0xFFFFFFFF);
+
+    mPosStream  .setLayout(mAttrVertexLocation,    VertexStream::FORMAT_32_32_32_FLOAT,    offsetof(Vertex, pos));
+    mUVStream   .setLayout(mAttrTexCoord0Location, VertexStream::FORMAT_32_32_FLOAT,       offsetof(Vertex, uv));
+    mColorStream.setLayout(mAttrColorRateLocation, VertexStream::FORMAT_32_32_32_32_FLOAT, offsetof(Vertex, color));
+
+    mVertexBuffer.setStride(sizeof(Vertex));
+    mVertexBuffer.setDataInvalidate(mVertexBuf, cVtxNum * sizeof(Vertex));
+    mIndexBuffer.setDataInvalidate(mIndexBuf, cIdxNum);
+
+    mVertexArray.initialize();
+    mVertexArray.addAttribute(mPosStream, mVertexBuffer);
+    mVertexArray.addAttribute(mUVStream, mVertexBuffer);
+    mVertexArray.addAttribute(mColorStream, mVertexBuffer);
+    mVertexArray.setIndexBuffer(&mIndexBuffer);
+    mVertexArray.process();
 
     mDrawQuadSampler.setWrap(TEX_WRAP_MODE_CLAMP,
                              TEX_WRAP_MODE_CLAMP,
@@ -584,104 +537,103 @@ void PrimitiveRenderer::drawQuad_(
     const BaseMtx34f& model_mtx, const Color4f& colorL, const Color4f& colorR
 )
 {
-    drawTriangles_(model_mtx, colorL, colorR, mQuadVertexBuf, 4, mQuadIndexBuf, 6);
+    drawTriangles_(model_mtx, colorL, colorR, mQuadRange);
 }
 
 void PrimitiveRenderer::drawQuad_(
     const BaseMtx34f& model_mtx, const Texture2D& texture, const Color4f& colorL, const Color4f& colorR
 )
 {
-    drawTriangles_(model_mtx, colorL, colorR, mQuadVertexBuf, 4, mQuadIndexBuf, 6, &texture);
+    drawTriangles_(model_mtx, colorL, colorR, mQuadRange, &texture);
 }
 
 void PrimitiveRenderer::drawBox_(
     const BaseMtx34f& model_mtx, const Color4f& colorL, const Color4f& colorR
 )
 {
-    drawLines_(model_mtx, colorL, colorR, Drawer::LINE_LOOP, mQuadVertexBuf, 4, mBoxIndexBuf, 4);
+    drawLines_(model_mtx, colorL, colorR, Drawer::LINE_LOOP, mBoxRange);
 }
 
 void PrimitiveRenderer::drawCube_(
     const BaseMtx34f& model_mtx, const Color4f& c0, const Color4f& c1
 )
 {
-    drawTriangles_(model_mtx, c0, c1, mCubeVertexBuf, 8, mCubeIndexBuf, 36);
+    drawTriangles_(model_mtx, c0, c1, mCubeRange);
 }
 
 void PrimitiveRenderer::drawWireCube_(
     const BaseMtx34f& model_mtx, const Color4f& c0, const Color4f& c1
 )
 {
-    drawLines_(model_mtx, c0, c1, Drawer::LINE_LOOP, mWireCubeVertexBuf, 8, mWireCubeIndexBuf, 17);
+    drawLines_(model_mtx, c0, c1, Drawer::LINE_LOOP, mWireCubeRange);
 }
 
 void PrimitiveRenderer::drawLine_(
     const BaseMtx34f& model_mtx, const Color4f& c0, const Color4f& c1
 )
 {
-    drawLines_(model_mtx, c0, c1, Drawer::LINES, mLineVertexBuf, 2, mLineIndexBuf, 2);
+    drawLines_(model_mtx, c0, c1, Drawer::LINES, mLineRange);
 }
 
 void PrimitiveRenderer::drawSphere4x8_(
     const BaseMtx34f& model_mtx, const Color4f& north, const Color4f& south
 )
 {
-    drawTriangles_(model_mtx, north, south, mSphereSVertexBuf, 4*8 + 2, mSphereSIndexBuf, 4*8 * 6);
+    drawTriangles_(model_mtx, north, south, mSphereSRange);
 }
 
 void PrimitiveRenderer::drawSphere8x16_(
     const BaseMtx34f& model_mtx, const Color4f& north, const Color4f& south
 )
 {
-    drawTriangles_(model_mtx, north, south, mSphereLVertexBuf, 8*16 + 2, mSphereLIndexBuf, 8*16 * 6);
+    drawTriangles_(model_mtx, north, south, mSphereLRange);
 }
 
 void PrimitiveRenderer::drawDisk16_(
     const BaseMtx34f& model_mtx, const Color4f& center, const Color4f& edge
 )
 {
-    drawTriangles_(model_mtx, center, edge, mDiskSVertexBuf, 16 + 1, mDiskSIndexBuf, 16 * 3);
+    drawTriangles_(model_mtx, center, edge, mDiskSRange);
 }
 
 void PrimitiveRenderer::drawDisk32_(
     const BaseMtx34f& model_mtx, const Color4f& center, const Color4f& edge
 )
 {
-    drawTriangles_(model_mtx, center, edge, mDiskLVertexBuf, 32 + 1, mDiskLIndexBuf, 32 * 3);
+    drawTriangles_(model_mtx, center, edge, mDiskLRange);
 }
 
 void PrimitiveRenderer::drawCircle16_(
     const BaseMtx34f& model_mtx, const Color4f& edge
 )
 {
-    drawLines_(model_mtx, edge, edge, Drawer::LINE_LOOP, mDiskSVertexBuf, 16 + 1, mCircleSIndexBuf, 16);
+    drawLines_(model_mtx, edge, edge, Drawer::LINE_LOOP, mCircleSRange);
 }
 
 void PrimitiveRenderer::drawCircle32_(
     const BaseMtx34f& model_mtx, const Color4f& edge
 )
 {
-    drawLines_(model_mtx, edge, edge, Drawer::LINE_LOOP, mDiskLVertexBuf, 32 + 1, mCircleLIndexBuf, 32);
+    drawLines_(model_mtx, edge, edge, Drawer::LINE_LOOP, mCircleLRange);
 }
 
 void PrimitiveRenderer::drawCylinder16_(
     const BaseMtx34f& model_mtx, const Color4f& top, const Color4f& btm
 )
 {
-    drawTriangles_(model_mtx, top, btm, mCylinderSVertexBuf, 16*2 + 2, mCylinderSIndexBuf, 16 * 12);
+    drawTriangles_(model_mtx, top, btm, mCylinderSRange);
 }
 
 void PrimitiveRenderer::drawCylinder32_(
     const BaseMtx34f& model_mtx, const Color4f& top, const Color4f& btm
 )
 {
-    drawTriangles_(model_mtx, top, btm, mCylinderLVertexBuf, 32*2 + 2, mCylinderLIndexBuf, 32 * 12);
+    drawTriangles_(model_mtx, top, btm, mCylinderLRange);
 }
 
 void PrimitiveRenderer::drawTriangles_(
     const BaseMtx34f& model_mtx, const Color4f& c0, const Color4f& c1,
-    Vertex* vtx, u32 vtx_num, u16* idx, u32 idx_num,
-    const Texture2D* texture
+    const IndexRange& range, const Texture2D* texture
 )
 {
     mShader.setUniformArray(3, model_mtx.v, mParamUserOffset, 0xFFFFFFFF);
@@ -700,16 +652,15 @@ void PrimitiveRenderer::drawTriangles_(
         mShader.setUniform(0.0f, 0xFFFFFFFF, mParamRateOffset);
     }
 
-    mVertexBuffer.setData(vtx, vtx_num * sizeof(Vertex));
     mVertexArray.bind();
 
-    Drawer::DrawElements(Drawer::TRIANGLES, idx_num, idx);
+    Drawer::DrawElements(Drawer::TRIANGLES, mIndexBuffer, range.count, range.first);
 }
 
 void PrimitiveRenderer::drawLines_(
     const BaseMtx34f& model_mtx, const Color4f& c0, const Color4f& c1,
     Drawer::PrimitiveMode mode,
-    Vertex* vtx, u32 vtx_num, u16* idx, u32 idx_num
+    const IndexRange& range
 )
 {
     mShader.setUniformArray(3, model_mtx.v, mParamUserOffset, 0xFFFFFFFF);
@@ -719,10 +670,9 @@ void PrimitiveRenderer::drawLines_(
 
     mShader.setUniform(0.0f, 0xFFFFFFFF, mParamRateOffset);
 
-    mVertexBuffer.setData(vtx, vtx_num * sizeof(Vertex));
     mVertexArray.bind();
 
-    Drawer::DrawElements(mode, idx_num, idx);
+    Drawer::DrawElements(mode, mIndexBuffer, range.count, range.first);
 }
 
 void PrimitiveRenderer::getQuadVertex(Vertex* vtx, u16* idx)
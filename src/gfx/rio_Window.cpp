@@ -13,6 +13,7 @@ bool Window::createSingleton(
     , bool invisible
     , u32 gl_major
     , u32 gl_minor
+    , bool offscreen
 #endif // RIO_IS_WIN
 )
 {
@@ -29,6 +30,7 @@ bool Window::createSingleton(
         , invisible
         , gl_major
         , gl_minor
+        , offscreen
 #endif // RIO_IS_WIN
     ))
     {
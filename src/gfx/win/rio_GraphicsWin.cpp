@@ -10,16 +10,16 @@
 
 namespace rio {
 
-s32 Graphics::sViewportX;
-s32 Graphics::sViewportY;
-u32 Graphics::sViewportWidth;
-u32 Graphics::sViewportHeight;
-f32 Graphics::sViewportNear;
-f32 Graphics::sViewportFar;
-s32 Graphics::sScissorX;
-s32 Graphics::sScissorY;
-u32 Graphics::sScissorWidth;
-u32 Graphics::sScissorHeight;
+thread_local s32 Graphics::sViewportX;
+thread_local s32 Graphics::sViewportY;
+thread_local u32 Graphics::sViewportWidth;
+thread_local u32 Graphics::sViewportHeight;
+thread_local f32 Graphics::sViewportNear;
+thread_local f32 Graphics::sViewportFar;
+thread_local s32 Graphics::sScissorX;
+thread_local s32 Graphics::sScissorY;
+thread_local u32 Graphics::sScissorWidth;
+thread_local u32 Graphics::sScissorHeight;
 
 void Graphics::setViewport(s32 x, s32 y, u32 width, u32 height, f32 near, f32 far, s32 frame_buffer_height)
 {
@@ -0,0 +1,405 @@
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+
+#include <gfx/win/rio_RenderWorkerMgrWin.h>
+#include <gpu/win/rio_GLStateCacheWin.h>
+
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+namespace rio {
+
+thread_local RenderWorker* RenderWorker::sCurrent = nullptr;
+
+RenderWorker::RenderWorker(RenderWorkerMgr* mgr, u32 index, u32 width, u32 height)
+    : mpMgr(mgr)
+    , mIndex(index)
+    , mWidth(width)
+    , mHeight(height)
+    , mContext()
+    , mpColorTexture(nullptr)
+    , mpDepthTexture(nullptr)
+    , mpRenderBuffer(nullptr)
+{
+}
+
+RenderWorker::~RenderWorker()
+{
+    RIO_ASSERT(!mThread.joinable());
+    RIO_ASSERT(mpRenderBuffer == nullptr);
+}
+
+bool RenderWorker::initialize_()
+{
+    return Window::instance()->createSharedContext_(&mContext);
+}
+
+void RenderWorker::start_()
+{
+    mThread = std::thread(&RenderWorker::threadMain_, this);
+}
+
+void RenderWorker::terminate_()
+{
+    if (mThread.joinable())
+        mThread.join();
+
+    Window::instance()->destroySharedContext_(&mContext);
+}
+
+void RenderWorker::threadMain_()
+{
+    const Window* window = Window::instance();
+
+    sCurrent = this;
+    window->makeSharedContextCurrent_(&mContext);
+    window->setupSharedContext_();
+
+    const bool success = createRenderBuffer_();
+    mpMgr->onWorkerReady_(success);
+
+    if (success)
+    {
+        RenderWorkerMgr::Job job;
+        while (mpMgr->popJob_(&job))
+        {
+            if (job.fence)
+            {
+                // Make sure objects created by the submitting context are complete
+                RIO_GL_CALL(glWaitSync(job.fence, 0, GL_TIMEOUT_IGNORED));
+                RIO_GL_CALL(glDeleteSync(job.fence));
+            }
+
+            deleteVertexArrays_(false);
+
+            bind();
+            (*job.func)(*this, job.arg);
+            RIO_GL_CALL(glFlush());
+
+            mpMgr->onJobDone_();
+        }
+    }
+
+    deleteVertexArrays_(true);
+    destroyRenderBuffer_();
+
+    window->makeSharedContextCurrent_(nullptr);
+    sCurrent = nullptr;
+}
+
+bool RenderWorker::createRenderBuffer_()
+{
+    // Frame buffers are not shared between contexts, so they must be created by the worker itself
+    mpColorTexture = new Texture2D(TEXTURE_FORMAT_R8_G8_B8_A8_UNORM, mWidth, mHeight, 1);
+    mpDepthTexture = new Texture2D(DEPTH_FORMAT_D24_S8_UNORM, mWidth, mHeight, 1);
+    if (mpColorTexture->getNativeTextureHandle() == RIO_NATIVE_TEXTURE_2D_HANDLE_NULL ||
+        mpDepthTexture->getNativeTextureHandle() == RIO_NATIVE_TEXTURE_2D_HANDLE_NULL)
+    {
+        RIO_LOG("RenderWorker: Failed to create render buffer textures.\n");
+        return false;
+    }
+
+    mColorTarget.linkTexture2D(*mpColorTexture);
+    mDepthTarget.linkTexture2D(*mpDepthTexture);
+
+    mpRenderBuffer = new RenderBuffer(mWidth, mHeight);
+    mpRenderBuffer->setRenderTargetColor(&mColorTarget);
+    mpRenderBuffer->setRenderTargetDepth(&mDepthTarget);
+    mpRenderBuffer->bind();
+
+    return true;
+}
+
+void RenderWorker::destroyRenderBuffer_()
+{
+    if (mpRenderBuffer)
+    {
+        delete mpRenderBuffer;
+        mpRenderBuffer = nullptr;
+    }
+
+    if (mpDepthTexture)
+    {
+        delete mpDepthTexture;
+        mpDepthTexture = nullptr;
+    }
+
+    if (mpColorTexture)
+    {
+        delete mpColorTexture;
+        mpColorTexture = nullptr;
+    }
+}
+
+u32 RenderWorker::getVertexArray_(u32 key, bool* p_created)
+{
+    RIO_ASSERT(sCurrent == this);
+
+    std::unordered_map<u32, u32>::iterator it = mVertexArray.find(key);
+    if (it != mVertexArray.end())
+    {
+        *p_created = false;
+        return it->second;
+    }
+
+    u32 handle = GL_NONE;
+    RIO_GL_CALL(glGenVertexArrays(1, &handle));
+    RIO_ASSERT(handle != GL_NONE);
+
+    mVertexArray.emplace(key, handle);
+    mpMgr->onVertexArrayCreated_(key, mIndex);
+
+    *p_created = true;
+    return handle;
+}
+
+void RenderWorker::deleteVertexArrays_(bool all)
+{
+    RIO_ASSERT(sCurrent == this);
+
+    std::vector<u32> keys;
+    mpMgr->takeReleasedVertexArrays_(mIndex, &keys);
+
+    if (all)
+    {
+        for (const auto& entry : mVertexArray)
+        {
+            GLStateCache::onVertexArrayDeleted(entry.second);
+            RIO_GL_CALL(glDeleteVertexArrays(1, &entry.second));
+        }
+        mVertexArray.clear();
+        return;
+    }
+
+    for (u32 key : keys)
+    {
+        std::unordered_map<u32, u32>::iterator it = mVertexArray.find(key);
+        if (it == mVertexArray.end())
+            continue;
+
+        GLStateCache::onVertexArrayDeleted(it->second);
+        RIO_GL_CALL(glDeleteVertexArrays(1, &it->second));
+        mVertexArray.erase(it);
+    }
+}
+
+bool RenderWorker::readColor(void* pixels)
+{
+    RIO_ASSERT(sCurrent == this);
+    return mpRenderBuffer->read(0, pixels, mWidth, mHeight, mpColorTexture->getNativeTexture().surface.nativeFormat);
+}
+
+RenderWorkerMgr* RenderWorkerMgr::sInstance = nullptr;
+
+bool RenderWorkerMgr::createSingleton(u32 worker_num, u32 width, u32 height)
+{
+    if (sInstance)
+        return false;
+
+    RIO_ASSERT(Window::instance());
+    RIO_ASSERT(width > 0 && height > 0);
+
+    RenderWorkerMgr* instance = new RenderWorkerMgr();
+    if (!instance->initialize_(worker_num, width, height))
+    {
+        delete instance;
+        return false;
+    }
+
+    sInstance = instance;
+    return true;
+}
+
+void RenderWorkerMgr::destroySingleton()
+{
+    if (!sInstance)
+        return;
+
+    delete sInstance;
+    sInstance = nullptr;
+}
+
+RenderWorkerMgr::RenderWorkerMgr()
+    : mPendingNum(0)
+    , mReadyNum(0)
+    , mIsReady(true)
+    , mIsExiting(false)
+    , mpWorker()
+    , mWorkerNum(0)
+{
+}
+
+RenderWorkerMgr::~RenderWorkerMgr()
+{
+    terminate_();
+}
+
+bool RenderWorkerMgr::initialize_(u32 worker_num, u32 width, u32 height)
+{
+    if (worker_num == 0)
+        worker_num = std::thread::hardware_concurrency();
+    if (worker_num == 0)
+        worker_num = 1;
+    if (worker_num > cWorkerMaxNum)
+        worker_num = cWorkerMaxNum;
+
+    for (u32 i = 0; i < worker_num; i++)
+    {
+        RenderWorker* worker = new RenderWorker(this, i, width, height);
+        if (!worker->initialize_())
+        {
+            RIO_LOG("RenderWorkerMgr: Failed to create context of worker %u.\n", i);
+            delete worker;
+            break;
+        }
+
+        // The thread looks itself up in mpWorker, so it is only started once registered
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mpWorker[mWorkerNum++] = worker;
+        }
+
+        worker->start_();
+    }
+
+    // Wait for the workers to create their render buffers
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDoneCondition.wait(lock, [this] { return mReadyNum == mWorkerNum; });
+    }
+
+    Window::instance()->makeContextCurrent();
+
+    return mWorkerNum == worker_num && mIsReady;
+}
+
+void RenderWorkerMgr::terminate_()
+{
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsExiting = true;
+    }
+    mJobCondition.notify_all();
+
+    for (u32 i = 0; i < mWorkerNum; i++)
+    {
+        mpWorker[i]->terminate_();
+        delete mpWorker[i];
+        mpWorker[i] = nullptr;
+    }
+    mWorkerNum = 0;
+}
+
+void RenderWorkerMgr::submit(JobFunc func, void* arg)
+{
+    RIO_ASSERT(func);
+    RIO_ASSERT(mIsReady);
+
+    Job job;
+    job.func = func;
+    job.arg = arg;
+    job.fence = nullptr;
+
+    if (RenderWorker::current() == nullptr)
+    {
+        // Submitted from the window's context
+        RIO_GL_CALL(job.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        RIO_GL_CALL(glFlush());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push_back(job);
+        mPendingNum++;
+    }
+    mJobCondition.notify_one();
+}
+
+void RenderWorkerMgr::wait()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCondition.wait(lock, [this] { return mPendingNum == 0; });
+}
+
+u32 RenderWorkerMgr::getPendingJobNum() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPendingNum;
+}
+
+bool RenderWorkerMgr::popJob_(Job* p_job)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mJobCondition.wait(lock, [this] { return !mJobs.empty() || mIsExiting; });
+
+    if (mJobs.empty())
+        return false;
+
+    *p_job = mJobs.front();
+    mJobs.pop_front();
+    return true;
+}
+
+void RenderWorkerMgr::onJobDone_()
+{
+    bool all_done;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        RIO_ASSERT(mPendingNum > 0);
+        all_done = --mPendingNum == 0;
+    }
+    if (all_done)
+        mDoneCondition.notify_all();
+}
+
+void RenderWorkerMgr::onWorkerReady_(bool success)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mReadyNum++;
+        if (!success)
+            mIsReady = false;
+    }
+    mDoneCondition.notify_all();
+}
+
+void RenderWorkerMgr::onVertexArrayCreated_(u32 key, u32 worker_index)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mVertexArrayWorkerMask[key] |= 1u << worker_index;
+}
+
+void RenderWorkerMgr::takeReleasedVertexArrays_(u32 worker_index, std::vector<u32>* p_keys)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    p_keys->swap(mpWorker[worker_index]->mReleasedVertexArray);
+}
+
+void RenderWorkerMgr::releaseVertexArray_(u32 key)
+{
+    // Without a pool, no worker has a vertex array left
+    RenderWorkerMgr* mgr = sInstance;
+    if (!mgr)
+        return;
+
+    std::lock_guard<std::mutex> lock(mgr->mMutex);
+
+    std::unordered_map<u32, u32>::iterator it = mgr->mVertexArrayWorkerMask.find(key);
+    if (it == mgr->mVertexArrayWorkerMask.end())
+        return;
+
+    // Only the workers which created one are told to delete it, on their next job
+    for (u32 i = 0; i < mgr->mWorkerNum; i++)
+        if (it->second & (1u << i))
+            mgr->mpWorker[i]->mReleasedVertexArray.push_back(key);
+
+    mgr->mVertexArrayWorkerMask.erase(it);
+}
+
+}
+
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+#endif // RIO_IS_WIN
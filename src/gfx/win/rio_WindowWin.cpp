@@ -4,6 +4,9 @@
         #define GLAD_GLES2_IMPLEMENTATION
     #else
         #define GLAD_GL_IMPLEMENTATION
+        #ifdef RIO_USE_EGL
+            #define GLAD_EGL_IMPLEMENTATION
+        #endif
     #endif
 #endif
 
@@ -16,6 +19,18 @@
 #include <gpu/rio_RenderState.h>
 #include <gpu/rio_Shader.h>
 #include <gpu/rio_VertexArray.h>
+#include <gpu/win/rio_GLStateCacheWin.h>
+#include <gpu/win/rio_TextureUploaderWin.h>
+#include <misc/rio_MemUtil.h>
+
+#ifdef RIO_USE_EGL
+    #ifdef _WIN32
+        #error "The EGL backend (RIO_USE_EGL) is only supported on POSIX systems."
+    #endif
+    #include <dlfcn.h>
+
+    #include <cstring>
+#endif // RIO_USE_EGL
 
 /*
 #ifndef __EMSCRIPTEN__
@@ -47,12 +62,62 @@ static const Vertex vertices[] = {
     { { -1.0f,  1.0f }, { 0.0f, 1.0f } }
 };
 
+#ifdef RIO_USE_EGL
+
+// Tokens which are not part of the embedded EGL 1.2 header
+#define RIO_EGL_OPENGL_API                          0x30A2
+#define RIO_EGL_OPENGL_BIT                          0x0008
+#define RIO_EGL_OPENGL_ES2_BIT                      0x0004
+#define RIO_EGL_OPENGL_ES3_BIT_KHR                  0x0040
+#define RIO_EGL_CONTEXT_MAJOR_VERSION_KHR           0x3098
+#define RIO_EGL_CONTEXT_MINOR_VERSION_KHR           0x30FB
+#define RIO_EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR     0x30FD
+#define RIO_EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR 0x0001
+#define RIO_EGL_PLATFORM_SURFACELESS_MESA           0x31DD
+#define RIO_EGL_DEFAULT_DISPLAY                     ((EGLNativeDisplayType)0)
+
+typedef EGLDisplay (*PFNEGLGETPLATFORMDISPLAYEXTPROC)(EGLenum platform, void* native_display, const EGLint* attrib_list);
+
+static void* gEGLLibrary = nullptr;
+static PFNEGLGETPROCADDRESSPROC gEGLGetProcAddress = nullptr;
+
+static GLADapiproc EGLGetProc(const char* name)
+{
+    GLADapiproc proc = reinterpret_cast<GLADapiproc>(dlsym(gEGLLibrary, name));
+    if (proc == nullptr)
+        proc = reinterpret_cast<GLADapiproc>(gEGLGetProcAddress(name));
+
+    return proc;
+}
+
+static bool EGLHasExtension(const char* extensions, const char* name)
+{
+    if (extensions == nullptr)
+        return false;
+
+    const size_t len = std::strlen(name);
+    for (const char* p = std::strstr(extensions, name); p != nullptr; p = std::strstr(p + len, name))
+    {
+        if ((p == extensions || p[-1] == ' ') && (p[len] == ' ' || p[len] == '\0'))
+            return true;
+    }
+
+    return false;
+}
+
+#endif // RIO_USE_EGL
+
 }
 
 namespace rio {
 
 void Window::resizeCallback_(s32 width, s32 height)
 {
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    // In-flight readbacks no longer match the window size
+    discardReadbacks();
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
     width  = std::max<s32>(1, width );
     height = std::max<s32>(1, height);
 
@@ -60,9 +125,9 @@ void Window::resizeCallback_(s32 width, s32 height)
     mHeight = height;
 
     // Set Color Buffer dimensions and format
-    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, mNativeWindow.mColorBufferTextureHandle));
+    GLStateCache::bindTexture2DScratch(mNativeWindow.mColorBufferTextureHandle);
     RIO_GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, mWidth, mHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
-    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, GL_NONE));
+    GLStateCache::bindTexture2DScratch(GL_NONE);
 
 #if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0) // GL ES not version 3.0
     // Set Depth-Stencil Buffer dimensions and format
@@ -71,9 +136,9 @@ void Window::resizeCallback_(s32 width, s32 height)
     RIO_GL_CALL(glBindRenderbuffer(GL_RENDERBUFFER, GL_NONE));
 
     // Set Depth-Stencil Buffer dimensions and format
-    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, mNativeWindow.mDepthBufferTextureHandle));
+    GLStateCache::bindTexture2DScratch(mNativeWindow.mDepthBufferTextureHandle);
     RIO_GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, mWidth, mHeight, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr));
-    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, GL_NONE));
+    GLStateCache::bindTexture2DScratch(GL_NONE);
 #endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
 
     lyr::Layer::onResize_(width, height);
@@ -99,10 +164,30 @@ void errorCallbackForGLFW(int error, const char* msg)
     RIO_LOG("GLFW error %d: %s\n", error, msg);
 }
 
-bool Window::initialize_(bool resizable, bool invisible, u32 gl_major, u32 gl_minor)
+bool Window::initialize_(bool resizable, bool invisible, u32 gl_major, u32 gl_minor, bool offscreen)
 {
-#ifdef RIO_NO_GLFW_CALLS
+#ifdef RIO_USE_EGL
+    // There is no window system to present to
+    offscreen = true;
+#endif // RIO_USE_EGL
+    mNativeWindow.mIsOffscreen = offscreen;
+
+#if defined(RIO_NO_GLFW_CALLS) && !defined(RIO_USE_EGL)
     RIO_LOG("WARNING: Window::initialize_ was called, but this was built with the definition RIO_NO_GLFW_CALLS set, which means that no GLFW calls will be made, and no windows will ever be created. This program will probably crash now.\n");
+#else
+#ifdef RIO_DEBUG
+    // Measure context creation latency
+    const auto start_time = std::chrono::steady_clock::now();
+#endif // RIO_DEBUG
+
+#ifdef RIO_USE_EGL
+    RIO_LOG("OpenGL Context Version: %u.%u\n", gl_major, gl_minor);
+    if (!initializeEGL_(gl_major, gl_minor))
+    {
+        RIO_LOG("Failed to create EGL context.\n");
+        terminate_();
+        return false;
+    }
 #else
     glfwSetErrorCallback(errorCallbackForGLFW);
 
@@ -129,7 +214,7 @@ bool Window::initialize_(bool resizable, bool invisible, u32 gl_major, u32 gl_mi
         glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
     }
 
-    if (invisible)
+    if (invisible || offscreen)
     {
         // make window invisible for headless operations
         glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
@@ -155,8 +240,8 @@ bool Window::initialize_(bool resizable, bool invisible, u32 gl_major, u32 gl_mi
     glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
 #endif
 
-    // Enforce double-buffering
-    glfwWindowHint(GLFW_DOUBLEBUFFER, GLFW_TRUE);
+    // Enforce double-buffering, unless the window frame buffer is never presented
+    glfwWindowHint(GLFW_DOUBLEBUFFER, offscreen ? GLFW_FALSE : GLFW_TRUE);
 
 
     // Create the window instance
@@ -182,6 +267,7 @@ bool Window::initialize_(bool resizable, bool invisible, u32 gl_major, u32 gl_mi
     printf("EGL %d.%d\n", GLAD_VERSION_MAJOR(egl_version), GLAD_VERSION_MINOR(egl_version));
 #endif
 */
+#endif // RIO_USE_EGL
 
 #ifndef RIO_NO_GL_LOADER
     #if RIO_USE_GLEW
@@ -198,10 +284,15 @@ bool Window::initialize_(bool resizable, bool invisible, u32 gl_major, u32 gl_mi
             }
     #else
         // use GLAD by default
+        #ifdef RIO_USE_EGL
+            GLADloadfunc load_func = &EGLGetProc;
+        #else
+            GLADloadfunc load_func = glfwGetProcAddress;
+        #endif // RIO_USE_EGL
         #ifdef RIO_GLES
-            gladLoadGLES2(glfwGetProcAddress);
+            gladLoadGLES2(load_func);
         #else
-            gladLoadGL(glfwGetProcAddress);
+            gladLoadGL(load_func);
         #endif // RIO_GLES
     #endif // RIO_USE_GLEW
 
@@ -268,24 +359,28 @@ bool Window::initialize_(bool resizable, bool invisible, u32 gl_major, u32 gl_mi
     // Therefore, we will render it to our own frame buffer, then render that
     // frame buffer upside-down to the window frame buffer.
 
-    // Load screen shader
-    gScreenShader.load("screen_shader_win");
-
-    // Create and setup vertex array and buffer
-    gVertexArray = new VertexArray();
-    gVertexBuffer = new VertexBuffer(vertices, sizeof(vertices), sizeof(Vertex), 0);
-    if (!gVertexArray || !gVertexBuffer)
+    // (In offscreen mode, our frame buffer is never presented, so none of this is needed.)
+    if (!offscreen)
     {
-        RIO_LOG("Failed to create vertex array or buffer.\n");
-        terminate_();
-        return false;
+        // Load screen shader
+        gScreenShader.load("screen_shader_win");
+
+        // Create and setup vertex array and buffer
+        gVertexArray = new VertexArray();
+        gVertexBuffer = new VertexBuffer(vertices, sizeof(vertices), sizeof(Vertex), 0);
+        if (!gVertexArray || !gVertexBuffer)
+        {
+            RIO_LOG("Failed to create vertex array or buffer.\n");
+            terminate_();
+            return false;
+        }
+
+        // Process Vertex Array
+        gVertexArray->addAttribute(gPosStream, *gVertexBuffer);
+        gVertexArray->addAttribute(gTexCoordStream, *gVertexBuffer);
+        gVertexArray->process();
     }
 
-    // Process Vertex Array
-    gVertexArray->addAttribute(gPosStream, *gVertexBuffer);
-    gVertexArray->addAttribute(gTexCoordStream, *gVertexBuffer);
-    gVertexArray->process();
-
     // Create and bind the Frame Buffer
     if (!createFb_())
     {
@@ -299,27 +394,341 @@ bool Window::initialize_(bool resizable, bool invisible, u32 gl_major, u32 gl_mi
     RIO_GL_CALL(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, mNativeWindow.mDepthBufferHandle));
 #endif
 
+    // Nothing is known about the state of the new context
+    GLStateCache::invalidate();
+
     // Enable scissor test
     RIO_GL_CALL(glEnable(GL_SCISSOR_TEST));
 
+#ifndef RIO_USE_EGL
     // Set callback if window is resizable
     if (resizable)
         glfwSetFramebufferSizeCallback(mNativeWindow.mpGLFWwindow, &Window::resizeCallback_);
+#endif // RIO_USE_EGL
+
+#ifdef RIO_DEBUG
+    RIO_LOG("Window initialized in %.3f ms\n", std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start_time).count());
+#endif // RIO_DEBUG
 #endif // RIO_NO_GLFW_CALLS
     return true;
 }
 
+#ifdef RIO_USE_EGL
+
+bool Window::initializeEGL_(u32 gl_major, u32 gl_minor)
+{
+    // Load libEGL ourselves, as glad's loader needs a display to be given
+    gEGLLibrary = dlopen("libEGL.so.1", RTLD_NOW | RTLD_LOCAL);
+    if (!gEGLLibrary)
+        gEGLLibrary = dlopen("libEGL.so", RTLD_NOW | RTLD_LOCAL);
+    if (!gEGLLibrary)
+    {
+        RIO_LOG("Failed to load libEGL.\n");
+        return false;
+    }
+
+    gEGLGetProcAddress = reinterpret_cast<PFNEGLGETPROCADDRESSPROC>(dlsym(gEGLLibrary, "eglGetProcAddress"));
+    PFNEGLQUERYSTRINGPROC query_string = reinterpret_cast<PFNEGLQUERYSTRINGPROC>(dlsym(gEGLLibrary, "eglQueryString"));
+    PFNEGLGETDISPLAYPROC get_display = reinterpret_cast<PFNEGLGETDISPLAYPROC>(dlsym(gEGLLibrary, "eglGetDisplay"));
+    if (!gEGLGetProcAddress || !query_string || !get_display)
+    {
+        RIO_LOG("Failed to retrieve EGL entry points.\n");
+        return false;
+    }
+
+    // Prefer the surfaceless platform, which does not need any display server
+    EGLDisplay display = EGL_NO_DISPLAY;
+    const char* client_extensions = query_string(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (EGLHasExtension(client_extensions, "EGL_MESA_platform_surfaceless"))
+    {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display =
+            reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(gEGLGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (get_platform_display)
+            display = get_platform_display(RIO_EGL_PLATFORM_SURFACELESS_MESA, nullptr, nullptr);
+    }
+    if (display == EGL_NO_DISPLAY)
+        display = get_display(RIO_EGL_DEFAULT_DISPLAY);
+    if (display == EGL_NO_DISPLAY)
+    {
+        RIO_LOG("Failed to get EGL display.\n");
+        return false;
+    }
+
+    if (!gladLoadEGL(display, &EGLGetProc))
+    {
+        RIO_LOG("Failed to load EGL.\n");
+        return false;
+    }
+
+    EGLint egl_major, egl_minor;
+    if (!eglInitialize(display, &egl_major, &egl_minor))
+    {
+        RIO_LOG("Failed to initialize EGL display (error: 0x%04X).\n", eglGetError());
+        return false;
+    }
+    mNativeWindow.mEGLDisplay = display;
+    RIO_LOG("EGL Version: %d.%d\n", egl_major, egl_minor);
+
+    // The version can only be queried from an initialized display,
+    // so only EGL 1.0 functions have been loaded so far
+    if (!gladLoadEGL(display, &EGLGetProc))
+    {
+        RIO_LOG("Failed to load EGL.\n");
+        return false;
+    }
+
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    const bool has_create_context = EGLHasExtension(extensions, "EGL_KHR_create_context");
+    const bool has_surfaceless_context = EGLHasExtension(extensions, "EGL_KHR_surfaceless_context");
+
+#ifdef RIO_GLES
+    eglBindAPI(EGL_OPENGL_ES_API);
+    const EGLint renderable_type = (gl_major >= 3 && has_create_context) ? RIO_EGL_OPENGL_ES3_BIT_KHR : RIO_EGL_OPENGL_ES2_BIT;
+#else
+    eglBindAPI(RIO_EGL_OPENGL_API);
+    const EGLint renderable_type = RIO_EGL_OPENGL_BIT;
+#endif // RIO_GLES
+
+    // Depth and stencil are not needed, as we render to our own Frame Buffer
+    const EGLint config_attribs[] = {
+        EGL_SURFACE_TYPE,       EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE,    renderable_type,
+        EGL_RED_SIZE,           8,
+        EGL_GREEN_SIZE,         8,
+        EGL_BLUE_SIZE,          8,
+        EGL_ALPHA_SIZE,         8,
+        EGL_NONE
+    };
+
+    EGLConfig config;
+    EGLint config_num = 0;
+    if (!eglChooseConfig(display, config_attribs, &config, 1, &config_num) || config_num == 0)
+    {
+        RIO_LOG("Failed to find a suitable EGL config.\n");
+        return false;
+    }
+
+    mNativeWindow.mEGLConfig = config;
+
+    EGLint* context_attribs = mNativeWindow.mEGLContextAttribs;
+    {
+        u32 i = 0;
+        if (has_create_context)
+        {
+            context_attribs[i++] = RIO_EGL_CONTEXT_MAJOR_VERSION_KHR;
+            context_attribs[i++] = gl_major;
+            context_attribs[i++] = RIO_EGL_CONTEXT_MINOR_VERSION_KHR;
+            context_attribs[i++] = gl_minor;
+#ifndef RIO_GLES
+            context_attribs[i++] = RIO_EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR;
+            context_attribs[i++] = RIO_EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR;
+#endif // RIO_GLES
+        }
+#ifdef RIO_GLES
+        else
+        {
+            // Same value as EGL_CONTEXT_CLIENT_VERSION
+            context_attribs[i++] = RIO_EGL_CONTEXT_MAJOR_VERSION_KHR;
+            context_attribs[i++] = gl_major;
+        }
+#endif // RIO_GLES
+        context_attribs[i] = EGL_NONE;
+    }
+
+    mNativeWindow.mEGLContext = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attribs);
+    if (mNativeWindow.mEGLContext == EGL_NO_CONTEXT)
+    {
+        RIO_LOG("Failed to create EGL context (error: 0x%04X).\n", eglGetError());
+        return false;
+    }
+
+    if (!has_surfaceless_context)
+    {
+        const EGLint pbuffer_attribs[] = {
+            EGL_WIDTH,  1,
+            EGL_HEIGHT, 1,
+            EGL_NONE
+        };
+
+        mNativeWindow.mEGLSurface = eglCreatePbufferSurface(display, config, pbuffer_attribs);
+        if (mNativeWindow.mEGLSurface == EGL_NO_SURFACE)
+        {
+            RIO_LOG("Failed to create EGL pbuffer surface (error: 0x%04X).\n", eglGetError());
+            return false;
+        }
+    }
+
+    if (!eglMakeCurrent(display, mNativeWindow.mEGLSurface, mNativeWindow.mEGLSurface, mNativeWindow.mEGLContext))
+    {
+        RIO_LOG("Failed to make EGL context current (error: 0x%04X).\n", eglGetError());
+        return false;
+    }
+
+    return true;
+}
+
+void Window::terminateEGL_()
+{
+    if (mNativeWindow.mEGLDisplay != EGL_NO_DISPLAY)
+    {
+        eglMakeCurrent(mNativeWindow.mEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+        if (mNativeWindow.mEGLSurface != EGL_NO_SURFACE)
+        {
+            eglDestroySurface(mNativeWindow.mEGLDisplay, mNativeWindow.mEGLSurface);
+            mNativeWindow.mEGLSurface = EGL_NO_SURFACE;
+        }
+
+        if (mNativeWindow.mEGLContext != EGL_NO_CONTEXT)
+        {
+            eglDestroyContext(mNativeWindow.mEGLDisplay, mNativeWindow.mEGLContext);
+            mNativeWindow.mEGLContext = EGL_NO_CONTEXT;
+        }
+
+        eglTerminate(mNativeWindow.mEGLDisplay);
+        mNativeWindow.mEGLDisplay = EGL_NO_DISPLAY;
+    }
+
+    if (gEGLLibrary)
+    {
+        dlclose(gEGLLibrary);
+        gEGLLibrary = nullptr;
+        gEGLGetProcAddress = nullptr;
+    }
+}
+
+#endif // RIO_USE_EGL
+
+bool Window::createSharedContext_(NativeWindow::SharedContext* p_context) const
+{
+#ifdef RIO_USE_EGL
+    p_context->context = EGL_NO_CONTEXT;
+    p_context->surface = EGL_NO_SURFACE;
+
+    p_context->context = eglCreateContext(mNativeWindow.mEGLDisplay, mNativeWindow.mEGLConfig, mNativeWindow.mEGLContext, mNativeWindow.mEGLContextAttribs);
+    if (p_context->context == EGL_NO_CONTEXT)
+    {
+        RIO_LOG("Failed to create shared EGL context (error: 0x%04X).\n", eglGetError());
+        return false;
+    }
+
+    // The window's context only has a surface if surfaceless contexts are not supported
+    if (mNativeWindow.mEGLSurface != EGL_NO_SURFACE)
+    {
+        const EGLint pbuffer_attribs[] = {
+            EGL_WIDTH,  1,
+            EGL_HEIGHT, 1,
+            EGL_NONE
+        };
+
+        p_context->surface = eglCreatePbufferSurface(mNativeWindow.mEGLDisplay, mNativeWindow.mEGLConfig, pbuffer_attribs);
+        if (p_context->surface == EGL_NO_SURFACE)
+        {
+            RIO_LOG("Failed to create EGL pbuffer surface (error: 0x%04X).\n", eglGetError());
+            destroySharedContext_(p_context);
+            return false;
+        }
+    }
+
+    return true;
+#elif !defined(RIO_NO_GLFW_CALLS)
+    // Use a hidden window, as GLFW has no other way to create a context
+    // (Context hints are still those used to create the window)
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    p_context->pGLFWwindow = glfwCreateWindow(1, 1, "", nullptr, mNativeWindow.mpGLFWwindow);
+    if (!p_context->pGLFWwindow)
+    {
+        RIO_LOG("Failed to create shared GLFW context.\n");
+        return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Window::destroySharedContext_(NativeWindow::SharedContext* p_context) const
+{
+#ifdef RIO_USE_EGL
+    if (p_context->surface != EGL_NO_SURFACE)
+    {
+        eglDestroySurface(mNativeWindow.mEGLDisplay, p_context->surface);
+        p_context->surface = EGL_NO_SURFACE;
+    }
+
+    if (p_context->context != EGL_NO_CONTEXT)
+    {
+        eglDestroyContext(mNativeWindow.mEGLDisplay, p_context->context);
+        p_context->context = EGL_NO_CONTEXT;
+    }
+#elif !defined(RIO_NO_GLFW_CALLS)
+    if (p_context->pGLFWwindow)
+    {
+        glfwDestroyWindow(p_context->pGLFWwindow);
+        p_context->pGLFWwindow = nullptr;
+    }
+#endif
+}
+
+void Window::makeSharedContextCurrent_(const NativeWindow::SharedContext* p_context) const
+{
+#ifdef RIO_USE_EGL
+    if (p_context)
+        eglMakeCurrent(mNativeWindow.mEGLDisplay, p_context->surface, p_context->surface, p_context->context);
+    else
+        eglMakeCurrent(mNativeWindow.mEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+#elif !defined(RIO_NO_GLFW_CALLS)
+    glfwMakeContextCurrent(p_context ? p_context->pGLFWwindow : nullptr);
+#endif
+}
+
+void Window::setupSharedContext_() const
+{
+    // Each thread tracks the state of its own context
+    GLStateCache::invalidate();
+
+#ifndef RIO_NO_CLIP_CONTROL
+#if RIO_USE_GLEW
+    if (GLEW_VERSION_4_5 || GLEW_ARB_clip_control)
+#else
+    if (GLAD_GL_VERSION_4_5 || GLAD_GL_ARB_clip_control)
+#endif // RIO_USE_GLEW
+    {
+        RIO_GL_CALL(glClipControl(GL_UPPER_LEFT, GL_NEGATIVE_ONE_TO_ONE));
+    }
+#endif // RIO_NO_CLIP_CONTROL
+
+    RIO_GL_CALL(glEnable(GL_SCISSOR_TEST));
+}
+
 bool Window::isRunning() const
 {
-#ifndef RIO_NO_GLFW_CALLS
+#ifdef RIO_USE_EGL
+    return !mNativeWindow.mIsClosing;
+#elif !defined(RIO_NO_GLFW_CALLS)
     return !glfwWindowShouldClose(mNativeWindow.mpGLFWwindow);
 #else
     return false;
 #endif
 }
 
+void Window::close()
+{
+#ifdef RIO_USE_EGL
+    mNativeWindow.mIsClosing = true;
+#elif !defined(RIO_NO_GLFW_CALLS)
+    glfwSetWindowShouldClose(mNativeWindow.mpGLFWwindow, GLFW_TRUE);
+#endif
+}
+
 void Window::terminate_()
 {
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    destroyReadbackBuffers_();
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
     destroyFb_();
 
     if (gVertexBuffer)
@@ -335,7 +744,9 @@ void Window::terminate_()
     }
 
     gScreenShader.unload();
-#ifndef RIO_NO_GLFW_CALLS
+#ifdef RIO_USE_EGL
+    terminateEGL_();
+#elif !defined(RIO_NO_GLFW_CALLS)
     glfwTerminate();
 #endif
 }
@@ -356,7 +767,7 @@ bool Window::createFb_()
         return false;
 
     // Set Color Buffer dimensions and format
-    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, mNativeWindow.mColorBufferTextureHandle));
+    GLStateCache::bindTexture2DScratch(mNativeWindow.mColorBufferTextureHandle);
 #if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
     RIO_GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0));
     RIO_GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
@@ -364,7 +775,7 @@ bool Window::createFb_()
     RIO_GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, mWidth, mHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
     RIO_GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
     RIO_GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
-    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, GL_NONE));
+    GLStateCache::bindTexture2DScratch(GL_NONE);
     mNativeWindow.mColorBufferTextureFormat = TEXTURE_FORMAT_R8_G8_B8_A8_UNORM;
 
     // Attach it to the Frame Buffer
@@ -396,13 +807,13 @@ bool Window::createFb_()
         return false;
 
     // Set Depth-Stencil Buffer dimensions and format
-    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, mNativeWindow.mDepthBufferTextureHandle));
+    GLStateCache::bindTexture2DScratch(mNativeWindow.mDepthBufferTextureHandle);
     RIO_GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0));
     RIO_GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
     RIO_GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, mWidth, mHeight, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr));
     RIO_GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
     RIO_GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
-    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, GL_NONE));
+    GLStateCache::bindTexture2DScratch(GL_NONE);
     mNativeWindow.mDepthBufferTextureFormat = TextureFormat(0x00000011);
 
     // Create the source framebuffer with a depth-stencil renderbuffer
@@ -458,6 +869,7 @@ void Window::destroyFb_()
 
     if (mNativeWindow.mDepthBufferTextureHandle != GL_NONE)
     {
+        GLStateCache::onTextureDeleted(mNativeWindow.mDepthBufferTextureHandle);
         RIO_GL_CALL(glDeleteTextures(1, &mNativeWindow.mDepthBufferTextureHandle));
         mNativeWindow.mDepthBufferTextureHandle = GL_NONE;
     }
@@ -470,6 +882,7 @@ void Window::destroyFb_()
 
     if (mNativeWindow.mColorBufferTextureHandle != GL_NONE)
     {
+        GLStateCache::onTextureDeleted(mNativeWindow.mColorBufferTextureHandle);
         RIO_GL_CALL(glDeleteTextures(1, &mNativeWindow.mColorBufferTextureHandle));
         mNativeWindow.mColorBufferTextureHandle = GL_NONE;
     }
@@ -483,7 +896,9 @@ void Window::destroyFb_()
 
 void Window::makeContextCurrent() const
 {
-#ifndef RIO_NO_GLFW_CALLS
+#ifdef RIO_USE_EGL
+    eglMakeCurrent(mNativeWindow.mEGLDisplay, mNativeWindow.mEGLSurface, mNativeWindow.mEGLSurface, mNativeWindow.mEGLContext);
+#elif !defined(RIO_NO_GLFW_CALLS)
     glfwMakeContextCurrent(mNativeWindow.mpGLFWwindow);
 #endif
     // Bind our Frame Buffer
@@ -518,6 +933,21 @@ void Window::restoreVp_() const
 
 void Window::swapBuffers() const
 {
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    // Upload the data of pending textures, spread across frames
+    if (TextureUploader::instance())
+        TextureUploader::instance()->update();
+#endif
+
+    if (mNativeWindow.mIsOffscreen)
+    {
+        // Nothing is presented: our Frame Buffer stays bound, there is no
+        // swap interval to wait for and no window events to process
+        RIO_GL_CALL(glFlush());
+        GLStateCache::endFrame();
+        return;
+    }
+
     // Bind the default (window) Frame Buffer
     RIO_GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, GL_NONE));
 
@@ -534,11 +964,12 @@ void Window::swapBuffers() const
     gVertexArray->bind();
 
     // Bind screen texture (Color Buffer texture)
-    RIO_GL_CALL(glActiveTexture(GL_TEXTURE0));
-    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, mNativeWindow.mColorBufferTextureHandle));
+    GLStateCache::bindTexture2D(0, mNativeWindow.mColorBufferTextureHandle);
+    GLStateCache::bindSampler(0, GL_NONE);
 
     // Draw it
     RIO_GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 6));
+    GLStateCache::endFrame();
 #ifndef RIO_NO_GLFW_CALLS
     // Swap front and back buffers
     glfwSwapBuffers(mNativeWindow.mpGLFWwindow);
@@ -600,7 +1031,7 @@ void Window::clearDepth()
     setVpToFb_();
 
     // Clear
-    RIO_GL_CALL(glDepthMask(GL_TRUE));
+    GLStateCache::setDepthMask(true);
     RIO_GL_CALL(glClearDepth(1.0f));
     RIO_GL_CALL(glClear(GL_DEPTH_BUFFER_BIT));
 
@@ -617,7 +1048,7 @@ void Window::clearDepth(f32 depth)
     setVpToFb_();
 
     // Clear
-    RIO_GL_CALL(glDepthMask(GL_TRUE));
+    GLStateCache::setDepthMask(true);
     RIO_GL_CALL(glClearDepth(depth));
     RIO_GL_CALL(glClear(GL_DEPTH_BUFFER_BIT));
 
@@ -634,7 +1065,7 @@ void Window::clearStencil()
     setVpToFb_();
 
     // Clear
-    RIO_GL_CALL(glStencilMask(0xFF));
+    GLStateCache::setStencilMask(0xFF);
     RIO_GL_CALL(glClearStencil(0));
     RIO_GL_CALL(glClear(GL_STENCIL_BUFFER_BIT));
 
@@ -651,7 +1082,7 @@ void Window::clearStencil(u8 stencil)
     setVpToFb_();
 
     // Clear
-    RIO_GL_CALL(glStencilMask(0xFF));
+    GLStateCache::setStencilMask(0xFF);
     RIO_GL_CALL(glClearStencil(stencil));
     RIO_GL_CALL(glClear(GL_STENCIL_BUFFER_BIT));
 
@@ -668,9 +1099,9 @@ void Window::clearDepthStencil()
     setVpToFb_();
 
     // Clear
-    RIO_GL_CALL(glDepthMask(GL_TRUE));
+    GLStateCache::setDepthMask(true);
     RIO_GL_CALL(glClearDepth(1.0f));
-    RIO_GL_CALL(glStencilMask(0xFF));
+    GLStateCache::setStencilMask(0xFF);
     RIO_GL_CALL(glClearStencil(0));
     RIO_GL_CALL(glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT));
 
@@ -687,9 +1118,9 @@ void Window::clearDepthStencil(f32 depth, u8 stencil)
     setVpToFb_();
 
     // Clear
-    RIO_GL_CALL(glDepthMask(GL_TRUE));
+    GLStateCache::setDepthMask(true);
     RIO_GL_CALL(glClearDepth(depth));
-    RIO_GL_CALL(glStencilMask(0xFF));
+    GLStateCache::setStencilMask(0xFF);
     RIO_GL_CALL(glClearStencil(stencil));
     RIO_GL_CALL(glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT));
 
@@ -702,16 +1133,202 @@ void Window::updateDepthBufferTexture_()
 #if defined(RIO_GLES) && !defined(GL_ES_VERSION_3_0)
     RIO_ASSERT(false);
 #else
-    Graphics::setViewport(0, 0, mWidth, mHeight);
-    Graphics::setScissor(0, 0, mWidth, mHeight);
+    // Blits are scissored, but the viewport and scissor set through Graphics are kept
+    setVpToFb_();
 
     // Blit the depth-stencil renderbuffer to the depth-stencil texture
     RIO_GL_CALL(glBindFramebuffer(GL_READ_FRAMEBUFFER, mNativeWindow.mDepthBufferCopyFramebufferSrc));
     RIO_GL_CALL(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mNativeWindow.mDepthBufferCopyFramebufferDst));
     RIO_GL_CALL(glBlitFramebuffer(0, 0, mWidth, mHeight, 0, 0, mWidth, mHeight, GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT, GL_NEAREST));
+
+    restoreVp_();
 #endif
 }
 
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+bool Window::requestReadback(bool read_depth)
+{
+    if (mNativeWindow.mReadbackNum >= NativeWindow::cReadbackBufferNum)
+        return false;
+
+#ifdef RIO_GLES
+    // GL_DEPTH_STENCIL is not a valid glReadPixels() format in OpenGL ES
+    if (read_depth)
+        return false;
+#endif // RIO_GLES
+
+    const u32 idx = (mNativeWindow.mReadbackHead + mNativeWindow.mReadbackNum) % NativeWindow::cReadbackBufferNum;
+    NativeWindow::ReadbackBuffer& readback = mNativeWindow.mReadbackBuffer[idx];
+
+    // Both RGBA8 and D24S8 are 4 bytes per pixel
+    const u32 size = mWidth * mHeight * 4;
+
+    if (readback.colorHandle == GL_NONE)
+    {
+        RIO_GL_CALL(glGenBuffers(1, &readback.colorHandle));
+        RIO_ASSERT(readback.colorHandle != GL_NONE);
+        RIO_GL_CALL(glGenBuffers(1, &readback.depthHandle));
+        RIO_ASSERT(readback.depthHandle != GL_NONE);
+        readback.size = 0;
+    }
+
+    if (readback.size != size)
+    {
+        RIO_GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.colorHandle));
+        RIO_GL_CALL(glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ));
+        RIO_GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.depthHandle));
+        RIO_GL_CALL(glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ));
+        readback.size = size;
+    }
+
+    GLint pack_alignment;
+    RIO_GL_CALL(glGetIntegerv(GL_PACK_ALIGNMENT, &pack_alignment));
+    RIO_GL_CALL(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+
+    // Read the Color Buffer into the pixel pack buffer
+    RIO_GL_CALL(glBindFramebuffer(GL_READ_FRAMEBUFFER, mNativeWindow.mFramebufferHandle));
+    RIO_GL_CALL(glReadBuffer(GL_COLOR_ATTACHMENT0));
+    RIO_GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.colorHandle));
+    RIO_GL_CALL(glReadPixels(0, 0, mWidth, mHeight, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+
+    if (read_depth)
+    {
+        // Update the Depth-Stencil Buffer texture and read it into the pixel pack buffer
+        updateDepthBufferTexture_();
+
+        RIO_GL_CALL(glBindFramebuffer(GL_READ_FRAMEBUFFER, mNativeWindow.mDepthBufferCopyFramebufferDst));
+        RIO_GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.depthHandle));
+        RIO_GL_CALL(glReadPixels(0, 0, mWidth, mHeight, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr));
+    }
+
+    RIO_GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, GL_NONE));
+    RIO_GL_CALL(glPixelStorei(GL_PACK_ALIGNMENT, pack_alignment));
+
+    RIO_GL_CALL(readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    readback.hasDepth = read_depth;
+
+    mNativeWindow.mReadbackNum++;
+
+    // Restore our Frame Buffer
+    makeContextCurrent();
+    return true;
+}
+
+bool Window::tryGetReadback(void* color_pixels, void* depth_pixels, bool wait)
+{
+    RIO_ASSERT(color_pixels);
+
+    if (mNativeWindow.mReadbackNum == 0)
+        return false;
+
+    NativeWindow::ReadbackBuffer& readback = mNativeWindow.mReadbackBuffer[mNativeWindow.mReadbackHead];
+    RIO_ASSERT(readback.fence != nullptr);
+
+    GLenum status;
+    if (wait)
+    {
+        do
+        {
+            RIO_GL_CALL(status = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000));
+        }
+        while (status == GL_TIMEOUT_EXPIRED);
+    }
+    else
+    {
+        RIO_GL_CALL(status = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+        if (status == GL_TIMEOUT_EXPIRED)
+            return false;
+    }
+    RIO_ASSERT(status != GL_WAIT_FAILED);
+
+    bool success = true;
+
+    RIO_GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.colorHandle));
+    const void* src;
+    RIO_GL_CALL(src = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, readback.size, GL_MAP_READ_BIT));
+    if (src != nullptr)
+    {
+        MemUtil::copy(color_pixels, src, readback.size);
+        RIO_GL_CALL(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    }
+    else
+    {
+        success = false;
+    }
+
+    if (success && depth_pixels != nullptr && readback.hasDepth)
+    {
+        RIO_GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.depthHandle));
+        RIO_GL_CALL(src = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, readback.size, GL_MAP_READ_BIT));
+        if (src != nullptr)
+        {
+            MemUtil::copy(depth_pixels, src, readback.size);
+            RIO_GL_CALL(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+        }
+        else
+        {
+            success = false;
+        }
+    }
+
+    RIO_GL_CALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, GL_NONE));
+
+    // The readback is retired even if it could not be mapped, as mapping it again would fail as well
+    if (!success)
+        RIO_LOG("Window::tryGetReadback(): Failed to map the pixel pack buffer, the readback is dropped.\n");
+
+    RIO_GL_CALL(glDeleteSync(readback.fence));
+    readback.fence = nullptr;
+
+    mNativeWindow.mReadbackHead = (mNativeWindow.mReadbackHead + 1) % NativeWindow::cReadbackBufferNum;
+    mNativeWindow.mReadbackNum--;
+
+    return success;
+}
+
+void Window::discardReadbacks()
+{
+    for (u32 i = 0; i < NativeWindow::cReadbackBufferNum; i++)
+    {
+        NativeWindow::ReadbackBuffer& readback = mNativeWindow.mReadbackBuffer[i];
+        if (readback.fence != nullptr)
+        {
+            RIO_GL_CALL(glDeleteSync(readback.fence));
+            readback.fence = nullptr;
+        }
+    }
+
+    mNativeWindow.mReadbackHead = 0;
+    mNativeWindow.mReadbackNum = 0;
+}
+
+void Window::destroyReadbackBuffers_()
+{
+    discardReadbacks();
+
+    for (u32 i = 0; i < NativeWindow::cReadbackBufferNum; i++)
+    {
+        NativeWindow::ReadbackBuffer& readback = mNativeWindow.mReadbackBuffer[i];
+
+        if (readback.colorHandle != GL_NONE)
+        {
+            RIO_GL_CALL(glDeleteBuffers(1, &readback.colorHandle));
+            readback.colorHandle = GL_NONE;
+        }
+
+        if (readback.depthHandle != GL_NONE)
+        {
+            RIO_GL_CALL(glDeleteBuffers(1, &readback.depthHandle));
+            readback.depthHandle = GL_NONE;
+        }
+
+        readback.size = 0;
+    }
+}
+
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
 }
 
 #endif // RIO_IS_WIN
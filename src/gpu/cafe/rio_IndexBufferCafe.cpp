@@ -0,0 +1,39 @@
+#include <misc/rio_Types.h>
+
+#if RIO_IS_CAFE
+
+#include <gpu/rio_IndexBuffer.h>
+
+#include <gx2/mem.h>
+
+namespace rio {
+
+IndexBuffer::IndexBuffer()
+    : mpData(nullptr)
+    , mCount(0)
+    , mFormat(FORMAT_U16)
+{
+}
+
+IndexBuffer::~IndexBuffer()
+{
+}
+
+void IndexBuffer::setData_(const void* data, u32 count, Format format)
+{
+    RIO_ASSERT(data != nullptr);
+    RIO_ASSERT(count != 0);
+
+    mpData = data;
+    mCount = count;
+    mFormat = format;
+}
+
+void IndexBuffer::invalidateCache(const void* data, u32 size)
+{
+    GX2Invalidate(GX2_INVALIDATE_MODE_CPU_ATTRIBUTE_BUFFER, (void*)data, size);
+}
+
+}
+
+#endif // RIO_IS_CAFE
@@ -154,6 +154,17 @@ void Shader::load(const char* base_fname, ShaderMode exp_mode)
     mSelfAllocated = true;
 }
 
+void Shader::loadAsync(const char* base_fname, ShaderMode exp_mode)
+{
+    // Shaders are precompiled
+    load(base_fname, exp_mode);
+}
+
+bool Shader::isReady() const
+{
+    return mLoaded;
+}
+
 void Shader::load(GX2VertexShader* p_vertex_shader, GX2PixelShader* p_pixel_shader)
 {
     unload();
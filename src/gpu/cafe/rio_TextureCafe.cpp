@@ -10,14 +10,15 @@
 
 namespace rio {
 
-Texture2D::Texture2D(const char* base_fname)
+Texture2D::Texture2D(const char* base_fname, bool keep_image_data, bool, bool)
     : mSelfAllocated(true)
 {
     FileDevice::LoadArg arg;
     arg.path = std::string("textures/") + base_fname + ".gtx";
+    arg.heap_type = MemUtil::HEAP_TYPE_TEXTURE;
 
     u8* const file = FileDeviceMgr::instance()->load(arg);
-    load_(file, arg.read_size);
+    load_(file, arg.read_size, keep_image_data);
     MemUtil::free(file);
 }
 
@@ -46,10 +47,10 @@ Texture2D::Texture2D(TextureFormat format, u32 width, u32 height, u32 numMips)
     u32 alignment = mTextureInner.surface.alignment;
 
     u32 imageSize = mTextureInner.surface.imageSize;
-    void* image = imageSize ? MemUtil::alloc(imageSize, alignment) : nullptr;
+    void* image = imageSize ? MemUtil::alloc(imageSize, alignment, MemUtil::HEAP_TYPE_TEXTURE) : nullptr;
 
     u32 mipSize = mTextureInner.surface.mipmapSize;
-    void* mipmaps = mipSize ? MemUtil::alloc(mipSize, alignment) : nullptr;
+    void* mipmaps = mipSize ? MemUtil::alloc(mipSize, alignment, MemUtil::HEAP_TYPE_TEXTURE) : nullptr;
 
     if (imageSize)
     {
@@ -74,15 +75,15 @@ Texture2D::Texture2D(TextureFormat format, u32 width, u32 height, u32 numMips)
     createHandle_();
 }
 
-void Texture2D::load_(const u8* file, u32)
+void Texture2D::load_(const u8* file, u32, bool)
 {
     u32 alignment = GFDGetTextureAlignmentSize(0, file);
 
     u32 imageSize = GFDGetTextureImageSize(0, file);
-    void* image = imageSize ? MemUtil::alloc(imageSize, alignment) : nullptr;
+    void* image = imageSize ? MemUtil::alloc(imageSize, alignment, MemUtil::HEAP_TYPE_TEXTURE) : nullptr;
 
     u32 mipSize = GFDGetTextureMipImageSize(0, file);
-    void* mipmaps = mipSize ? MemUtil::alloc(mipSize, alignment) : nullptr;
+    void* mipmaps = mipSize ? MemUtil::alloc(mipSize, alignment, MemUtil::HEAP_TYPE_TEXTURE) : nullptr;
 
     GFDGetTexture(&mTextureInner,
                   image,
@@ -144,6 +145,16 @@ void Texture2D::setCompMap(u32 compMap)
     GX2InitTextureRegs(&mTextureInner);
 }
 
+bool Texture2D::isReady() const
+{
+    return true;
+}
+
+bool Texture2D::isLoadFailed() const
+{
+    return false;
+}
+
 }
 
 #endif // RIO_IS_CAFE
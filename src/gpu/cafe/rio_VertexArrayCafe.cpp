@@ -21,7 +21,7 @@ VertexArray::~VertexArray()
 {
     if (mpFetchShaderBuf)
     {
-        delete[] (u8*)mpFetchShaderBuf;
+        MEMFreeToDefaultHeap(mpFetchShaderBuf);
         mpFetchShaderBuf = nullptr;
     }
 }
@@ -30,7 +30,7 @@ void VertexArray::initialize()
 {
     if (mpFetchShaderBuf)
     {
-        delete[] (u8*)mpFetchShaderBuf;
+        MEMFreeToDefaultHeap(mpFetchShaderBuf);
         mpFetchShaderBuf = nullptr;
     }
 
@@ -42,6 +42,7 @@ void VertexArray::initialize()
     }
 
     std::memset(mpVertexBuffer, 0, sizeof(VertexBuffer*) * VertexBuffer::NUM_MAX_BUFFERS);
+    mpIndexBuffer = nullptr;
 }
 
 void VertexArray::process()
@@ -59,6 +60,13 @@ void VertexArray::process()
         GX2_COMP_SEL_XYZW, GX2_COMP_SEL_XYZW
     };
 
+    // The vertex array can be processed again after adding attributes
+    if (mpFetchShaderBuf)
+    {
+        MEMFreeToDefaultHeap(mpFetchShaderBuf);
+        mpFetchShaderBuf = nullptr;
+    }
+
     u32 num_streams = 0;
     for (u32 i = 0; i < VertexBuffer::NUM_MAX_BUFFERS; i++)
     {
@@ -87,9 +95,16 @@ void VertexArray::process()
                 gx2_stream.format = (GX2AttribFormat)stream->mInternalFormat;
                 gx2_stream.mask = sFormatMask[stream->mInternalFormat & 0xff];
                 gx2_stream.endianSwap = GX2_ENDIAN_SWAP_DEFAULT;
-                // TODO
-                gx2_stream.type = GX2_ATTRIB_INDEX_PER_VERTEX;
-                gx2_stream.aluDivisor = 0;
+                if (vb->mInstanceStepRate != 0)
+                {
+                    gx2_stream.type = GX2_ATTRIB_INDEX_PER_INSTANCE;
+                    gx2_stream.aluDivisor = vb->mInstanceStepRate;
+                }
+                else
+                {
+                    gx2_stream.type = GX2_ATTRIB_INDEX_PER_VERTEX;
+                    gx2_stream.aluDivisor = 0;
+                }
             }
         }
     }
@@ -116,6 +131,8 @@ void VertexArray::process()
         GX2_TESSELLATION_MODE_DISCRETE      // ^^^^^^^^^^^^^^^
     );
 
+    delete[] streams;
+
     // Make sure to flush CPU cache and invalidate GPU cache
     GX2Invalidate(GX2_INVALIDATE_MODE_CPU_SHADER, fetch_shader->program, fetch_shader->size);
 }
@@ -4,6 +4,11 @@
 #include <gpu/rio_RenderTarget.h>
 #include <misc/rio_MemUtil.h>
 
+#if RIO_IS_WIN
+#include <gfx/win/rio_RenderWorkerMgrWin.h>
+#include <gpu/win/rio_GLStateCacheWin.h>
+#endif // RIO_IS_WIN
+
 #if RIO_IS_CAFE
 #include <gx2/clear.h>
 #include <gx2/event.h>
@@ -197,14 +202,14 @@ void RenderBuffer::clear(u32 color_target_index, u32 clear_flag, const Color4f&
 
         if (clear_flag & CLEAR_FLAG_DEPTH)
         {
-            RIO_GL_CALL(glDepthMask(GL_TRUE));
+            GLStateCache::setDepthMask(true);
             RIO_GL_CALL(glClearDepth(depth));
             clear_mask |= GL_DEPTH_BUFFER_BIT;
         }
 
         if (clear_flag & CLEAR_FLAG_STENCIL)
         {
-            RIO_GL_CALL(glStencilMask(0xFF));
+            GLStateCache::setStencilMask(0xFF);
             RIO_GL_CALL(glClearStencil(stencil));
             clear_mask |= GL_STENCIL_BUFFER_BIT;
         }
@@ -214,7 +219,16 @@ void RenderBuffer::clear(u32 color_target_index, u32 clear_flag, const Color4f&
 #endif
     }
 
-#ifndef RIO_NO_GLFW_CALLS
+#if RIO_IS_WIN && (!defined(RIO_GLES) || defined(GL_ES_VERSION_3_0))
+    if (const RenderWorker* worker = RenderWorker::current())
+    {
+        // Restore the render buffer of this render worker
+        worker->bind();
+        return;
+    }
+#endif
+
+#if !defined(RIO_NO_GLFW_CALLS) || defined(RIO_USE_EGL)
     Window::instance()->makeContextCurrent();
 
     u32 width = Window::instance()->getWidth();
@@ -275,7 +289,17 @@ bool RenderBuffer::read(
         glReadPixels(0, 0, width, height, native_format.format, native_format.type, pixels);
 #endif
     }
-#ifndef RIO_NO_GLFW_CALLS
+
+#if RIO_IS_WIN && (!defined(RIO_GLES) || defined(GL_ES_VERSION_3_0))
+    if (const RenderWorker* worker = RenderWorker::current())
+    {
+        // Restore the render buffer of this render worker
+        worker->bind();
+        return ret;
+    }
+#endif
+
+#if !defined(RIO_NO_GLFW_CALLS) || defined(RIO_USE_EGL)
     Window::instance()->makeContextCurrent();
 #endif
     return ret;
@@ -0,0 +1,97 @@
+#include <gpu/rio_ShaderCacher.h>
+
+namespace rio {
+
+ShaderCacher* ShaderCacher::sInstance = nullptr;
+
+bool ShaderCacher::createSingleton()
+{
+    if (sInstance)
+        return false;
+
+    sInstance = new ShaderCacher();
+    return true;
+}
+
+void ShaderCacher::destroySingleton()
+{
+    if (!sInstance)
+        return;
+
+    delete sInstance;
+    sInstance = nullptr;
+}
+
+ShaderCacher::ShaderCacher()
+{
+}
+
+ShaderCacher::~ShaderCacher()
+{
+    for (const auto& it : mShaderCache)
+    {
+        const Entry& entry = it.second;
+        if (entry.ref_count > 0)
+            RIO_LOG("ShaderCacher::~ShaderCacher(): Shader \"%s\" is still referenced %u time(s).\n", it.first.name.c_str(), entry.ref_count);
+
+        delete entry.shader;
+    }
+
+    mShaderCache.clear();
+}
+
+Shader* ShaderCacher::loadShader_(const char* base_fname, Shader::ShaderMode mode, bool async)
+{
+    RIO_ASSERT(base_fname);
+
+    auto it = mShaderCache.try_emplace(Key{ base_fname, mode }, Entry{ nullptr, 0 });
+    Entry& entry = it.first->second;
+
+    // Load it if it does not exist
+    if (it.second)
+    {
+        entry.shader = new Shader();
+        if (async)
+            entry.shader->loadAsync(base_fname, mode);
+        else
+            entry.shader->load(base_fname, mode);
+    }
+
+    entry.ref_count++;
+    return entry.shader;
+}
+
+void ShaderCacher::releaseShader(const char* base_fname, Shader::ShaderMode mode)
+{
+    RIO_ASSERT(base_fname);
+
+    auto it = mShaderCache.find(Key{ base_fname, mode });
+    if (it == mShaderCache.end())
+    {
+        RIO_LOG("ShaderCacher::releaseShader(): Shader \"%s\" is not in the cache.\n", base_fname);
+        RIO_ASSERT(false);
+        return;
+    }
+
+    Entry& entry = it->second;
+    RIO_ASSERT(entry.ref_count > 0);
+
+    if (--entry.ref_count == 0)
+    {
+        delete entry.shader;
+        mShaderCache.erase(it);
+    }
+}
+
+Shader* ShaderCacher::get(const char* base_fname, Shader::ShaderMode mode) const
+{
+    RIO_ASSERT(base_fname);
+
+    auto it = mShaderCache.find(Key{ base_fname, mode });
+    if (it != mShaderCache.end())
+        return it->second.shader;
+
+    return nullptr;
+}
+
+}
@@ -36,7 +36,11 @@ u8 TextureFormatUtil::getPixelByteSize(TextureFormat format)
     case TEXTURE_FORMAT_R10_G10_B10_A2_UINT:
   //case TEXTURE_FORMAT_R10_G10_B10_A2_SNORM:
   //case TEXTURE_FORMAT_R10_G10_B10_A2_SINT:
+    case DEPTH_FORMAT_D24_S8_UNORM:
+    case DEPTH_FORMAT_D24_S8_FLOAT:
         return 4;
+    case DEPTH_FORMAT_D32_FLOAT_S8_UINT_X24:
+        return 8;
     case TEXTURE_FORMAT_BC1_UNORM:
     case TEXTURE_FORMAT_BC1_SRGB:
     case TEXTURE_FORMAT_BC4_UNORM:
@@ -0,0 +1,164 @@
+#include <gpu/rio_TextureCacher.h>
+
+#if RIO_IS_WIN
+#include <gpu/win/rio_Texture2DUtilWin.h>
+#endif // RIO_IS_WIN
+
+namespace {
+
+static u32 GetTextureSize(const rio::Texture2D& texture)
+{
+    const rio::NativeSurface2D& surface = texture.getNativeTexture().surface;
+
+#if RIO_IS_CAFE
+    return surface.imageSize + surface.mipmapSize;
+#elif RIO_IS_WIN
+    const rio::TextureFormat format = texture.getTextureFormat();
+
+    return rio::Texture2DUtil::calcImageSize(format, surface.width, surface.height)
+         + rio::Texture2DUtil::calcMipmapSize(format, surface.width, surface.height, surface.mipLevels);
+#endif
+}
+
+}
+
+namespace rio {
+
+TextureCacher* TextureCacher::sInstance = nullptr;
+
+bool TextureCacher::createSingleton()
+{
+    if (sInstance)
+        return false;
+
+    sInstance = new TextureCacher();
+    return true;
+}
+
+void TextureCacher::destroySingleton()
+{
+    if (!sInstance)
+        return;
+
+    delete sInstance;
+    sInstance = nullptr;
+}
+
+TextureCacher::TextureCacher()
+    : mBudget(0)
+    , mSize(0)
+    , mEvictedNum(0)
+{
+}
+
+TextureCacher::~TextureCacher()
+{
+    for (const auto& it : mTextureCache)
+    {
+        const Entry& entry = it.second;
+        if (entry.ref_count > 0)
+            RIO_LOG("TextureCacher::~TextureCacher(): Texture \"%s\" is still referenced %u time(s).\n", it.first.c_str(), entry.ref_count);
+
+        delete entry.texture;
+    }
+
+    mTextureCache.clear();
+    mLRUList.clear();
+    mSize = 0;
+}
+
+Texture2D* TextureCacher::loadTexture(const char* base_fname)
+{
+    RIO_ASSERT(base_fname);
+
+    auto it = mTextureCache.try_emplace(base_fname, Entry{ nullptr, 0, 0, mLRUList.end() });
+    Entry& entry = it.first->second;
+
+    // Load it if it does not exist
+    if (it.second)
+    {
+        // Cached textures do not need their image data once uploaded,
+        // and are uploaded over the next frames if the texture uploader exists
+        entry.texture = new Texture2D(base_fname, false, true);
+        entry.size = GetTextureSize(*entry.texture);
+        mSize += entry.size;
+    }
+    else if (entry.ref_count == 0)
+    {
+        mLRUList.erase(entry.lru_it);
+        entry.lru_it = mLRUList.end();
+    }
+
+    entry.ref_count++;
+
+    // The new texture may push the cache over the budget
+    if (it.second)
+        evict_(mBudget);
+
+    return entry.texture;
+}
+
+void TextureCacher::releaseTexture(const char* base_fname)
+{
+    RIO_ASSERT(base_fname);
+
+    auto it = mTextureCache.find(base_fname);
+    if (it == mTextureCache.end())
+    {
+        RIO_LOG("TextureCacher::releaseTexture(): Texture \"%s\" is not in the cache.\n", base_fname);
+        RIO_ASSERT(false);
+        return;
+    }
+
+    Entry& entry = it->second;
+    RIO_ASSERT(entry.ref_count > 0);
+
+    if (--entry.ref_count == 0)
+    {
+        entry.lru_it = mLRUList.insert(mLRUList.begin(), it->first);
+        evict_(mBudget);
+    }
+}
+
+Texture2D* TextureCacher::get(const char* base_fname) const
+{
+    RIO_ASSERT(base_fname);
+
+    auto it = mTextureCache.find(base_fname);
+    if (it != mTextureCache.end())
+        return it->second.texture;
+
+    return nullptr;
+}
+
+void TextureCacher::setBudget(size_t budget)
+{
+    mBudget = budget;
+    evict_(mBudget);
+}
+
+void TextureCacher::evictUnreferenced()
+{
+    evict_(0);
+}
+
+void TextureCacher::evict_(size_t budget)
+{
+    while (mSize > budget && !mLRUList.empty())
+    {
+        auto it = mTextureCache.find(mLRUList.back());
+        RIO_ASSERT(it != mTextureCache.end());
+
+        const Entry& entry = it->second;
+        RIO_ASSERT(entry.ref_count == 0);
+
+        mSize -= entry.size;
+        delete entry.texture;
+
+        mTextureCache.erase(it);
+        mLRUList.pop_back();
+        mEvictedNum++;
+    }
+}
+
+}
@@ -0,0 +1,593 @@
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+
+#include <gpu/win/rio_GLStateCacheWin.h>
+
+#include <atomic>
+#include <cstring>
+
+namespace rio {
+
+namespace {
+
+// Bumped whenever a texture or program is deleted on any thread
+std::atomic<u32> sDeletionGeneration(0);
+
+}
+
+struct GLStateCache::State
+{
+    State()
+        : deletion_generation(0)
+        , skipped_num(0)
+        , frame_call_num(0)
+        , frame_skipped_num(0)
+    {
+        std::memset(&gl, 0xFF, sizeof(gl));
+    }
+
+    // Tracked states
+    // (Invalidated by filling with 0xFF, which no valid value matches, including floats as NaN)
+    struct
+    {
+        u8      depth_test;
+        u8      depth_mask;
+        u32     depth_func;
+        u8      stencil_test;
+        u32     stencil_func;
+        s32     stencil_ref;
+        u32     stencil_mask;
+        u32     stencil_op[3];
+        u32     stencil_write_mask;
+        u8      cull_face_enable;
+        u32     cull_face;
+        u32     polygon_mode;
+        u8      polygon_offset_fill;
+        u8      polygon_offset_point_line;
+        u8      blend[Graphics::RENDER_TARGET_MAX_NUM];
+        u32     blend_factor[Graphics::RENDER_TARGET_MAX_NUM][4];
+        u32     blend_equation[Graphics::RENDER_TARGET_MAX_NUM][2];
+        u8      color_mask[Graphics::RENDER_TARGET_MAX_NUM];
+        f32     blend_color[4];
+        u8      sample_alpha_to_coverage;
+        u32     program;
+        u32     vertex_array;
+        u32     active_texture;
+        u32     texture_2d[cTextureUnitNum];
+        u32     sampler[cTextureUnitNum];
+    } gl;
+
+    // Value of sDeletionGeneration when the texture and program bindings were last checked
+    u32 deletion_generation;
+
+    // Statistics
+    u32 skipped_num;
+    u32 frame_call_num;
+    u32 frame_skipped_num;
+};
+
+thread_local GLStateCache::State GLStateCache::sState;
+
+void GLStateCache::invalidate()
+{
+    std::memset(&sState.gl, 0xFF, sizeof(sState.gl));
+}
+
+void GLStateCache::setDepthTestEnable(bool enable)
+{
+    if (sState.gl.depth_test == u8(enable))
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL((enable ? glEnable : glDisable)(GL_DEPTH_TEST));
+    sState.gl.depth_test = enable;
+}
+
+void GLStateCache::setDepthMask(bool enable)
+{
+    if (sState.gl.depth_mask == u8(enable))
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glDepthMask(enable ? GL_TRUE : GL_FALSE));
+    sState.gl.depth_mask = enable;
+}
+
+void GLStateCache::setDepthFunc(Graphics::CompareFunc func)
+{
+    if (sState.gl.depth_func == u32(func))
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glDepthFunc(func));
+    sState.gl.depth_func = func;
+}
+
+void GLStateCache::setStencilTestEnable(bool enable)
+{
+    if (sState.gl.stencil_test == u8(enable))
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL((enable ? glEnable : glDisable)(GL_STENCIL_TEST));
+    sState.gl.stencil_test = enable;
+}
+
+void GLStateCache::setStencilFunc(Graphics::CompareFunc func, s32 ref, u32 mask)
+{
+    if (sState.gl.stencil_func == u32(func) &&
+        sState.gl.stencil_ref == ref &&
+        sState.gl.stencil_mask == mask)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glStencilFunc(func, ref, mask));
+    sState.gl.stencil_func = func;
+    sState.gl.stencil_ref = ref;
+    sState.gl.stencil_mask = mask;
+}
+
+void GLStateCache::setStencilOp(Graphics::StencilOp fail, Graphics::StencilOp zfail, Graphics::StencilOp zpass)
+{
+    if (sState.gl.stencil_op[0] == u32(fail) &&
+        sState.gl.stencil_op[1] == u32(zfail) &&
+        sState.gl.stencil_op[2] == u32(zpass))
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glStencilOp(fail, zfail, zpass));
+    sState.gl.stencil_op[0] = fail;
+    sState.gl.stencil_op[1] = zfail;
+    sState.gl.stencil_op[2] = zpass;
+}
+
+void GLStateCache::setStencilMask(u32 mask)
+{
+    RIO_ASSERT(mask <= 0xFF);
+
+    if (sState.gl.stencil_write_mask == mask)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glStencilMask(mask));
+    sState.gl.stencil_write_mask = mask;
+}
+
+void GLStateCache::setCullingMode(Graphics::CullingMode mode)
+{
+    const bool enable = mode != Graphics::CULLING_MODE_NONE;
+    if (sState.gl.cull_face_enable != u8(enable))
+    {
+        RIO_GL_CALL((enable ? glEnable : glDisable)(GL_CULL_FACE));
+        sState.gl.cull_face_enable = enable;
+    }
+    else
+    {
+        sState.skipped_num++;
+    }
+
+    if (!enable)
+        return;
+
+    GLenum face;
+    switch (mode)
+    {
+    case Graphics::CULLING_MODE_FRONT:
+        face = GL_FRONT;
+        break;
+    case Graphics::CULLING_MODE_BACK:
+        face = GL_BACK;
+        break;
+    default:
+        face = GL_FRONT_AND_BACK;
+        break;
+    }
+
+    if (sState.gl.cull_face == face)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glCullFace(face));
+    sState.gl.cull_face = face;
+}
+
+#ifndef RIO_GLES
+
+void GLStateCache::setPolygonMode(Graphics::PolygonMode mode)
+{
+    if (sState.gl.polygon_mode == u32(mode))
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glPolygonMode(GL_FRONT_AND_BACK, mode));
+    sState.gl.polygon_mode = mode;
+}
+
+void GLStateCache::setPolygonOffsetEnable(bool fill_enable, bool point_line_enable)
+{
+    if (sState.gl.polygon_offset_fill != u8(fill_enable))
+    {
+        RIO_GL_CALL((fill_enable ? glEnable : glDisable)(GL_POLYGON_OFFSET_FILL));
+        sState.gl.polygon_offset_fill = fill_enable;
+    }
+    else
+    {
+        sState.skipped_num++;
+    }
+
+    if (sState.gl.polygon_offset_point_line != u8(point_line_enable))
+    {
+        RIO_GL_CALL((point_line_enable ? glEnable : glDisable)(GL_POLYGON_OFFSET_POINT));
+        RIO_GL_CALL((point_line_enable ? glEnable : glDisable)(GL_POLYGON_OFFSET_LINE));
+        sState.gl.polygon_offset_point_line = point_line_enable;
+    }
+    else
+    {
+        sState.skipped_num += 2;
+    }
+}
+
+#endif // RIO_GLES
+
+void GLStateCache::setBlendEnable(bool enable)
+{
+    bool changed = false;
+    for (u32 target = 0; target < Graphics::RENDER_TARGET_MAX_NUM; target++)
+        changed |= sState.gl.blend[target] != u8(enable);
+
+    if (!changed)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL((enable ? glEnable : glDisable)(GL_BLEND));
+    std::memset(sState.gl.blend, enable, sizeof(sState.gl.blend));
+}
+
+void GLStateCache::setBlendFactor(Graphics::BlendFactor src_rgb, Graphics::BlendFactor dst_rgb, Graphics::BlendFactor src_a, Graphics::BlendFactor dst_a)
+{
+    const u32 factor[4] = { u32(src_rgb), u32(dst_rgb), u32(src_a), u32(dst_a) };
+
+    bool changed = false;
+    for (u32 target = 0; target < Graphics::RENDER_TARGET_MAX_NUM; target++)
+        changed |= std::memcmp(sState.gl.blend_factor[target], factor, sizeof(factor)) != 0;
+
+    if (!changed)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glBlendFuncSeparate(src_rgb, dst_rgb, src_a, dst_a));
+    for (u32 target = 0; target < Graphics::RENDER_TARGET_MAX_NUM; target++)
+        std::memcpy(sState.gl.blend_factor[target], factor, sizeof(factor));
+}
+
+void GLStateCache::setBlendEquation(Graphics::BlendEquation rgb, Graphics::BlendEquation a)
+{
+    bool changed = false;
+    for (u32 target = 0; target < Graphics::RENDER_TARGET_MAX_NUM; target++)
+        changed |= sState.gl.blend_equation[target][0] != u32(rgb) ||
+                   sState.gl.blend_equation[target][1] != u32(a);
+
+    if (!changed)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glBlendEquationSeparate(rgb, a));
+    for (u32 target = 0; target < Graphics::RENDER_TARGET_MAX_NUM; target++)
+    {
+        sState.gl.blend_equation[target][0] = rgb;
+        sState.gl.blend_equation[target][1] = a;
+    }
+}
+
+void GLStateCache::setColorMask(bool r, bool g, bool b, bool a)
+{
+    const u8 mask = r << 0 | g << 1 | b << 2 | a << 3;
+
+    bool changed = false;
+    for (u32 target = 0; target < Graphics::RENDER_TARGET_MAX_NUM; target++)
+        changed |= sState.gl.color_mask[target] != mask;
+
+    if (!changed)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glColorMask(r, g, b, a));
+    std::memset(sState.gl.color_mask, mask, sizeof(sState.gl.color_mask));
+}
+
+#ifndef RIO_GLES
+
+void GLStateCache::setBlendEnable(u32 target, bool enable)
+{
+    RIO_ASSERT(target < Graphics::RENDER_TARGET_MAX_NUM);
+
+    if (sState.gl.blend[target] == u8(enable))
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL((enable ? glEnablei : glDisablei)(GL_BLEND, target));
+    sState.gl.blend[target] = enable;
+}
+
+void GLStateCache::setBlendFactor(u32 target, Graphics::BlendFactor src_rgb, Graphics::BlendFactor dst_rgb, Graphics::BlendFactor src_a, Graphics::BlendFactor dst_a)
+{
+    RIO_ASSERT(target < Graphics::RENDER_TARGET_MAX_NUM);
+
+    const u32 factor[4] = { u32(src_rgb), u32(dst_rgb), u32(src_a), u32(dst_a) };
+    if (std::memcmp(sState.gl.blend_factor[target], factor, sizeof(factor)) == 0)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glBlendFuncSeparatei(target, src_rgb, dst_rgb, src_a, dst_a));
+    std::memcpy(sState.gl.blend_factor[target], factor, sizeof(factor));
+}
+
+void GLStateCache::setBlendEquation(u32 target, Graphics::BlendEquation rgb, Graphics::BlendEquation a)
+{
+    RIO_ASSERT(target < Graphics::RENDER_TARGET_MAX_NUM);
+
+    if (sState.gl.blend_equation[target][0] == u32(rgb) &&
+        sState.gl.blend_equation[target][1] == u32(a))
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glBlendEquationSeparatei(target, rgb, a));
+    sState.gl.blend_equation[target][0] = rgb;
+    sState.gl.blend_equation[target][1] = a;
+}
+
+void GLStateCache::setColorMask(u32 target, bool r, bool g, bool b, bool a)
+{
+    RIO_ASSERT(target < Graphics::RENDER_TARGET_MAX_NUM);
+
+    const u8 mask = r << 0 | g << 1 | b << 2 | a << 3;
+    if (sState.gl.color_mask[target] == mask)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glColorMaski(target, r, g, b, a));
+    sState.gl.color_mask[target] = mask;
+}
+
+#endif // RIO_GLES
+
+void GLStateCache::setBlendConstantColor(const Color4f& color)
+{
+    if (sState.gl.blend_color[0] == color.r &&
+        sState.gl.blend_color[1] == color.g &&
+        sState.gl.blend_color[2] == color.b &&
+        sState.gl.blend_color[3] == color.a)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glBlendColor(color.r, color.g, color.b, color.a));
+    sState.gl.blend_color[0] = color.r;
+    sState.gl.blend_color[1] = color.g;
+    sState.gl.blend_color[2] = color.b;
+    sState.gl.blend_color[3] = color.a;
+}
+
+void GLStateCache::setSampleAlphaToCoverageEnable(bool enable)
+{
+    if (sState.gl.sample_alpha_to_coverage == u8(enable))
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL((enable ? glEnable : glDisable)(GL_SAMPLE_ALPHA_TO_COVERAGE));
+    sState.gl.sample_alpha_to_coverage = enable;
+}
+
+void GLStateCache::syncDeletions_()
+{
+    const u32 generation = sDeletionGeneration.load(std::memory_order_relaxed);
+    if (sState.deletion_generation == generation)
+        return;
+
+    // Another thread deleted a texture or program, whose name may now refer to a new object
+    std::memset(&sState.gl.program, 0xFF, sizeof(sState.gl.program));
+    std::memset(sState.gl.texture_2d, 0xFF, sizeof(sState.gl.texture_2d));
+    sState.deletion_generation = generation;
+}
+
+void GLStateCache::onDeletion_()
+{
+    syncDeletions_();
+
+    // The cache of this thread is up to date, unless another thread deleted an object in between
+    const u32 generation = sDeletionGeneration.fetch_add(1, std::memory_order_relaxed);
+    if (sState.deletion_generation == generation)
+        sState.deletion_generation = generation + 1;
+}
+
+void GLStateCache::useProgram(u32 handle)
+{
+    syncDeletions_();
+
+    if (sState.gl.program == handle)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glUseProgram(handle));
+    sState.gl.program = handle;
+}
+
+void GLStateCache::bindVertexArray(u32 handle)
+{
+    if (sState.gl.vertex_array == handle)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glBindVertexArray(handle));
+    sState.gl.vertex_array = handle;
+}
+
+void GLStateCache::activeTexture_(u32 unit)
+{
+    if (sState.gl.active_texture == unit)
+        return;
+
+    RIO_GL_CALL(glActiveTexture(GL_TEXTURE0 + unit));
+    sState.gl.active_texture = unit;
+}
+
+void GLStateCache::bindTexture2D(u32 unit, u32 handle)
+{
+    RIO_ASSERT(unit < cTextureUnitNum);
+
+    syncDeletions_();
+
+    if (sState.gl.texture_2d[unit] == handle)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    activeTexture_(unit);
+    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, handle));
+    sState.gl.texture_2d[unit] = handle;
+}
+
+void GLStateCache::bindTexture2DScratch(u32 handle)
+{
+    syncDeletions_();
+
+    if (sState.gl.active_texture == cScratchTextureUnit && sState.gl.texture_2d[cScratchTextureUnit] == handle)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    activeTexture_(cScratchTextureUnit);
+    if (sState.gl.texture_2d[cScratchTextureUnit] != handle)
+    {
+        RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, handle));
+        sState.gl.texture_2d[cScratchTextureUnit] = handle;
+    }
+}
+
+void GLStateCache::bindSampler(u32 unit, u32 handle)
+{
+    RIO_ASSERT(unit < cTextureUnitNum);
+
+    if (sState.gl.sampler[unit] == handle)
+    {
+        sState.skipped_num++;
+        return;
+    }
+
+    RIO_GL_CALL(glBindSampler(unit, handle));
+    sState.gl.sampler[unit] = handle;
+}
+
+void GLStateCache::onTextureDeleted(u32 handle)
+{
+    for (u32 unit = 0; unit < cTextureUnitNum; unit++)
+        if (sState.gl.texture_2d[unit] == handle)
+            sState.gl.texture_2d[unit] = GL_NONE;
+
+    onDeletion_();
+}
+
+void GLStateCache::onSamplerDeleted(u32 handle)
+{
+    for (u32 unit = 0; unit < cTextureUnitNum; unit++)
+        if (sState.gl.sampler[unit] == handle)
+            sState.gl.sampler[unit] = GL_NONE;
+}
+
+void GLStateCache::onVertexArrayDeleted(u32 handle)
+{
+    if (sState.gl.vertex_array == handle)
+        sState.gl.vertex_array = GL_NONE;
+}
+
+void GLStateCache::onProgramDeleted(u32 handle)
+{
+    // A deleted program stays in use until another one is, but its name can be reused
+    if (sState.gl.program == handle)
+        std::memset(&sState.gl.program, 0xFF, sizeof(sState.gl.program));
+
+    onDeletion_();
+}
+
+u32 GLStateCache::getFrameCallNum()
+{
+    return sState.frame_call_num;
+}
+
+u32 GLStateCache::getFrameSkippedCallNum()
+{
+    return sState.frame_skipped_num;
+}
+
+u32 GLStateCache::getCallNum()
+{
+#ifdef RIO_GL_STATS
+    return gGLCallNum;
+#else
+    return 0;
+#endif // RIO_GL_STATS
+}
+
+u32 GLStateCache::getSkippedCallNum()
+{
+    return sState.skipped_num;
+}
+
+void GLStateCache::endFrame()
+{
+#ifdef RIO_GL_STATS
+    sState.frame_call_num = gGLCallNum;
+    gGLCallNum = 0;
+#endif // RIO_GL_STATS
+
+    sState.frame_skipped_num = sState.skipped_num;
+    sState.skipped_num = 0;
+}
+
+}
+
+#endif // RIO_IS_WIN
@@ -0,0 +1,58 @@
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+
+#include <gpu/rio_IndexBuffer.h>
+#include <gpu/win/rio_GLStateCacheWin.h>
+
+#include <misc/gl/rio_GL.h>
+
+namespace rio {
+
+IndexBuffer::IndexBuffer()
+    : mpData(nullptr)
+    , mCount(0)
+    , mFormat(FORMAT_U16)
+{
+    RIO_GL_CALL(glGenBuffers(1, &mHandle));
+    RIO_ASSERT(mHandle != GL_NONE);
+}
+
+IndexBuffer::~IndexBuffer()
+{
+    if (mHandle != GL_NONE)
+    {
+        RIO_GL_CALL(glDeleteBuffers(1, &mHandle));
+        mHandle = GL_NONE;
+    }
+}
+
+void IndexBuffer::setData_(const void* data, u32 count, Format format)
+{
+    RIO_ASSERT(data != nullptr);
+    RIO_ASSERT(count != 0);
+
+    const u32 size = count * (format == FORMAT_U32 ? sizeof(u32) : sizeof(u16));
+
+    // The element array buffer binding is part of the vertex array state,
+    // so make sure no vertex array is modified by the upload
+    GLStateCache::bindVertexArray(GL_NONE);
+    RIO_GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mHandle));
+
+    if (size == getSize())
+        RIO_GL_CALL(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data));
+
+    else
+        RIO_GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+
+    RIO_GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_NONE));
+
+    // The data was copied and can be freed by the caller, so do not keep the pointer
+    mpData = nullptr;
+    mCount = count;
+    mFormat = format;
+}
+
+}
+
+#endif // RIO_IS_WIN
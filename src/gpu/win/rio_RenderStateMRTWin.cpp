@@ -3,82 +3,32 @@
 #if RIO_IS_WIN
 
 #include <gpu/rio_RenderStateMRT.h>
+#include <gpu/win/rio_GLStateCacheWin.h>
 
 namespace rio {
 
+// GL calls are issued through GLStateCache, which skips the ones that would not change anything
+
 void RenderStateMRT::apply() const
 {
-    RIO_GL_CALL((mDepthTestEnable ? glEnable : glDisable)(GL_DEPTH_TEST));
-    RIO_GL_CALL(glDepthMask(mDepthWriteEnable ? GL_TRUE : GL_FALSE));
-    RIO_GL_CALL(glDepthFunc(mDepthFunc));
-
-    RIO_GL_CALL((mStencilTestEnable ? glEnable : glDisable)(GL_STENCIL_TEST));
-    RIO_GL_CALL(glStencilFunc(mStencilTestFunc, mStencilTestRef, mStencilTestMask));
-    RIO_GL_CALL(glStencilOp(mStencilOpFail, mStencilOpZFail, mStencilOpZPass));
-
-    switch (mCullingMode)
-    {
-    case Graphics::CULLING_MODE_NONE:
-        RIO_GL_CALL(glDisable(GL_CULL_FACE));
-        break;
-    case Graphics::CULLING_MODE_FRONT:
-        RIO_GL_CALL(glEnable(GL_CULL_FACE));
-        RIO_GL_CALL(glCullFace(GL_FRONT));
-        break;
-    case Graphics::CULLING_MODE_BACK:
-        RIO_GL_CALL(glEnable(GL_CULL_FACE));
-        RIO_GL_CALL(glCullFace(GL_BACK));
-        break;
-    case Graphics::CULLING_MODE_ALL:
-        RIO_GL_CALL(glEnable(GL_CULL_FACE));
-        RIO_GL_CALL(glCullFace(GL_FRONT_AND_BACK));
-    }
-#ifndef RIO_GLES
-    RIO_GL_CALL(glPolygonMode(GL_FRONT_AND_BACK, mPolygonMode));
+    applyDepthAndStencilTest();
+    applyCullingAndPolygonModeAndPolygonOffset();
+    applyBlendAndFastZ();
+    applyBlendConstantColor();
+    applyColorMask();
 
-    RIO_GL_CALL((mPolygonOffsetEnable ? glEnable : glDisable)(GL_POLYGON_OFFSET_FILL));
-    RIO_GL_CALL((mPolygonOffsetPointLineEnable ? glEnable : glDisable)(GL_POLYGON_OFFSET_POINT));
-    RIO_GL_CALL((mPolygonOffsetPointLineEnable ? glEnable : glDisable)(GL_POLYGON_OFFSET_LINE));
-
-    for (u32 target = 0; target < Graphics::RENDER_TARGET_MAX_NUM; target++)
-    {
-
-        RIO_GL_CALL((mBlendEnableMask.isOnBit(target) ? glEnablei : glDisablei)(GL_BLEND, target));
-
-        RIO_GL_CALL(glBlendFuncSeparatei(target,
-                                         mBlendExpression[target].blend_factor_src_rgb,
-                                         mBlendExpression[target].blend_factor_dst_rgb,
-                                         mBlendExpression[target].blend_factor_src_a,
-                                         mBlendExpression[target].blend_factor_dst_a));
-        RIO_GL_CALL(glBlendEquationSeparatei(target,
-                                             mBlendExpression[target].blend_equation_rgb,
-                                             mBlendExpression[target].blend_equation_a));
-    }
-
-    RIO_GL_CALL(glBlendColor(mBlendConstantColor.r, mBlendConstantColor.g, mBlendConstantColor.b, mBlendConstantColor.a));
-
-    for (u32 target = 0; target < Graphics::RENDER_TARGET_MAX_NUM; target++)
-    {
-        u32 color_mask = mColorMask >> (target * 4) & 0xF;
-        RIO_GL_CALL(glColorMaski(target,
-                                 color_mask >> 0 & 1,
-                                 color_mask >> 1 & 1,
-                                 color_mask >> 2 & 1,
-                                 color_mask >> 3 & 1));
-    }
-#endif
-    RIO_GL_CALL(glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE));
+    GLStateCache::setSampleAlphaToCoverageEnable(false);
 }
 
 void RenderStateMRT::applyDepthAndStencilTest() const
 {
-    RIO_GL_CALL((mDepthTestEnable ? glEnable : glDisable)(GL_DEPTH_TEST));
-    RIO_GL_CALL(glDepthMask(mDepthWriteEnable ? GL_TRUE : GL_FALSE));
-    RIO_GL_CALL(glDepthFunc(mDepthFunc));
+    GLStateCache::setDepthTestEnable(mDepthTestEnable);
+    GLStateCache::setDepthMask(mDepthWriteEnable);
+    GLStateCache::setDepthFunc(mDepthFunc);
 
-    RIO_GL_CALL((mStencilTestEnable ? glEnable : glDisable)(GL_STENCIL_TEST));
-    RIO_GL_CALL(glStencilFunc(mStencilTestFunc, mStencilTestRef, mStencilTestMask));
-    RIO_GL_CALL(glStencilOp(mStencilOpFail, mStencilOpZFail, mStencilOpZPass));
+    GLStateCache::setStencilTestEnable(mStencilTestEnable);
+    GLStateCache::setStencilFunc(mStencilTestFunc, mStencilTestRef, mStencilTestMask);
+    GLStateCache::setStencilOp(mStencilOpFail, mStencilOpZFail, mStencilOpZPass);
 }
 
 void RenderStateMRT::applyColorMask() const
@@ -87,11 +37,11 @@ void RenderStateMRT::applyColorMask() const
     for (u32 target = 0; target < Graphics::RENDER_TARGET_MAX_NUM; target++)
     {
         u32 color_mask = mColorMask >> (target * 4) & 0xF;
-        RIO_GL_CALL(glColorMaski(target,
-                                 color_mask >> 0 & 1,
-                                 color_mask >> 1 & 1,
-                                 color_mask >> 2 & 1,
-                                 color_mask >> 3 & 1));
+        GLStateCache::setColorMask(target,
+                                   color_mask >> 0 & 1,
+                                   color_mask >> 1 & 1,
+                                   color_mask >> 2 & 1,
+                                   color_mask >> 3 & 1);
     }
 #endif
 }
@@ -101,50 +51,30 @@ void RenderStateMRT::applyBlendAndFastZ() const
 #ifndef RIO_GLES
     for (u32 target = 0; target < Graphics::RENDER_TARGET_MAX_NUM; target++)
     {
-
-        RIO_GL_CALL((mBlendEnableMask.isOnBit(target) ? glEnablei : glDisablei)(GL_BLEND, target));
-        RIO_GL_CALL(glBlendFuncSeparatei(target,
-                                         mBlendExpression[target].blend_factor_src_rgb,
-                                         mBlendExpression[target].blend_factor_dst_rgb,
-                                         mBlendExpression[target].blend_factor_src_a,
-                                         mBlendExpression[target].blend_factor_dst_a));
-        RIO_GL_CALL(glBlendEquationSeparatei(target,
-                                             mBlendExpression[target].blend_equation_rgb,
-                                             mBlendExpression[target].blend_equation_a));
+        GLStateCache::setBlendEnable(target, mBlendEnableMask.isOnBit(target));
+        GLStateCache::setBlendFactor(target,
+                                     mBlendExpression[target].blend_factor_src_rgb,
+                                     mBlendExpression[target].blend_factor_dst_rgb,
+                                     mBlendExpression[target].blend_factor_src_a,
+                                     mBlendExpression[target].blend_factor_dst_a);
+        GLStateCache::setBlendEquation(target,
+                                       mBlendExpression[target].blend_equation_rgb,
+                                       mBlendExpression[target].blend_equation_a);
     }
 #endif
 }
 
 void RenderStateMRT::applyBlendConstantColor() const
 {
-    RIO_GL_CALL(glBlendColor(mBlendConstantColor.r, mBlendConstantColor.g, mBlendConstantColor.b, mBlendConstantColor.a));
+    GLStateCache::setBlendConstantColor(mBlendConstantColor);
 }
 
 void RenderStateMRT::applyCullingAndPolygonModeAndPolygonOffset() const
 {
-    switch (mCullingMode)
-    {
-    case Graphics::CULLING_MODE_NONE:
-        RIO_GL_CALL(glDisable(GL_CULL_FACE));
-        break;
-    case Graphics::CULLING_MODE_FRONT:
-        RIO_GL_CALL(glEnable(GL_CULL_FACE));
-        RIO_GL_CALL(glCullFace(GL_FRONT));
-        break;
-    case Graphics::CULLING_MODE_BACK:
-        RIO_GL_CALL(glEnable(GL_CULL_FACE));
-        RIO_GL_CALL(glCullFace(GL_BACK));
-        break;
-    case Graphics::CULLING_MODE_ALL:
-        RIO_GL_CALL(glEnable(GL_CULL_FACE));
-        RIO_GL_CALL(glCullFace(GL_FRONT_AND_BACK));
-    }
+    GLStateCache::setCullingMode(mCullingMode);
 #ifndef RIO_GLES
-    RIO_GL_CALL(glPolygonMode(GL_FRONT_AND_BACK, mPolygonMode));
-
-    RIO_GL_CALL((mPolygonOffsetEnable ? glEnable : glDisable)(GL_POLYGON_OFFSET_FILL));
-    RIO_GL_CALL((mPolygonOffsetPointLineEnable ? glEnable : glDisable)(GL_POLYGON_OFFSET_POINT));
-    RIO_GL_CALL((mPolygonOffsetPointLineEnable ? glEnable : glDisable)(GL_POLYGON_OFFSET_LINE));
+    GLStateCache::setPolygonMode(mPolygonMode);
+    GLStateCache::setPolygonOffsetEnable(mPolygonOffsetEnable, mPolygonOffsetPointLineEnable);
 #endif
 }
 
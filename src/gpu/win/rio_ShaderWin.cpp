@@ -4,9 +4,15 @@
 
 #include <filedevice/rio_FileDeviceMgr.h>
 #include <gpu/rio_Shader.h>
+#include <gpu/win/rio_GLStateCacheWin.h>
 
 #include <misc/gl/rio_GL.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
 namespace {
 
 struct MaxUniformBufferBindingsGetter
@@ -26,6 +32,284 @@ private:
     s32 mValue;
 };
 
+// Set up a linked program
+static void SetupProgram(u32 program)
+{
+    s32 uniform_block_num;
+    RIO_GL_CALL(glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &uniform_block_num));
+  //RIO_ASSERT(glGetError() == GL_NO_ERROR);
+
+#ifdef RIO_DEBUG
+    static MaxUniformBufferBindingsGetter uniform_block_max_num;
+    RIO_ASSERT(uniform_block_num <= uniform_block_max_num.getValue());
+#endif // RIO_DEBUG
+
+    for (s32 i = 0; i < uniform_block_num; i++)
+        RIO_GL_CALL(glUniformBlockBinding(program, i, i));
+}
+
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+// GL_KHR_parallel_shader_compile (GL_ARB_parallel_shader_compile uses the same value)
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif // GL_COMPLETION_STATUS_KHR
+
+static bool IsParallelShaderCompileSupported()
+{
+    struct Getter
+    {
+        Getter()
+        {
+            mValue = false;
+
+            s32 extension_num = 0;
+            RIO_GL_CALL(glGetIntegerv(GL_NUM_EXTENSIONS, &extension_num));
+
+            for (s32 i = 0; i < extension_num; i++)
+            {
+                const char* extension;
+                RIO_GL_CALL(extension = (const char*)glGetStringi(GL_EXTENSIONS, i));
+
+                if (std::strcmp(extension, "GL_KHR_parallel_shader_compile") == 0 ||
+                    std::strcmp(extension, "GL_ARB_parallel_shader_compile") == 0)
+                {
+                    mValue = true;
+                    break;
+                }
+            }
+        }
+
+        bool mValue;
+    };
+
+    static Getter supported;
+    return supported.mValue;
+}
+
+struct ProgramBinaryHeader
+{
+    u32 magic;
+    u32 version;
+    u64 key;        // Hash of the sources and driver
+    u32 format;     // Binary format
+    u32 size;       // Binary size
+};
+static_assert(sizeof(ProgramBinaryHeader) == 0x18);
+
+static constexpr u32 cProgramBinaryMagic   = 0x52504249; // RPBI
+static constexpr u32 cProgramBinaryVersion = 1;
+
+static rio::FileDevice* sProgramBinaryCacheDevice = nullptr;
+static std::string      sProgramBinaryCacheDirPath;
+
+static u64 HashString(u64 hash, const char* str)
+{
+    // FNV-1a, including the null terminator
+    do
+    {
+        hash ^= u8(*str);
+        hash *= 0x100000001B3ull;
+    }
+    while (*str++ != '\0');
+
+    return hash;
+}
+
+static const std::vector<s32>& GetProgramBinaryFormats()
+{
+    struct Getter
+    {
+        Getter()
+        {
+            s32 format_num = 0;
+            if (glProgramBinary != nullptr && glGetProgramBinary != nullptr)
+                RIO_GL_CALL(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_num));
+
+            if (format_num > 0)
+            {
+                mValue.resize(format_num);
+                RIO_GL_CALL(glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, mValue.data()));
+            }
+        }
+
+        std::vector<s32> mValue;
+    };
+
+    static Getter formats;
+    return formats.mValue;
+}
+
+static bool IsProgramBinarySupported()
+{
+    return !GetProgramBinaryFormats().empty();
+}
+
+static bool IsProgramBinaryFormatSupported(u32 format)
+{
+    const std::vector<s32>& formats = GetProgramBinaryFormats();
+    return std::find(formats.begin(), formats.end(), s32(format)) != formats.end();
+}
+
+static u64 GetProgramBinaryKey(const char* c_vertex_shader_src, const char* c_fragment_shader_src)
+{
+    // Binaries are only valid for the driver which created them
+    struct DriverHashGetter
+    {
+        DriverHashGetter()
+        {
+            mValue = 0xCBF29CE484222325ull;
+            for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+            {
+                const char* str;
+                RIO_GL_CALL(str = (const char*)glGetString(name));
+                mValue = HashString(mValue, str ? str : "");
+            }
+        }
+
+        u64 mValue;
+    };
+
+    static DriverHashGetter driver_hash;
+
+    u64 key = driver_hash.mValue;
+    key = HashString(key, c_vertex_shader_src);
+    key = HashString(key, c_fragment_shader_src);
+    return key;
+}
+
+static std::string GetProgramBinaryPath(u64 key)
+{
+    char filename[24];
+    std::snprintf(filename, sizeof(filename), "%016llx.bin", (unsigned long long)key);
+
+    if (sProgramBinaryCacheDirPath.empty())
+        return filename;
+
+    return sProgramBinaryCacheDirPath + '/' + filename;
+}
+
+// Create a program from the cached binary, if any and accepted by the driver
+static u32 LoadProgramBinary(u64 key)
+{
+    rio::FileDevice::LoadArg arg;
+    arg.path = GetProgramBinaryPath(key);
+
+    bool is_exist = false;
+    if (!sProgramBinaryCacheDevice->tryIsExistFile(&is_exist, arg.path) || !is_exist)
+        return GL_NONE;
+
+    // (Loading an empty file is an error)
+    u32 file_size = 0;
+    if (!sProgramBinaryCacheDevice->tryGetFileSize(&file_size, arg.path) || file_size < sizeof(ProgramBinaryHeader))
+        return GL_NONE;
+
+    u8* const file = sProgramBinaryCacheDevice->tryLoad(arg);
+    if (!file)
+        return GL_NONE;
+
+    u32 program = GL_NONE;
+
+    const ProgramBinaryHeader& header = *(const ProgramBinaryHeader*)file;
+    if (arg.read_size >= sizeof(ProgramBinaryHeader) &&
+        header.magic == cProgramBinaryMagic &&
+        header.version == cProgramBinaryVersion &&
+        header.key == key &&
+        header.size == arg.read_size - sizeof(ProgramBinaryHeader) &&
+        IsProgramBinaryFormatSupported(header.format))
+    {
+        RIO_GL_CALL(program = glCreateProgram());
+
+        // A rejected binary (e.g. the driver was updated without changing its version string) may raise an error,
+        // which is expected: the program is then not linked, and the sources are compiled instead
+        glProgramBinary(program, header.format, file + sizeof(ProgramBinaryHeader), header.size);
+        while (glGetError() != GL_NO_ERROR)
+            ;
+
+        s32 success;
+        RIO_GL_CALL(glGetProgramiv(program, GL_LINK_STATUS, &success));
+        if (!success)
+        {
+            RIO_GL_CALL(glDeleteProgram(program));
+            program = GL_NONE;
+        }
+    }
+
+    rio::FileDevice::unload(file);
+    return program;
+}
+
+static void SaveProgramBinary(u64 key, u32 program)
+{
+    s32 success;
+    RIO_GL_CALL(glGetProgramiv(program, GL_LINK_STATUS, &success));
+    if (!success)
+        return;
+
+    s32 size = 0;
+    RIO_GL_CALL(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size));
+    if (size <= 0)
+        return;
+
+    std::vector<u8> file(sizeof(ProgramBinaryHeader) + size);
+    ProgramBinaryHeader& header = *(ProgramBinaryHeader*)file.data();
+
+    GLenum format = GL_NONE;
+    RIO_GL_CALL(glGetProgramBinary(program, size, &size, &format, file.data() + sizeof(ProgramBinaryHeader)));
+    if (size <= 0)
+        return;
+
+    header.magic = cProgramBinaryMagic;
+    header.version = cProgramBinaryVersion;
+    header.key = key;
+    header.format = format;
+    header.size = size;
+
+    const u32 file_size = sizeof(ProgramBinaryHeader) + size;
+
+    // When the device has native paths, write to a temporary file which is renamed once complete,
+    // so that a failed write does not leave a truncated binary behind
+    const std::string path = GetProgramBinaryPath(key);
+    const std::string native_path = sProgramBinaryCacheDevice->getNativePath(path);
+    const std::string write_path = native_path.empty() ? path : path + ".tmp";
+
+    rio::FileHandle handle;
+    if (!sProgramBinaryCacheDevice->tryOpen(&handle, write_path, rio::FileDevice::FILE_OPEN_FLAG_WRITE))
+    {
+        RIO_LOG("Shader: Failed to write program binary to cache.\n");
+        return;
+    }
+
+    u32 write_size = 0;
+    bool written = handle.tryWrite(&write_size, file.data(), file_size) && write_size == file_size;
+    written = handle.tryClose() && written;
+
+    if (native_path.empty())
+    {
+        // (A truncated binary is rejected by LoadProgramBinary(), then replaced)
+        if (!written)
+            RIO_LOG("Shader: Failed to write program binary to cache.\n");
+
+        return;
+    }
+
+    const std::string native_write_path = sProgramBinaryCacheDevice->getNativePath(write_path);
+    if (written)
+    {
+        // (rename() does not replace an existing file on Windows)
+        std::remove(native_path.c_str());
+        written = std::rename(native_write_path.c_str(), native_path.c_str()) == 0;
+    }
+
+    if (!written)
+    {
+        RIO_LOG("Shader: Failed to write program binary to cache.\n");
+        std::remove(native_write_path.c_str());
+    }
+}
+
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
 }
 
 namespace rio {
@@ -33,58 +317,125 @@ namespace rio {
 void Shader::initialize_()
 {
     mShaderProgram = GL_NONE;
+    mPendingVertexShader = GL_NONE;
+    mPendingFragmentShader = GL_NONE;
+    mPendingBinaryKey = 0;
+}
+
+void Shader::setProgramBinaryCache(FileDevice* device, const char* dir_path)
+{
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    RIO_ASSERT(dir_path);
+
+    sProgramBinaryCacheDevice = device;
+    sProgramBinaryCacheDirPath = dir_path;
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
 }
 
 void Shader::load(const char* c_vertex_shader_src, const char* c_fragment_shader_src)
+{
+    loadAsync(c_vertex_shader_src, c_fragment_shader_src);
+    waitReady_();
+}
+
+void Shader::loadAsync(const char* c_vertex_shader_src, const char* c_fragment_shader_src)
 {
     unload();
 
-    u32 vertex_shader;
-    RIO_GL_CALL(vertex_shader = glCreateShader(GL_VERTEX_SHADER));
-    RIO_GL_CALL(glShaderSource(vertex_shader, 1, &c_vertex_shader_src, nullptr));
-    RIO_GL_CALL(glCompileShader(vertex_shader));
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    const bool use_binary_cache = sProgramBinaryCacheDevice != nullptr && IsProgramBinarySupported();
+
+    if (use_binary_cache)
+    {
+        const u64 binary_key = GetProgramBinaryKey(c_vertex_shader_src, c_fragment_shader_src);
+
+        mShaderProgram = LoadProgramBinary(binary_key);
+        if (mShaderProgram != GL_NONE)
+        {
+            SetupProgram(mShaderProgram);
+            mLoaded = true;
+            return;
+        }
+
+        mPendingBinaryKey = binary_key;
+    }
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+    // Submit everything without querying any status, which would make the driver wait for the compilation
+    RIO_GL_CALL(mPendingVertexShader = glCreateShader(GL_VERTEX_SHADER));
+    RIO_GL_CALL(glShaderSource(mPendingVertexShader, 1, &c_vertex_shader_src, nullptr));
+    RIO_GL_CALL(glCompileShader(mPendingVertexShader));
+
+    RIO_GL_CALL(mPendingFragmentShader = glCreateShader(GL_FRAGMENT_SHADER));
+    RIO_GL_CALL(glShaderSource(mPendingFragmentShader, 1, &c_fragment_shader_src, nullptr));
+    RIO_GL_CALL(glCompileShader(mPendingFragmentShader));
+
+    RIO_GL_CALL(mShaderProgram = glCreateProgram());
+    RIO_GL_CALL(glAttachShader(mShaderProgram, mPendingVertexShader));
+    RIO_GL_CALL(glAttachShader(mShaderProgram, mPendingFragmentShader));
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    if (use_binary_cache)
+        RIO_GL_CALL(glProgramParameteri(mShaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    RIO_GL_CALL(glLinkProgram(mShaderProgram));
+
+    mLoaded = true;
+}
+
+bool Shader::isReady() const
+{
+    if (!mLoaded)
+        return false;
+
+    if (mPendingVertexShader == GL_NONE)
+        return true;
+
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    if (IsParallelShaderCompileSupported())
+    {
+        s32 completed;
+        RIO_GL_CALL(glGetProgramiv(mShaderProgram, GL_COMPLETION_STATUS_KHR, &completed));
+        if (!completed)
+            return false;
+    }
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+    finishLoad_();
+    return true;
+}
+
+void Shader::finishLoad_() const
+{
+    RIO_ASSERT(mLoaded);
+    RIO_ASSERT(mPendingVertexShader != GL_NONE && mPendingFragmentShader != GL_NONE);
 
 #ifdef RIO_DEBUG
     // Error-checking...
     {
         int  success;
         char infoLog[512];
-        RIO_GL_CALL(glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success));
+        RIO_GL_CALL(glGetShaderiv(mPendingVertexShader, GL_COMPILE_STATUS, &success));
         if (!success)
         {
-            RIO_GL_CALL(glGetShaderInfoLog(vertex_shader, 512, nullptr, infoLog));
+            RIO_GL_CALL(glGetShaderInfoLog(mPendingVertexShader, 512, nullptr, infoLog));
             RIO_LOG("ERROR::SHADER::VERTEX::COMPILATION_FAILED\n%s\n", infoLog);
             RIO_ASSERT(false);
         }
     }
-#endif // RIO_DEBUG
 
-    u32 fragment_shader;
-    RIO_GL_CALL(fragment_shader = glCreateShader(GL_FRAGMENT_SHADER));
-    RIO_GL_CALL(glShaderSource(fragment_shader, 1, &c_fragment_shader_src, nullptr));
-    RIO_GL_CALL(glCompileShader(fragment_shader));
-
-#ifdef RIO_DEBUG
     // Error-checking...
     {
         int  success;
         char infoLog[512];
-        RIO_GL_CALL(glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success));
+        RIO_GL_CALL(glGetShaderiv(mPendingFragmentShader, GL_COMPILE_STATUS, &success));
         if (!success)
         {
-            RIO_GL_CALL(glGetShaderInfoLog(fragment_shader, 512, nullptr, infoLog));
+            RIO_GL_CALL(glGetShaderInfoLog(mPendingFragmentShader, 512, nullptr, infoLog));
             RIO_LOG("ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n%s\n", infoLog);
             RIO_ASSERT(false);
         }
     }
-#endif // RIO_DEBUG
-
-    RIO_GL_CALL(mShaderProgram = glCreateProgram());
-    RIO_GL_CALL(glAttachShader(mShaderProgram, vertex_shader));
-    RIO_GL_CALL(glAttachShader(mShaderProgram, fragment_shader));
-    RIO_GL_CALL(glLinkProgram(mShaderProgram));
 
-#ifdef RIO_DEBUG
     // Error-checking...
     {
         int  success;
@@ -99,22 +450,20 @@ void Shader::load(const char* c_vertex_shader_src, const char* c_fragment_shader
     }
 #endif // RIO_DEBUG
 
-    RIO_GL_CALL(glDeleteShader(vertex_shader));
-    RIO_GL_CALL(glDeleteShader(fragment_shader));
-
-    mLoaded = true;
-
-    s32 uniform_block_num;
-    RIO_GL_CALL(glGetProgramiv(mShaderProgram, GL_ACTIVE_UNIFORM_BLOCKS, &uniform_block_num));
-  //RIO_ASSERT(glGetError() == GL_NO_ERROR);
+    RIO_GL_CALL(glDeleteShader(mPendingVertexShader));
+    RIO_GL_CALL(glDeleteShader(mPendingFragmentShader));
+    mPendingVertexShader = GL_NONE;
+    mPendingFragmentShader = GL_NONE;
 
-#ifdef RIO_DEBUG
-    static MaxUniformBufferBindingsGetter uniform_block_max_num;
-    RIO_ASSERT(uniform_block_num <= uniform_block_max_num.getValue());
-#endif // RIO_DEBUG
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    if (mPendingBinaryKey != 0)
+    {
+        SaveProgramBinary(mPendingBinaryKey, mShaderProgram);
+        mPendingBinaryKey = 0;
+    }
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
 
-    for (s32 i = 0; i < uniform_block_num; i++)
-        RIO_GL_CALL(glUniformBlockBinding(mShaderProgram, i, i));
+    SetupProgram(mShaderProgram);
 }
 
 // Helper function to adjust the shader version if necessary
@@ -141,7 +490,13 @@ void changeShaderSrcVersionToGLSL300ES(std::string& shader_src)
     }
 }
 
-void Shader::load(const char* base_fname, ShaderMode)
+void Shader::load(const char* base_fname, ShaderMode exp_mode)
+{
+    loadAsync(base_fname, exp_mode);
+    waitReady_();
+}
+
+void Shader::loadAsync(const char* base_fname, ShaderMode)
 {
     const std::string base_path = std::string("shaders/") + base_fname;
 
@@ -181,7 +536,7 @@ void Shader::load(const char* base_fname, ShaderMode)
 
     const char* const c_fragment_shader_src = fragment_shader_src.c_str();
 
-    load(c_vertex_shader_src, c_fragment_shader_src);
+    loadAsync(c_vertex_shader_src, c_fragment_shader_src);
 
     MemUtil::free(vertex_shader_src_file);
     MemUtil::free(fragment_shader_src_file);
@@ -192,6 +547,16 @@ void Shader::unload()
     if (!mLoaded)
         return;
 
+    if (mPendingVertexShader != GL_NONE)
+    {
+        RIO_GL_CALL(glDeleteShader(mPendingVertexShader));
+        RIO_GL_CALL(glDeleteShader(mPendingFragmentShader));
+        mPendingVertexShader = GL_NONE;
+        mPendingFragmentShader = GL_NONE;
+        mPendingBinaryKey = 0;
+    }
+
+    GLStateCache::onProgramDeleted(mShaderProgram);
     RIO_GL_CALL(glDeleteProgram(mShaderProgram));
     mShaderProgram = GL_NONE;
 
@@ -210,13 +575,15 @@ Shader::ShaderMode Shader::getShaderMode()
 void Shader::bind(bool) const
 {
     RIO_ASSERT(mLoaded);
+    waitReady_();
 
-    RIO_GL_CALL(glUseProgram(mShaderProgram));
+    GLStateCache::useProgram(mShaderProgram);
 }
 
 u32 Shader::getVertexAttribLocation(const char* name) const
 {
     RIO_ASSERT(mLoaded);
+    waitReady_();
     u32 loc;
     RIO_GL_CALL(loc = glGetAttribLocation(mShaderProgram, name));
     return loc;
@@ -225,6 +592,7 @@ u32 Shader::getVertexAttribLocation(const char* name) const
 u32 Shader::getVertexSamplerLocation(const char* name) const
 {
     RIO_ASSERT(mLoaded);
+    waitReady_();
     u32 loc;
     RIO_GL_CALL(loc = glGetUniformLocation(mShaderProgram, name));
     return loc;
@@ -233,6 +601,7 @@ u32 Shader::getVertexSamplerLocation(const char* name) const
 u32 Shader::getFragmentSamplerLocation(const char* name) const
 {
     RIO_ASSERT(mLoaded);
+    waitReady_();
     u32 loc;
     RIO_GL_CALL(loc = glGetUniformLocation(mShaderProgram, name));
     return loc;
@@ -241,6 +610,7 @@ u32 Shader::getFragmentSamplerLocation(const char* name) const
 u32 Shader::getVertexUniformLocation(const char* name) const
 {
     RIO_ASSERT(mLoaded);
+    waitReady_();
     u32 loc;
     RIO_GL_CALL(loc = glGetUniformLocation(mShaderProgram, name));
     return loc;
@@ -249,6 +619,7 @@ u32 Shader::getVertexUniformLocation(const char* name) const
 u32 Shader::getFragmentUniformLocation(const char* name) const
 {
     RIO_ASSERT(mLoaded);
+    waitReady_();
     u32 loc;
     RIO_GL_CALL(loc = glGetUniformLocation(mShaderProgram, name));
     return loc;
@@ -257,6 +628,7 @@ u32 Shader::getFragmentUniformLocation(const char* name) const
 u32 Shader::getVertexUniformBlockIndex(const char* name) const
 {
     RIO_ASSERT(mLoaded);
+    waitReady_();
     u32 loc;
     RIO_GL_CALL(loc = glGetUniformBlockIndex(mShaderProgram, name));
     return loc;
@@ -265,6 +637,7 @@ u32 Shader::getVertexUniformBlockIndex(const char* name) const
 u32 Shader::getFragmentUniformBlockIndex(const char* name) const
 {
     RIO_ASSERT(mLoaded);
+    waitReady_();
     u32 loc;
     RIO_GL_CALL(loc = glGetUniformBlockIndex(mShaderProgram, name));
     return loc;
@@ -2,7 +2,9 @@
 
 #if RIO_IS_WIN
 
+#include <gpu/win/rio_GLStateCacheWin.h>
 #include <gpu/win/rio_Texture2DUtilWin.h>
+#include <gpu/win/rio_TextureUploaderWin.h>
 
 #include <misc/rio_MemUtil.h>
 #include <misc/gl/rio_GL.h>
@@ -76,12 +78,18 @@ u32 Texture2DUtil::createHandle()
 void Texture2DUtil::destroyHandle(u32 handle)
 {
     RIO_ASSERT(handle != GL_NONE);
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    if (TextureUploader::instance())
+        TextureUploader::instance()->cancel(handle);
+#endif
+    GLStateCache::onTextureDeleted(handle);
     RIO_GL_CALL(glDeleteTextures(1, &handle));
 }
 
 void Texture2DUtil::bind(u32 handle)
 {
-    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, handle));
+    // Use a dedicated unit, so that textures bound for drawing are not affected
+    GLStateCache::bindTexture2DScratch(handle);
 }
 
 void Texture2DUtil::setSwizzleCurrent(u32 compMap)
@@ -277,6 +285,105 @@ void Texture2DUtil::uploadTextureCurrent(
     }
 }
 
+bool Texture2DUtil::isStorageSupported()
+{
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    return glTexStorage2D != nullptr;
+#else
+    return false;
+#endif
+}
+
+void Texture2DUtil::allocateStorageCurrent(
+    TextureFormat format,
+    const NativeTextureFormat& nativeFormat,
+    u32 width,
+    u32 height,
+    u32 mipLevels
+)
+{
+    RIO_ASSERT(format != TEXTURE_FORMAT_INVALID);
+    RIO_ASSERT(width && height);
+
+    mipLevels = std::min(std::max(mipLevels, 1u), 14u);
+
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    if (isStorageSupported())
+    {
+        RIO_GL_CALL(glTexStorage2D(
+            GL_TEXTURE_2D,
+            mipLevels,
+            nativeFormat.internalformat,
+            width,
+            height
+        ));
+        return;
+    }
+#endif
+
+    // Fall back to mutable storage
+    u32 mipLevelOffset[13];
+    uploadTextureCurrent(
+        format,
+        nativeFormat,
+        width,
+        height,
+        mipLevels,
+        calcImageSize(format, width, height),
+        nullptr,
+        calcMipmapSize(format, width, height, mipLevels, mipLevelOffset),
+        nullptr,
+        mipLevelOffset
+    );
+}
+
+void Texture2DUtil::uploadLevelCurrent(
+    TextureFormat format,
+    const NativeTextureFormat& nativeFormat,
+    u32 level,
+    u32 y,
+    u32 width,
+    u32 height,
+    u32 size,
+    const void* data
+)
+{
+    RIO_ASSERT(format != TEXTURE_FORMAT_INVALID);
+    RIO_ASSERT(width && height);
+    RIO_ASSERT(size);
+
+    RIO_GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+    if (TextureFormatUtil::isCompressed(format))
+    {
+        RIO_GL_CALL(glCompressedTexSubImage2D(
+            GL_TEXTURE_2D,
+            level,
+            0,
+            y,
+            width,
+            height,
+            nativeFormat.internalformat,
+            size,
+            data
+        ));
+    }
+    else
+    {
+        RIO_GL_CALL(glTexSubImage2D(
+            GL_TEXTURE_2D,
+            level,
+            0,
+            y,
+            width,
+            height,
+            nativeFormat.format,
+            nativeFormat.type,
+            data
+        ));
+    }
+}
+
 }
 
 #endif // RIO_IS_WIN
@@ -3,6 +3,7 @@
 #if RIO_IS_WIN
 
 #include <gpu/rio_TextureSampler.h>
+#include <gpu/win/rio_GLStateCacheWin.h>
 
 namespace rio {
 
@@ -18,6 +19,7 @@ TextureSampler2D::~TextureSampler2D()
 {
     if (mSamplerInner != GL_NONE)
     {
+        GLStateCache::onSamplerDeleted(mSamplerInner);
         RIO_GL_CALL(glDeleteSamplers(1, &mSamplerInner));
         mSamplerInner = GL_NONE;
     }
@@ -237,14 +239,10 @@ void TextureSampler2D::bind(u32 vs_location, u32 fs_location, u32 slot) const
 
     update();
 
-    RIO_GL_CALL(glActiveTexture(GL_TEXTURE0 + slot));
-    RIO_GL_CALL(glBindTexture(GL_TEXTURE_2D, mTexture2DHandle));
+    GLStateCache::bindTexture2D(slot, mTexture2DHandle);
+    GLStateCache::bindSampler(slot, mSamplerInner);
 
-    RIO_GL_CALL(glBindSampler(slot, mSamplerInner));
     RIO_GL_CALL(glUniform1i(location, slot));
-
-    RIO_GL_CALL(glActiveTexture(GL_TEXTURE0 + 16)); // Make sure subsequent calls to glBindTexture
-                                                    // don't affect the current unit slot
 }
 
 }
@@ -0,0 +1,359 @@
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+
+#include <gpu/win/rio_TextureUploaderWin.h>
+
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+#include <filedevice/rio_FileDeviceMgr.h>
+#include <gpu/win/rio_Texture2DUtilWin.h>
+#include <misc/rio_MemUtil.h>
+
+#include <algorithm>
+
+namespace {
+
+static u32 GetLevelSize(const rio::TextureUploader::Request& request, u32 level, const void** p_data)
+{
+    if (level == 0)
+    {
+        *p_data = request.image;
+        return request.imageSize;
+    }
+
+    const u32 offset = request.mipLevelOffset[level - 1];
+    const u32 end = level + 1 < request.mipLevels ? request.mipLevelOffset[level] : request.mipmapSize;
+
+    *p_data = (const u8*)request.mipmaps + offset;
+    return end - offset;
+}
+
+}
+
+namespace rio {
+
+TextureUploader* TextureUploader::sInstance = nullptr;
+
+bool TextureUploader::createSingleton(u32 staging_buffer_size, u32 staging_buffer_num)
+{
+    if (sInstance)
+        return false;
+
+    RIO_ASSERT(staging_buffer_size > 0);
+    RIO_ASSERT(staging_buffer_num > 0);
+
+    if (!isSupported())
+    {
+        RIO_LOG("TextureUploader: Immutable texture storage or fences are not supported.\n");
+        return false;
+    }
+
+    TextureUploader* instance = new TextureUploader();
+    if (!instance->initialize_(staging_buffer_size, staging_buffer_num))
+    {
+        delete instance;
+        return false;
+    }
+
+    sInstance = instance;
+    return true;
+}
+
+void TextureUploader::destroySingleton()
+{
+    if (!sInstance)
+        return;
+
+    delete sInstance;
+    sInstance = nullptr;
+}
+
+bool TextureUploader::isSupported()
+{
+    return Texture2DUtil::isStorageSupported() &&
+           glFenceSync != nullptr &&
+           glMapBufferRange != nullptr;
+}
+
+TextureUploader::TextureUploader()
+    : mStagingBufferSize(0)
+    , mStagingBufferIndex(0)
+    , mStagingBufferOffset(0)
+    , mFrameBudget(0)
+    , mFrameUploadedSize(0)
+    , mUploadedNum(0)
+{
+}
+
+TextureUploader::~TextureUploader()
+{
+    terminate_();
+}
+
+bool TextureUploader::initialize_(u32 staging_buffer_size, u32 staging_buffer_num)
+{
+    mStagingBufferSize = staging_buffer_size;
+    mFrameBudget = staging_buffer_size;
+    mStagingBuffer.resize(staging_buffer_num);
+
+    for (StagingBuffer& buffer : mStagingBuffer)
+    {
+        buffer.handle = GL_NONE;
+        buffer.fence = nullptr;
+
+        RIO_GL_CALL(glGenBuffers(1, &buffer.handle));
+        RIO_ASSERT(buffer.handle != GL_NONE);
+
+        RIO_GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.handle));
+        RIO_GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, staging_buffer_size, nullptr, GL_STREAM_DRAW));
+    }
+
+    RIO_GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, GL_NONE));
+    return true;
+}
+
+void TextureUploader::terminate_()
+{
+    for (const Job& job : mQueuedJobs)
+        releaseFile_(job.request);
+
+    for (const Job& job : mJobs)
+        releaseFile_(job.request);
+
+    mQueuedJobs.clear();
+    mJobs.clear();
+
+    for (StagingBuffer& buffer : mStagingBuffer)
+    {
+        if (buffer.fence)
+            RIO_GL_CALL(glDeleteSync(buffer.fence));
+
+        if (buffer.handle != GL_NONE)
+            RIO_GL_CALL(glDeleteBuffers(1, &buffer.handle));
+    }
+
+    mStagingBuffer.clear();
+}
+
+void TextureUploader::queue(const Request& request)
+{
+    RIO_ASSERT(request.handle != GL_NONE);
+    RIO_ASSERT(request.format != TEXTURE_FORMAT_INVALID);
+    RIO_ASSERT(request.width && request.height);
+    RIO_ASSERT(request.image && request.imageSize);
+    RIO_ASSERT(1 <= request.mipLevels && request.mipLevels <= 14);
+    RIO_ASSERT(request.mipLevels == 1 || (request.mipmaps && request.mipmapSize));
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueuedJobs.push_back(Job{ request, 0, 0 });
+}
+
+void TextureUploader::cancel(u32 handle)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const auto is_canceled = [handle](const Job& job)
+    {
+        if (job.request.handle != handle)
+            return false;
+
+        releaseFile_(job.request);
+        return true;
+    };
+
+    mQueuedJobs.erase(std::remove_if(mQueuedJobs.begin(), mQueuedJobs.end(), is_canceled), mQueuedJobs.end());
+    mJobs.erase(std::remove_if(mJobs.begin(), mJobs.end(), is_canceled), mJobs.end());
+}
+
+bool TextureUploader::isPending(u32 handle) const
+{
+    const auto is_pending = [handle](const Job& job)
+    {
+        return job.request.handle == handle;
+    };
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    return std::any_of(mJobs.begin(), mJobs.end(), is_pending) ||
+           std::any_of(mQueuedJobs.begin(), mQueuedJobs.end(), is_pending);
+}
+
+u32 TextureUploader::getPendingNum() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mJobs.size() + mQueuedJobs.size();
+}
+
+void TextureUploader::update()
+{
+    update_(mFrameBudget);
+}
+
+void TextureUploader::flush()
+{
+    while (getPendingNum() > 0)
+    {
+        waitStagingBuffers_();
+        update_(0);
+    }
+}
+
+void TextureUploader::waitStagingBuffers_()
+{
+    for (StagingBuffer& buffer : mStagingBuffer)
+    {
+        if (buffer.fence)
+        {
+            RIO_GL_CALL(glClientWaitSync(buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED));
+            RIO_GL_CALL(glDeleteSync(buffer.fence));
+            buffer.fence = nullptr;
+        }
+    }
+}
+
+void TextureUploader::update_(u32 budget)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.insert(mJobs.end(), mQueuedJobs.begin(), mQueuedJobs.end());
+        mQueuedJobs.clear();
+    }
+
+    u32 uploaded_size = 0;
+
+    // Jobs are only removed from this thread, so they can be accessed without locking
+    while (!mJobs.empty())
+    {
+        Job& job = mJobs.front();
+        const Request& request = job.request;
+
+        const void* data = nullptr;
+        const u32 level_size = GetLevelSize(request, job.level, &data);
+
+        const u32 width  = std::max(request.width  >> job.level, 1u);
+        const u32 height = std::max(request.height >> job.level, 1u);
+
+        // Levels are uploaded in chunks of rows (of blocks, for compressed formats) which fit in a staging buffer
+        const u32 row_height = TextureFormatUtil::isCompressed(request.format) ? 4 : 1;
+        const u32 row_num = (height + row_height - 1) / row_height;
+        const u32 row_size = level_size / row_num;
+
+        u32 chunk_row_num = std::min(row_num - job.row, std::max(mStagingBufferSize / row_size, 1u));
+
+        if (budget != 0)
+        {
+            const u32 budget_row_num = budget > uploaded_size ? (budget - uploaded_size) / row_size : 0;
+            if (budget_row_num == 0 && uploaded_size != 0)
+                break;
+
+            chunk_row_num = std::min(chunk_row_num, std::max(budget_row_num, 1u));
+        }
+
+        const u32 y = job.row * row_height;
+        const u32 chunk_height = std::min(chunk_row_num * row_height, height - y);
+        const u32 chunk_size = chunk_row_num * row_size;
+
+        if (!uploadChunk_(request, job.level, y, width, chunk_height, chunk_size, (const u8*)data + job.row * row_size))
+            break;
+
+        uploaded_size += chunk_size;
+
+        job.row += chunk_row_num;
+        if (job.row < row_num)
+            continue;
+
+        job.row = 0;
+        if (++job.level == request.mipLevels)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            releaseFile_(request);
+            mJobs.pop_front();
+            mUploadedNum++;
+        }
+    }
+
+    // Make the copies of this frame start, so that the staging buffers are free by the next frames
+    if (mStagingBufferOffset != 0)
+        endStagingBuffer_();
+
+    mFrameUploadedSize = uploaded_size;
+}
+
+bool TextureUploader::uploadChunk_(const Request& request, u32 level, u32 y, u32 width, u32 height, u32 size, const void* data)
+{
+    if (size > mStagingBufferSize)
+    {
+        // Too large to be staged, upload it directly
+        Texture2DUtil::bind(request.handle);
+        Texture2DUtil::uploadLevelCurrent(request.format, request.nativeFormat, level, y, width, height, size, data);
+        return true;
+    }
+
+    if (mStagingBufferOffset + size > mStagingBufferSize)
+        endStagingBuffer_();
+
+    StagingBuffer& buffer = mStagingBuffer[mStagingBufferIndex];
+
+    if (buffer.fence)
+    {
+        GLenum status = GL_TIMEOUT_EXPIRED;
+        RIO_GL_CALL(status = glClientWaitSync(buffer.fence, 0, 0));
+        if (status == GL_TIMEOUT_EXPIRED)
+            return false;
+
+        RIO_GL_CALL(glDeleteSync(buffer.fence));
+        buffer.fence = nullptr;
+    }
+
+    RIO_GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.handle));
+
+    // The fence guarantees that the GPU is not reading this range anymore
+    void* dst = nullptr;
+    RIO_GL_CALL(dst = glMapBufferRange(
+        GL_PIXEL_UNPACK_BUFFER,
+        mStagingBufferOffset,
+        size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT
+    ));
+    RIO_ASSERT(dst);
+
+    MemUtil::copy(dst, data, size);
+    RIO_GL_CALL(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+
+    Texture2DUtil::bind(request.handle);
+    Texture2DUtil::uploadLevelCurrent(request.format, request.nativeFormat, level, y, width, height, size, (const void*)uintptr_t(mStagingBufferOffset));
+
+    RIO_GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, GL_NONE));
+
+    // Keep the offsets aligned for all formats
+    mStagingBufferOffset = (mStagingBufferOffset + size + 15) & ~15u;
+    return true;
+}
+
+void TextureUploader::endStagingBuffer_()
+{
+    StagingBuffer& buffer = mStagingBuffer[mStagingBufferIndex];
+    RIO_ASSERT(buffer.fence == nullptr);
+
+    RIO_GL_CALL(buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    mStagingBufferIndex = (mStagingBufferIndex + 1) % mStagingBuffer.size();
+    mStagingBufferOffset = 0;
+}
+
+void TextureUploader::releaseFile_(const Request& request)
+{
+    if (request.file == nullptr)
+        return;
+
+    if (request.file_is_mapped)
+        FileDeviceMgr::unmap(request.file, request.file_size);
+    else
+        FileDeviceMgr::unload(request.file);
+}
+
+}
+
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+#endif // RIO_IS_WIN
@@ -5,6 +5,7 @@
 #include <filedevice/rio_FileDeviceMgr.h>
 #include <gpu/rio_Texture.h>
 #include <gpu/win/rio_Texture2DUtilWin.h>
+#include <gpu/win/rio_TextureUploaderWin.h>
 
 #include <algorithm>
 
@@ -30,16 +31,44 @@ static const size_t TEX_SIZE = sizeof(rio::NativeTexture2D);
 
 namespace rio {
 
-Texture2D::Texture2D(const char* base_fname)
+Texture2D::Texture2D(const char* base_fname, bool keep_image_data, bool async_upload, bool async_load)
     : mSelfAllocated(true)
 {
 #ifndef RIO_NO_TEXTURE2D_FILE_CTOR
     FileDevice::LoadArg arg;
     arg.path = std::string("textures/") + base_fname + ".rtx";
+    arg.heap_type = MemUtil::HEAP_TYPE_TEXTURE;
+    // The file is only read if its data is not kept
+    arg.map = !keep_image_data;
+
+    if (async_load)
+    {
+        // No texture until the file is loaded
+        MemUtil::set(&mTextureInner, 0, sizeof(NativeTexture2D));
+        mHandle = GL_NONE;
+
+        mKeepImageData = keep_image_data;
+        mAsyncUpload = async_upload;
+        mLoadHandle = FileDeviceMgr::instance()->loadAsync(arg, &Texture2D::onFileLoaded_, this);
+        return;
+    }
 
     u8* const file = FileDeviceMgr::instance()->load(arg);
-    load_(file, arg.read_size);
-    MemUtil::free(file);
+
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    if (async_upload && TextureUploader::instance())
+    {
+        loadAsync_(file, arg.read_size, arg.is_mapped, keep_image_data);
+        return;
+    }
+#endif
+
+    load_(file, arg.read_size, keep_image_data);
+
+    if (arg.is_mapped)
+        FileDeviceMgr::unmap(file, arg.read_size);
+    else
+        FileDeviceMgr::unload(file);
 #else
     RIO_ASSERT(false);
 #endif // RIO_NO_TEXTURE2D_FILE_CTOR
@@ -74,11 +103,39 @@ Texture2D::Texture2D(TextureFormat format, u32 width, u32 height, u32 numMips)
     createHandle_();
 }
 
-void Texture2D::load_(const u8* file, u32 file_size)
+void Texture2D::load_(const u8* file, u32 file_size, bool keep_image_data)
 {
     RIO_ASSERT(file_size >= TEX_SIZE);
 
-    NativeTexture2D* tex = (NativeTexture2D*)MemUtil::alloc(file_size, 4);
+    if (!keep_image_data)
+    {
+        // Upload straight from the file data, which is not kept
+        MemUtil::copy(&mTextureInner, file, sizeof(NativeTexture2D));
+
+        NativeSurface2D& surface = mTextureInner.surface;
+        RIO_ASSERT(surface._imageOffset + surface.imageSize <= file_size);
+
+        surface.image = const_cast<u8*>(file) + surface._imageOffset;
+
+        if (surface.mipLevels > 1)
+        {
+            RIO_ASSERT(surface._mipmapsOffset + surface.mipmapSize <= file_size);
+            surface.mipmaps = const_cast<u8*>(file) + surface._mipmapsOffset;
+        }
+        else
+        {
+            surface.mipmaps = nullptr;
+        }
+
+        createHandle_();
+
+        surface.image = nullptr;
+        surface.mipmaps = nullptr;
+        mSelfAllocated = false;
+        return;
+    }
+
+    NativeTexture2D* tex = (NativeTexture2D*)MemUtil::alloc(file_size, 4, MemUtil::HEAP_TYPE_TEXTURE);
     RIO_ASSERT(tex);
 
     MemUtil::copy(tex, file, file_size);
@@ -101,6 +158,121 @@ void Texture2D::load_(const u8* file, u32 file_size)
     createHandle_();
 }
 
+void Texture2D::loadAsync_(u8* file, u32 file_size, bool file_is_mapped, bool keep_image_data)
+{
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    RIO_ASSERT(file_size >= TEX_SIZE);
+
+    TextureUploader::Request request;
+
+    if (keep_image_data)
+    {
+        NativeTexture2D* tex = (NativeTexture2D*)MemUtil::alloc(file_size, 4, MemUtil::HEAP_TYPE_TEXTURE);
+        RIO_ASSERT(tex);
+
+        MemUtil::copy(tex, file, file_size);
+
+        if (file_is_mapped)
+            FileDeviceMgr::unmap(file, file_size);
+        else
+            FileDeviceMgr::unload(file);
+
+        file = (u8*)tex;
+    }
+    else
+    {
+        // The uploader releases the file once it is done with it
+        request.file = file;
+        request.file_size = file_size;
+        request.file_is_mapped = file_is_mapped;
+
+        mSelfAllocated = false;
+    }
+
+    MemUtil::copy(&mTextureInner, file, sizeof(NativeTexture2D));
+
+    RIO_ASSERT(mTextureInner._footer.magic == 0x5101382D);
+    RIO_ASSERT(TEX_VERSION_MIN <= mTextureInner._footer.version);
+    RIO_ASSERT(mTextureInner._footer.version <= TEX_VERSION_CURRENT);
+
+    NativeSurface2D& surface = mTextureInner.surface;
+    RIO_ASSERT(surface._imageOffset + surface.imageSize <= file_size);
+
+    surface.image = file + surface._imageOffset;
+
+    if (surface.mipLevels > 1)
+    {
+        RIO_ASSERT(surface._mipmapsOffset + surface.mipmapSize <= file_size);
+        surface.mipmaps = file + surface._mipmapsOffset;
+    }
+    else
+    {
+        surface.mipmaps = nullptr;
+    }
+
+    mHandle = Texture2DUtil::createHandleStorage(
+        surface.format,
+        surface.nativeFormat,
+        surface.width,
+        surface.height,
+        surface.mipLevels,
+        mTextureInner.compMap
+    );
+    RIO_ASSERT(mHandle != GL_NONE);
+
+    request.handle = mHandle;
+    request.format = surface.format;
+    request.nativeFormat = surface.nativeFormat;
+    request.width = surface.width;
+    request.height = surface.height;
+    request.mipLevels = std::min(std::max(surface.mipLevels, 1u), 14u);
+    request.imageSize = surface.imageSize;
+    request.image = surface.image;
+    request.mipmapSize = surface.mipmapSize;
+    request.mipmaps = surface.mipmaps;
+    MemUtil::copy(request.mipLevelOffset, surface.mipLevelOffset, sizeof(request.mipLevelOffset));
+
+    TextureUploader::instance()->queue(request);
+
+    if (!keep_image_data)
+    {
+        surface.image = nullptr;
+        surface.mipmaps = nullptr;
+    }
+#else
+    RIO_ASSERT(false);
+#endif
+}
+
+void Texture2D::onFileLoaded_(u32, const FileDevice::LoadArg& arg, u8* data, void* user_data)
+{
+    Texture2D* texture = static_cast<Texture2D*>(user_data);
+    texture->mLoadHandle = 0;
+
+    if (!data)
+    {
+        RIO_LOG("Texture2D: Failed to load \"%s\".\n", arg.path.c_str());
+        texture->mSelfAllocated = false;
+        texture->mLoadFailed = true;
+        return;
+    }
+
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    if (texture->mAsyncUpload && TextureUploader::instance())
+    {
+        texture->loadAsync_(data, arg.read_size, arg.is_mapped, texture->mKeepImageData);
+        return;
+    }
+#endif
+
+    texture->load_(data, arg.read_size, texture->mKeepImageData);
+
+    if (arg.is_mapped)
+        FileDeviceMgr::unmap(data, arg.read_size);
+    else
+        FileDeviceMgr::unload(data);
+}
+
 void Texture2D::createHandle_()
 {
     RIO_ASSERT(mTextureInner._footer.magic == 0x5101382D);
@@ -127,6 +299,12 @@ void Texture2D::createHandle_()
 
 Texture2D::~Texture2D()
 {
+    if (mLoadHandle != 0)
+    {
+        FileDeviceMgr::instance()->cancelAsync(mLoadHandle);
+        mLoadHandle = 0;
+    }
+
     if (mHandle != GL_NONE)
     {
         Texture2DUtil::destroyHandle(mHandle);
@@ -146,6 +324,24 @@ void Texture2D::setCompMap(u32 compMap)
     Texture2DUtil::setSwizzle(mHandle, compMap);
 }
 
+bool Texture2D::isReady() const
+{
+    if (mLoadHandle != 0 || mLoadFailed)
+        return false;
+
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    if (TextureUploader::instance())
+        return !TextureUploader::instance()->isPending(mHandle);
+#endif
+
+    return true;
+}
+
+bool Texture2D::isLoadFailed() const
+{
+    return mLoadFailed;
+}
+
 }
 
 #endif // RIO_IS_WIN
@@ -2,16 +2,40 @@
 
 #if RIO_IS_WIN
 
+#include <gfx/win/rio_RenderWorkerMgrWin.h>
 #include <gpu/rio_VertexArray.h>
+#include <gpu/win/rio_GLStateCacheWin.h>
 
 #include <misc/gl/rio_GL.h>
 
+#include <atomic>
+
+namespace {
+
+// Keys are never reused, so a render worker can not bind a vertex array set up for older attributes
+std::atomic<u32> sWorkerKeyCounter(0);
+
+}
+
 namespace rio {
 
+void VertexArray::releaseWorkerKey_()
+{
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    if (mWorkerKey != 0)
+        RenderWorkerMgr::releaseVertexArray_(mWorkerKey);
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+    mWorkerKey = 0;
+}
+
 VertexArray::~VertexArray()
 {
+    releaseWorkerKey_();
+
     if (mHandle != GL_NONE)
     {
+        GLStateCache::onVertexArrayDeleted(mHandle);
         RIO_GL_CALL(glDeleteVertexArrays(1, &mHandle));
         mHandle = GL_NONE;
     }
@@ -21,6 +45,7 @@ void VertexArray::initialize()
 {
     if (mHandle != GL_NONE)
     {
+        GLStateCache::onVertexArrayDeleted(mHandle);
         RIO_GL_CALL(glDeleteVertexArrays(1, &mHandle));
         mHandle = GL_NONE;
     }
@@ -33,6 +58,9 @@ void VertexArray::initialize()
     }
 
     std::memset(mpVertexBuffer, 0, sizeof(VertexBuffer*) * VertexBuffer::NUM_MAX_BUFFERS);
+    mpIndexBuffer = nullptr;
+
+    releaseWorkerKey_();
 
     RIO_GL_CALL(glGenVertexArrays(1, &mHandle));
     RIO_ASSERT(mHandle != GL_NONE);
@@ -40,7 +68,19 @@ void VertexArray::initialize()
 
 void VertexArray::process()
 {
-    RIO_GL_CALL(glBindVertexArray(mHandle));
+    // Render workers create new vertex arrays with these attributes on their next bind,
+    // and delete the ones set up for the previous attributes
+    releaseWorkerKey_();
+    mWorkerKey = ++sWorkerKeyCounter;
+
+    GLStateCache::bindVertexArray(mHandle);
+    setupAttributes_();
+    GLStateCache::bindVertexArray(GL_NONE);
+}
+
+void VertexArray::setupAttributes_() const
+{
+    RIO_GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mpIndexBuffer ? mpIndexBuffer->mHandle : GL_NONE));
 
     for (u32 i = 0; i < VertexBuffer::NUM_MAX_BUFFERS; i++)
     {
@@ -80,16 +120,34 @@ void VertexArray::process()
                         (void*)(uintptr_t)stream->mOffset
                     ));
                 }
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+                RIO_GL_CALL(glVertexAttribDivisor(stream->mLocation, vb->mInstanceStepRate));
+#else
+                RIO_ASSERT(vb->mInstanceStepRate == 0);
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
             }
         }
     }
-
-    RIO_GL_CALL(glBindVertexArray(GL_NONE));
 }
 
 void VertexArray::bind() const
 {
-    RIO_GL_CALL(glBindVertexArray(mHandle));
+#if !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+    // Vertex arrays are not shared between contexts
+    if (RenderWorker* worker = RenderWorker::current())
+    {
+        RIO_ASSERT(mWorkerKey != 0);
+
+        bool created;
+        GLStateCache::bindVertexArray(worker->getVertexArray_(mWorkerKey, &created));
+        if (created)
+            setupAttributes_();
+
+        return;
+    }
+#endif // !defined(RIO_GLES) || defined(GL_ES_VERSION_3_0)
+
+    GLStateCache::bindVertexArray(mHandle);
 }
 
 }
@@ -12,6 +12,7 @@ VertexBuffer::VertexBuffer(u32 buffer)
     : mpData(nullptr)
     , mSize(0)
     , mStride(0)
+    , mInstanceStepRate(0)
 {
     RIO_ASSERT(buffer < NUM_MAX_BUFFERS);
     mBuffer = buffer;
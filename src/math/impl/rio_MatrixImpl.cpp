@@ -0,0 +1,61 @@
+#include <math/rio_Matrix.h>
+
+#if RIO_MATH_SIMD
+
+#include <math/impl/rio_SimdImpl.h>
+
+namespace rio {
+
+// The SIMD implementations do the same operations in the same order as the generic ones,
+// so that both give the same results.
+
+template <>
+void
+Matrix34<f32>::setMul(const Matrix34f& a, const Matrix34f& b)
+{
+    const simd::F32x4 b1 = simd::Load(b.m[0]);
+    const simd::F32x4 b2 = simd::Load(b.m[1]);
+    const simd::F32x4 b3 = simd::Load(b.m[2]);
+
+    simd::F32x4 r[3];
+
+    for (s32 i = 0; i < 3; i++)
+    {
+        r[i] = simd::Mul(simd::Splat(a.m[i][0]), b1);
+        r[i] = simd::Add(r[i], simd::Mul(simd::Splat(a.m[i][1]), b2));
+        r[i] = simd::Add(r[i], simd::Mul(simd::Splat(a.m[i][2]), b3));
+        r[i] = simd::Add(r[i], simd::Set(0, 0, 0, a.m[i][3]));
+    }
+
+    simd::Store(this->m[0], r[0]);
+    simd::Store(this->m[1], r[1]);
+    simd::Store(this->m[2], r[2]);
+}
+
+template <>
+void
+Matrix44<f32>::setMul(const Matrix44f& a, const BaseMtx34f& b)
+{
+    const simd::F32x4 b1 = simd::Load(b.m[0]);
+    const simd::F32x4 b2 = simd::Load(b.m[1]);
+    const simd::F32x4 b3 = simd::Load(b.m[2]);
+
+    simd::F32x4 r[4];
+
+    for (s32 i = 0; i < 4; i++)
+    {
+        r[i] = simd::Mul(simd::Splat(a.m[i][0]), b1);
+        r[i] = simd::Add(r[i], simd::Mul(simd::Splat(a.m[i][1]), b2));
+        r[i] = simd::Add(r[i], simd::Mul(simd::Splat(a.m[i][2]), b3));
+        r[i] = simd::Add(r[i], simd::Set(0, 0, 0, a.m[i][3]));
+    }
+
+    simd::Store(this->m[0], r[0]);
+    simd::Store(this->m[1], r[1]);
+    simd::Store(this->m[2], r[2]);
+    simd::Store(this->m[3], r[3]);
+}
+
+}
+
+#endif // RIO_MATH_SIMD
@@ -1,4 +1,5 @@
 #include <math/rio_Quat.h>
+#include <math/impl/rio_SimdImpl.h>
 
 namespace rio {
 
@@ -280,4 +281,26 @@ Quat<f32>::setScaleAdd(const Quatf& a, f32 s, const Quatf& b)
 
 #endif // RIO_IS_CAFE
 
+#if RIO_MATH_SIMD
+
+template <>
+void
+Quat<f32>::setMul(const Quatf& a, const Quatf& b)
+{
+    // Lanes are (w, x, y, z), same operations as the generic implementation
+    const simd::F32x4 b0 = simd::Load(&b.w);
+    const simd::F32x4 b1 = simd::Mul(simd::SwapPairs(b0),                    simd::Set(-1,  1, -1,  1));   // (x, w, z, y)
+    const simd::F32x4 b2 = simd::Mul(simd::SwapHalves(b0),                   simd::Set(-1,  1,  1, -1));   // (y, z, w, x)
+    const simd::F32x4 b3 = simd::Mul(simd::SwapPairs(simd::SwapHalves(b0)),  simd::Set(-1, -1,  1,  1));   // (z, y, x, w)
+
+    simd::F32x4 r = simd::Mul(simd::Splat(a.w), b0);
+    r = simd::Add(r, simd::Mul(simd::Splat(a.x), b1));
+    r = simd::Add(r, simd::Mul(simd::Splat(a.y), b2));
+    r = simd::Add(r, simd::Mul(simd::Splat(a.z), b3));
+
+    simd::Store(&this->w, r);
+}
+
+#endif // RIO_MATH_SIMD
+
 }
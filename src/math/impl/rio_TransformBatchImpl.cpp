@@ -0,0 +1,246 @@
+#include <math/rio_TransformBatch.h>
+
+#if RIO_MATH_SIMD
+
+#include <math/impl/rio_SimdImpl.h>
+
+#include <algorithm>
+
+namespace rio {
+
+// The SIMD implementations process 4 elements of the batches at a time, with the same operations
+// in the same order as the generic ones. The remaining elements are processed by the generic code.
+
+template <>
+void
+TransformBatch<f32>::mul(const Mtx34SoA<f32>& dst, const Matrix34f& a, const Mtx34SoA<f32>& b, u32 num)
+{
+    // Copied to locals, as stores to dst could otherwise alias them
+    const simd::F32x4 a11 = simd::Splat(a.m[0][0]);
+    const simd::F32x4 a12 = simd::Splat(a.m[0][1]);
+    const simd::F32x4 a13 = simd::Splat(a.m[0][2]);
+    const simd::F32x4 a14 = simd::Splat(a.m[0][3]);
+
+    const simd::F32x4 a21 = simd::Splat(a.m[1][0]);
+    const simd::F32x4 a22 = simd::Splat(a.m[1][1]);
+    const simd::F32x4 a23 = simd::Splat(a.m[1][2]);
+    const simd::F32x4 a24 = simd::Splat(a.m[1][3]);
+
+    const simd::F32x4 a31 = simd::Splat(a.m[2][0]);
+    const simd::F32x4 a32 = simd::Splat(a.m[2][1]);
+    const simd::F32x4 a33 = simd::Splat(a.m[2][2]);
+    const simd::F32x4 a34 = simd::Splat(a.m[2][3]);
+
+    const Mtx34SoA<f32> d = dst;
+    const Mtx34SoA<f32> n = b;
+
+    const u32 num_4 = num & ~3u;
+
+    for (u32 i = 0; i < num_4; i += 4)
+    {
+        const simd::F32x4 b11 = simd::Load(n.m[0][0] + i);
+        const simd::F32x4 b12 = simd::Load(n.m[0][1] + i);
+        const simd::F32x4 b13 = simd::Load(n.m[0][2] + i);
+        const simd::F32x4 b14 = simd::Load(n.m[0][3] + i);
+
+        const simd::F32x4 b21 = simd::Load(n.m[1][0] + i);
+        const simd::F32x4 b22 = simd::Load(n.m[1][1] + i);
+        const simd::F32x4 b23 = simd::Load(n.m[1][2] + i);
+        const simd::F32x4 b24 = simd::Load(n.m[1][3] + i);
+
+        const simd::F32x4 b31 = simd::Load(n.m[2][0] + i);
+        const simd::F32x4 b32 = simd::Load(n.m[2][1] + i);
+        const simd::F32x4 b33 = simd::Load(n.m[2][2] + i);
+        const simd::F32x4 b34 = simd::Load(n.m[2][3] + i);
+
+        simd::Store(d.m[0][0] + i, simd::Add(simd::Add(simd::Mul(a11, b11), simd::Mul(a12, b21)), simd::Mul(a13, b31)));
+        simd::Store(d.m[0][1] + i, simd::Add(simd::Add(simd::Mul(a11, b12), simd::Mul(a12, b22)), simd::Mul(a13, b32)));
+        simd::Store(d.m[0][2] + i, simd::Add(simd::Add(simd::Mul(a11, b13), simd::Mul(a12, b23)), simd::Mul(a13, b33)));
+        simd::Store(d.m[0][3] + i, simd::Add(simd::Add(simd::Add(simd::Mul(a11, b14), simd::Mul(a12, b24)), simd::Mul(a13, b34)), a14));
+
+        simd::Store(d.m[1][0] + i, simd::Add(simd::Add(simd::Mul(a21, b11), simd::Mul(a22, b21)), simd::Mul(a23, b31)));
+        simd::Store(d.m[1][1] + i, simd::Add(simd::Add(simd::Mul(a21, b12), simd::Mul(a22, b22)), simd::Mul(a23, b32)));
+        simd::Store(d.m[1][2] + i, simd::Add(simd::Add(simd::Mul(a21, b13), simd::Mul(a22, b23)), simd::Mul(a23, b33)));
+        simd::Store(d.m[1][3] + i, simd::Add(simd::Add(simd::Add(simd::Mul(a21, b14), simd::Mul(a22, b24)), simd::Mul(a23, b34)), a24));
+
+        simd::Store(d.m[2][0] + i, simd::Add(simd::Add(simd::Mul(a31, b11), simd::Mul(a32, b21)), simd::Mul(a33, b31)));
+        simd::Store(d.m[2][1] + i, simd::Add(simd::Add(simd::Mul(a31, b12), simd::Mul(a32, b22)), simd::Mul(a33, b32)));
+        simd::Store(d.m[2][2] + i, simd::Add(simd::Add(simd::Mul(a31, b13), simd::Mul(a32, b23)), simd::Mul(a33, b33)));
+        simd::Store(d.m[2][3] + i, simd::Add(simd::Add(simd::Add(simd::Mul(a31, b14), simd::Mul(a32, b24)), simd::Mul(a33, b34)), a34));
+    }
+
+    for (u32 i = num_4; i < num; i++)
+        mulElement_(dst, a, b, i);
+}
+
+template <>
+void
+TransformBatch<f32>::makeSRT(const Mtx34SoA<f32>& dst, const Vec3SoA<f32>& s, const Vec3SoA<f32>& r, const Vec3SoA<f32>& t, u32 num)
+{
+    // The sines and cosines are computed first, one chunk at a time, so that the rest is vectorized
+    static const u32 cChunkSize = 64;
+
+    f32 sinV[3][cChunkSize];
+    f32 cosV[3][cChunkSize];
+
+    for (u32 base = 0; base < num; base += cChunkSize)
+    {
+        const u32 chunk_num = std::min(num - base, cChunkSize);
+        const u32 chunk_num_4 = chunk_num & ~3u;
+
+        for (u32 j = 0; j < chunk_num; j++)
+        {
+            sinV[0][j] = std::sin(r.x[base + j]);
+            sinV[1][j] = std::sin(r.y[base + j]);
+            sinV[2][j] = std::sin(r.z[base + j]);
+
+            cosV[0][j] = std::cos(r.x[base + j]);
+            cosV[1][j] = std::cos(r.y[base + j]);
+            cosV[2][j] = std::cos(r.z[base + j]);
+        }
+
+        for (u32 j = 0; j < chunk_num_4; j += 4)
+        {
+            const u32 i = base + j;
+
+            const simd::F32x4 sin0 = simd::Load(sinV[0] + j);
+            const simd::F32x4 sin1 = simd::Load(sinV[1] + j);
+            const simd::F32x4 sin2 = simd::Load(sinV[2] + j);
+
+            const simd::F32x4 cos0 = simd::Load(cosV[0] + j);
+            const simd::F32x4 cos1 = simd::Load(cosV[1] + j);
+            const simd::F32x4 cos2 = simd::Load(cosV[2] + j);
+
+            const simd::F32x4 sx = simd::Load(s.x + i);
+            const simd::F32x4 sy = simd::Load(s.y + i);
+            const simd::F32x4 sz = simd::Load(s.z + i);
+
+            const simd::F32x4 tx = simd::Load(t.x + i);
+            const simd::F32x4 ty = simd::Load(t.y + i);
+            const simd::F32x4 tz = simd::Load(t.z + i);
+
+            simd::Store(dst.m[0][0] + i, simd::Mul(sx, simd::Mul(cos1, cos2)));
+            simd::Store(dst.m[1][0] + i, simd::Mul(sx, simd::Mul(cos1, sin2)));
+            simd::Store(dst.m[2][0] + i, simd::Mul(sx, simd::Neg(sin1)));
+
+            simd::Store(dst.m[0][1] + i, simd::Mul(sy, simd::Sub(simd::Mul(simd::Mul(sin0, sin1), cos2), simd::Mul(cos0, sin2))));
+            simd::Store(dst.m[1][1] + i, simd::Mul(sy, simd::Add(simd::Mul(simd::Mul(sin0, sin1), sin2), simd::Mul(cos0, cos2))));
+            simd::Store(dst.m[2][1] + i, simd::Mul(sy, simd::Mul(sin0, cos1)));
+
+            simd::Store(dst.m[0][2] + i, simd::Mul(sz, simd::Add(simd::Mul(simd::Mul(cos0, cos2), sin1), simd::Mul(sin0, sin2))));
+            simd::Store(dst.m[1][2] + i, simd::Mul(sz, simd::Sub(simd::Mul(simd::Mul(cos0, sin2), sin1), simd::Mul(sin0, cos2))));
+            simd::Store(dst.m[2][2] + i, simd::Mul(sz, simd::Mul(cos0, cos1)));
+
+            simd::Store(dst.m[0][3] + i, tx);
+            simd::Store(dst.m[1][3] + i, ty);
+            simd::Store(dst.m[2][3] + i, tz);
+        }
+
+        for (u32 j = chunk_num_4; j < chunk_num; j++)
+        {
+            const f32 sin_j[3] = { sinV[0][j], sinV[1][j], sinV[2][j] };
+            const f32 cos_j[3] = { cosV[0][j], cosV[1][j], cosV[2][j] };
+
+            makeSRTElement_(dst, s, sin_j, cos_j, t, base + j);
+        }
+    }
+}
+
+template <>
+void
+TransformBatch<f32>::transformPoints(const Vec3SoA<f32>& dst, const Matrix34f& m, const Vec3SoA<f32>& p, u32 num)
+{
+    const simd::F32x4 m11 = simd::Splat(m.m[0][0]);
+    const simd::F32x4 m12 = simd::Splat(m.m[0][1]);
+    const simd::F32x4 m13 = simd::Splat(m.m[0][2]);
+    const simd::F32x4 m14 = simd::Splat(m.m[0][3]);
+
+    const simd::F32x4 m21 = simd::Splat(m.m[1][0]);
+    const simd::F32x4 m22 = simd::Splat(m.m[1][1]);
+    const simd::F32x4 m23 = simd::Splat(m.m[1][2]);
+    const simd::F32x4 m24 = simd::Splat(m.m[1][3]);
+
+    const simd::F32x4 m31 = simd::Splat(m.m[2][0]);
+    const simd::F32x4 m32 = simd::Splat(m.m[2][1]);
+    const simd::F32x4 m33 = simd::Splat(m.m[2][2]);
+    const simd::F32x4 m34 = simd::Splat(m.m[2][3]);
+
+    const Vec3SoA<f32> d = dst;
+    const Vec3SoA<f32> v = p;
+
+    const u32 num_4 = num & ~3u;
+
+    for (u32 i = 0; i < num_4; i += 4)
+    {
+        const simd::F32x4 x = simd::Load(v.x + i);
+        const simd::F32x4 y = simd::Load(v.y + i);
+        const simd::F32x4 z = simd::Load(v.z + i);
+
+        simd::Store(d.x + i, simd::Add(simd::Add(simd::Add(simd::Mul(m11, x), simd::Mul(m12, y)), simd::Mul(m13, z)), m14));
+        simd::Store(d.y + i, simd::Add(simd::Add(simd::Add(simd::Mul(m21, x), simd::Mul(m22, y)), simd::Mul(m23, z)), m24));
+        simd::Store(d.z + i, simd::Add(simd::Add(simd::Add(simd::Mul(m31, x), simd::Mul(m32, y)), simd::Mul(m33, z)), m34));
+    }
+
+    for (u32 i = num_4; i < num; i++)
+        transformPointElement_(dst, m, p, i);
+}
+
+template <>
+void
+TransformBatch<f32>::toSoA(const Mtx34SoA<f32>& dst, const Matrix34f* src, u32 num)
+{
+    const u32 num_4 = num & ~3u;
+
+    for (u32 i = 0; i < num_4; i += 4)
+    {
+        for (u32 r = 0; r < 3; r++)
+        {
+            // Row r of 4 matrices -> element (r, c) of 4 matrices
+            simd::F32x4 c0 = simd::Load(src[i + 0].m[r]);
+            simd::F32x4 c1 = simd::Load(src[i + 1].m[r]);
+            simd::F32x4 c2 = simd::Load(src[i + 2].m[r]);
+            simd::F32x4 c3 = simd::Load(src[i + 3].m[r]);
+            simd::Transpose(c0, c1, c2, c3);
+
+            simd::Store(dst.m[r][0] + i, c0);
+            simd::Store(dst.m[r][1] + i, c1);
+            simd::Store(dst.m[r][2] + i, c2);
+            simd::Store(dst.m[r][3] + i, c3);
+        }
+    }
+
+    for (u32 i = num_4; i < num; i++)
+        dst.set(i, src[i]);
+}
+
+template <>
+void
+TransformBatch<f32>::fromSoA(Matrix34f* dst, const Mtx34SoA<f32>& src, u32 num)
+{
+    const u32 num_4 = num & ~3u;
+
+    for (u32 i = 0; i < num_4; i += 4)
+    {
+        for (u32 r = 0; r < 3; r++)
+        {
+            // Element (r, c) of 4 matrices -> row r of 4 matrices
+            simd::F32x4 m0 = simd::Load(src.m[r][0] + i);
+            simd::F32x4 m1 = simd::Load(src.m[r][1] + i);
+            simd::F32x4 m2 = simd::Load(src.m[r][2] + i);
+            simd::F32x4 m3 = simd::Load(src.m[r][3] + i);
+            simd::Transpose(m0, m1, m2, m3);
+
+            simd::Store(dst[i + 0].m[r], m0);
+            simd::Store(dst[i + 1].m[r], m1);
+            simd::Store(dst[i + 2].m[r], m2);
+            simd::Store(dst[i + 3].m[r], m3);
+        }
+    }
+
+    for (u32 i = num_4; i < num; i++)
+        src.get(i, &dst[i]);
+}
+
+}
+
+#endif // RIO_MATH_SIMD
@@ -0,0 +1,100 @@
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+
+#include <misc/win/rio_HeapWin.h>
+
+#include <new>
+
+namespace rio {
+
+struct Heap::BlockHeader
+{
+    // Stored right before each allocated block
+
+    Heap*   heap;       // Heap the block was allocated from
+    size_t  size;       // Requested size
+    u32     offset;     // Offset of the block from the start of the raw memory
+    u32     alignment;  // Alignment of the raw memory
+};
+
+Heap::Heap(const char* name)
+    : mName(name)
+    , mLiveSize(0)
+    , mPeakSize(0)
+    , mLiveAllocNum(0)
+    , mAllocNum(0)
+{
+}
+
+void* Heap::alloc(size_t size, u32 alignment)
+{
+    RIO_ASSERT(size && alignment);
+    RIO_ASSERT((alignment & (alignment - 1)) == 0);
+
+    if (alignment < alignof(BlockHeader))
+        alignment = alignof(BlockHeader);
+
+    // Leave room for the header before the block, keeping the block aligned
+    const u32 offset = (sizeof(BlockHeader) + alignment - 1) & ~(alignment - 1);
+
+    u8* raw = static_cast<u8*>(doAlloc_(size + offset, alignment));
+    if (!raw)
+        return nullptr;
+
+    u8* ptr = raw + offset;
+
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(ptr) - 1;
+    header->heap = this;
+    header->size = size;
+    header->offset = offset;
+    header->alignment = alignment;
+
+    const size_t live_size = mLiveSize += size;
+    size_t peak_size = mPeakSize;
+    while (live_size > peak_size && !mPeakSize.compare_exchange_weak(peak_size, live_size))
+        ;
+
+    mLiveAllocNum++;
+    mAllocNum++;
+
+    return ptr;
+}
+
+void Heap::free(void* ptr)
+{
+    RIO_ASSERT(ptr);
+
+    const BlockHeader* header = static_cast<const BlockHeader*>(ptr) - 1;
+    Heap* heap = header->heap;
+    RIO_ASSERT(heap);
+
+    const size_t size = header->size;
+    const u32 offset = header->offset;
+    const u32 alignment = header->alignment;
+
+    heap->mLiveSize -= size;
+    heap->mLiveAllocNum--;
+
+    heap->doFree_(static_cast<u8*>(ptr) - offset, size + offset, alignment);
+}
+
+Heap* Heap::findHeap(const void* ptr)
+{
+    RIO_ASSERT(ptr);
+    return (static_cast<const BlockHeader*>(ptr) - 1)->heap;
+}
+
+void* DefaultHeap::doAlloc_(size_t size, u32 alignment)
+{
+    return ::operator new(size, std::align_val_t(alignment));
+}
+
+void DefaultHeap::doFree_(void* ptr, size_t size, u32 alignment)
+{
+    ::operator delete(ptr, size, std::align_val_t(alignment));
+}
+
+}
+
+#endif // RIO_IS_WIN
@@ -0,0 +1,49 @@
+#include <misc/rio_Types.h>
+
+#if RIO_IS_WIN
+
+#include <misc/rio_MemUtil.h>
+
+namespace {
+
+static rio::Heap* GetDefaultHeap(rio::MemUtil::HeapType heap_type)
+{
+    // Never destroyed, as blocks may still be freed during static destruction
+    static rio::DefaultHeap* const sDefaultHeap[rio::MemUtil::HEAP_TYPE_NUM] = {
+        new rio::DefaultHeap("Default"),
+        new rio::DefaultHeap("Model"),
+        new rio::DefaultHeap("Texture"),
+        new rio::DefaultHeap("Audio"),
+        new rio::DefaultHeap("File"),
+        new rio::DefaultHeap("Task")
+    };
+
+    return sDefaultHeap[heap_type];
+}
+
+}
+
+namespace rio {
+
+Heap* MemUtil::sHeap[HEAP_TYPE_NUM] = { };
+
+Heap* MemUtil::getHeap(HeapType heap_type)
+{
+    RIO_ASSERT(heap_type < HEAP_TYPE_NUM);
+
+    Heap* heap = sHeap[heap_type];
+    if (heap)
+        return heap;
+
+    return GetDefaultHeap(heap_type);
+}
+
+void MemUtil::setHeap(HeapType heap_type, Heap* heap)
+{
+    RIO_ASSERT(heap_type < HEAP_TYPE_NUM);
+    sHeap[heap_type] = heap;
+}
+
+}
+
+#endif // RIO_IS_WIN
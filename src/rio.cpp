@@ -7,6 +7,8 @@
 #include <gfx/mdl/res/rio_ModelCacher.h>
 #include <gfx/rio_PrimitiveRenderer.h>
 #include <gfx/rio_Window.h>
+#include <gpu/rio_ShaderCacher.h>
+#include <gpu/rio_TextureCacher.h>
 #include <task/rio_TaskMgr.h>
 
 #if RIO_IS_CAFE
@@ -29,7 +31,7 @@ bool Initialize(const InitializeArg& arg)
 #endif
 
     // Create the file device manager
-    if (!FileDeviceMgr::createSingleton())
+    if (!FileDeviceMgr::createSingleton(arg.file_device.io_thread_num))
         return false;
 
     // Create the window
@@ -40,6 +42,7 @@ bool Initialize(const InitializeArg& arg)
         , arg.window.invisible
         , arg.window.gl_major
         , arg.window.gl_minor
+        , arg.window.offscreen
 #endif // RIO_IS_WIN
     ))
     {
@@ -48,7 +51,7 @@ bool Initialize(const InitializeArg& arg)
     }
 
     // Create the task manager
-    if (!TaskMgr::createSingleton())
+    if (!TaskMgr::createSingleton(arg.task.worker_num))
     {
         Window::destroySingleton();
         FileDeviceMgr::destroySingleton();
@@ -97,6 +100,33 @@ bool Initialize(const InitializeArg& arg)
         return false;
     }
 
+    // Create the shader cacher instance
+    if (!ShaderCacher::createSingleton())
+    {
+        mdl::res::ModelCacher::destroySingleton();
+        lyr::Renderer::destroySingleton();
+        PrimitiveRenderer::destroySingleton();
+        ControllerMgr::destroySingleton();
+        TaskMgr::destroySingleton();
+        Window::destroySingleton();
+        FileDeviceMgr::destroySingleton();
+        return false;
+    }
+
+    // Create the texture cacher instance
+    if (!TextureCacher::createSingleton())
+    {
+        ShaderCacher::destroySingleton();
+        mdl::res::ModelCacher::destroySingleton();
+        lyr::Renderer::destroySingleton();
+        PrimitiveRenderer::destroySingleton();
+        ControllerMgr::destroySingleton();
+        TaskMgr::destroySingleton();
+        Window::destroySingleton();
+        FileDeviceMgr::destroySingleton();
+        return false;
+    }
+
     // Create the audio manager instance
     if (!AudioMgr::createSingleton())
         RIO_LOG("rio::Initialize: Failed to create AudioMgr.\n");
@@ -112,6 +142,9 @@ void EnterMainLoop()
     // Main loop
     while (window->isRunning())
     {
+        // Deliver the files loaded asynchronously
+        FileDeviceMgr::instance()->deliverAsync();
+
         // Update the task manager
         TaskMgr::instance()->calc();
 
@@ -135,6 +168,12 @@ void Exit()
     // Destroy the audio manager upon quitting
     AudioMgr::destroySingleton();
 
+    // Destroy the texture cacher instance upon quitting
+    TextureCacher::destroySingleton();
+
+    // Destroy the shader cacher instance upon quitting
+    ShaderCacher::destroySingleton();
+
     // Destroy the model cacher instance upon quitting
     mdl::res::ModelCacher::destroySingleton();
 
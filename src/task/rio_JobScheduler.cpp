@@ -0,0 +1,217 @@
+#include <task/rio_JobScheduler.h>
+
+namespace rio {
+
+#if RIO_IS_WIN
+
+JobScheduler::JobScheduler()
+    : mWorker()
+    , mQueue(new Queue[1])
+    , mQueueNum(1)
+    , mGeneration(0)
+    , mExit(false)
+    , mRemainingNum(0)
+    , mStolenNum(0)
+{
+}
+
+JobScheduler::~JobScheduler()
+{
+    terminate();
+}
+
+void JobScheduler::initialize(s32 worker_num)
+{
+    terminate();
+
+    if (worker_num < 0)
+    {
+        worker_num = s32(std::thread::hardware_concurrency()) - 1;
+        if (worker_num < 0)
+            worker_num = 0;
+    }
+
+    mQueueNum = worker_num + 1;
+    mQueue.reset(new Queue[mQueueNum]);
+    mGeneration = 0;
+    mExit = false;
+
+    mWorker.reserve(worker_num);
+    for (s32 i = 0; i < worker_num; i++)
+        mWorker.emplace_back(&JobScheduler::threadMain_, this, u32(i));
+}
+
+void JobScheduler::terminate()
+{
+    if (mWorker.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mExit = true;
+    }
+    mCondition.notify_all();
+
+    for (std::thread& worker : mWorker)
+        worker.join();
+
+    mWorker.clear();
+    mQueue.reset(new Queue[1]);
+    mQueueNum = 1;
+}
+
+u32 JobScheduler::getWorkerNum() const
+{
+    return mWorker.size();
+}
+
+void JobScheduler::run(const Job* jobs, u32 num)
+{
+    mStolenNum.store(0, std::memory_order_relaxed);
+
+    if (mWorker.empty() || num <= 1)
+    {
+        for (u32 i = 0; i < num; i++)
+            jobs[i].func(jobs[i].arg);
+
+        return;
+    }
+
+    mRemainingNum.store(num, std::memory_order_relaxed);
+
+    // Deal the jobs to the queues, the calling thread's queue being the last one
+    for (u32 i = 0; i < mQueueNum; i++)
+    {
+        Queue& queue = mQueue[i];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        for (u32 j = i; j < num; j += mQueueNum)
+            queue.jobs.push_back(jobs[j]);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mGeneration++;
+    }
+    mCondition.notify_all();
+
+    work_(mQueueNum - 1);
+
+    // The queues are empty, sleep until the workers are done with the jobs still running
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCondition.wait(lock, [this]() { return mRemainingNum.load(std::memory_order_acquire) == 0; });
+}
+
+u32 JobScheduler::getStolenNum() const
+{
+    return mStolenNum.load(std::memory_order_relaxed);
+}
+
+bool JobScheduler::pop_(u32 queue, Job* job)
+{
+    Queue& q = mQueue[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+
+    if (q.jobs.empty())
+        return false;
+
+    *job = q.jobs.back();
+    q.jobs.pop_back();
+    return true;
+}
+
+bool JobScheduler::steal_(u32 queue, Job* job)
+{
+    for (u32 i = 1; i < mQueueNum; i++)
+    {
+        Queue& q = mQueue[(queue + i) % mQueueNum];
+        std::lock_guard<std::mutex> lock(q.mutex);
+
+        if (q.jobs.empty())
+            continue;
+
+        *job = q.jobs.front();
+        q.jobs.pop_front();
+
+        mStolenNum.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    return false;
+}
+
+void JobScheduler::work_(u32 queue)
+{
+    Job job;
+
+    while (pop_(queue, &job) || steal_(queue, &job))
+    {
+        job.func(job.arg);
+
+        if (mRemainingNum.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            // Last job of the run: wake up the calling thread (locking so that
+            // the notification can not happen between its check and its wait)
+            std::lock_guard<std::mutex> lock(mMutex);
+            mDoneCondition.notify_one();
+        }
+    }
+}
+
+void JobScheduler::threadMain_(u32 queue)
+{
+    u32 generation = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this, generation]() { return mExit || mGeneration != generation; });
+
+            if (mExit)
+                return;
+
+            generation = mGeneration;
+        }
+
+        work_(queue);
+    }
+}
+
+#else
+
+JobScheduler::JobScheduler()
+{
+}
+
+JobScheduler::~JobScheduler()
+{
+}
+
+void JobScheduler::initialize(s32)
+{
+}
+
+void JobScheduler::terminate()
+{
+}
+
+u32 JobScheduler::getWorkerNum() const
+{
+    return 0;
+}
+
+void JobScheduler::run(const Job* jobs, u32 num)
+{
+    for (u32 i = 0; i < num; i++)
+        jobs[i].func(jobs[i].arg);
+}
+
+u32 JobScheduler::getStolenNum() const
+{
+    return 0;
+}
+
+#endif // RIO_IS_WIN
+
+} // namespace rio
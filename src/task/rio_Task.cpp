@@ -3,9 +3,12 @@
 namespace rio {
 
 ITask::ITask(const char* name)
-    : mTaskListNode(this)
+    : mPool(nullptr)
+    , mArrayIndex(0)
     , mName(name)
     , mState(STATE_CREATED)
+    , mIsParallel(false)
+    , mPhase(0)
 {
 }
 
@@ -1,15 +1,19 @@
 #include <task/rio_TaskMgr.h>
 
+#include <algorithm>
+
 namespace rio {
 
 TaskMgr* TaskMgr::sInstance = nullptr;
+u32 TaskMgr::sTaskTypeNum = 0;
 
-bool TaskMgr::createSingleton()
+bool TaskMgr::createSingleton(s32 worker_num)
 {
     if (sInstance)
         return false;
 
     sInstance = new TaskMgr;
+    sInstance->mJobScheduler.initialize(worker_num);
     return true;
 }
 
@@ -22,13 +26,19 @@ void TaskMgr::destroySingleton()
     sInstance = nullptr;
 }
 
+TaskMgr::~TaskMgr()
+{
+    for (TaskPool* pool : mPool)
+        delete pool;
+}
+
 bool TaskMgr::destroyTask(ITask* task)
 {
     if (changeTaskState_(task, ITask::STATE_DESTROYABLE))
     {
         if (changeTaskState_(task, ITask::STATE_DEAD))
         {
-            delete task;
+            freeTask_(task);
             return true;
         }
     }
@@ -38,34 +48,117 @@ bool TaskMgr::destroyTask(ITask* task)
 
 bool TaskMgr::requestDestroyTask(ITask* task)
 {
+#if RIO_IS_WIN
+    std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
     return changeTaskState_(task, ITask::STATE_DESTROYABLE);
 }
 
 void TaskMgr::calc()
 {
-    for (ITask::List::iterator it = mPrepareList.begin(); it != mPrepareList.end(); )
+    // Tasks created by enter_() are prepared in the same loop
+    for (size_t i = 0; i < mPrepareTask.size(); i++)
     {
-        ITask* task = *it;
-        task->prepare_();
-        ++it;
+        ITask* task = mPrepareTask[i];
+        if (!task)
+            continue;
 
+        task->prepare_();
         changeTaskState_(task, ITask::STATE_RUNNING);
     }
+    mPrepareTask.clear();
 
-    for (ITask::List::iterator it = mActiveList.begin(); it != mActiveList.end(); ++it)
-        (*it)->calc_();
+    sortActiveTasks_();
 
-    for (ITask::List::iterator it = mDestroyableList.begin(); it != mDestroyableList.end(); )
+    for (size_t begin = 0, end; begin < mActiveTask.size(); begin = end)
     {
-        ITask* task = *it;
-        ++it;
+        // Range of the phase, including the slots cleared while it runs
+        const s32 phase = mActiveTask[begin]->mPhase;
+        for (end = begin + 1; end < mActiveTask.size(); end++)
+        {
+            const ITask* task = mActiveTask[end];
+            if (task && task->mPhase != phase)
+                break;
+        }
 
-        if (changeTaskState_(task, ITask::STATE_DEAD))
+        // Tasks which are not parallel-safe, in order
+        // (skipping tasks requested to be destroyed by an earlier task)
+        for (size_t i = begin; i < end; i++)
         {
-            task->~ITask();
-            delete task;
+            ITask* task = mActiveTask[i];
+            if (task && !task->mIsParallel)
+                task->calc_();
         }
+
+        // Parallel-safe tasks, collected afterwards as the above may have destroyed some of them
+        mCalcJob.clear();
+        for (size_t i = begin; i < end; i++)
+        {
+            ITask* task = mActiveTask[i];
+            if (task && task->mIsParallel)
+                mCalcJob.push_back({ &TaskMgr::calcTask_, task });
+        }
+
+        mJobScheduler.run(mCalcJob.data(), mCalcJob.size());
+
+        // Skip to the next task, as the first task of the next phase may have been destroyed
+        while (end < mActiveTask.size() && !mActiveTask[end])
+            end++;
+    }
+
+    // Tasks requested to be destroyed by exit_() are destroyed in the same loop
+    for (size_t i = 0; i < mDestroyableTask.size(); i++)
+    {
+        ITask* task = mDestroyableTask[i];
+        if (!task)
+            continue;
+
+        if (changeTaskState_(task, ITask::STATE_DEAD))
+            freeTask_(task);
     }
+    mDestroyableTask.clear();
+}
+
+void TaskMgr::addTask_(std::vector<ITask*>& array, ITask* task)
+{
+    task->mArrayIndex = array.size();
+    array.push_back(task);
+}
+
+void TaskMgr::removeTask_(std::vector<ITask*>& array, ITask* task)
+{
+    RIO_ASSERT(task->mArrayIndex < array.size() && array[task->mArrayIndex] == task);
+    array[task->mArrayIndex] = nullptr;
+}
+
+void TaskMgr::sortActiveTasks_()
+{
+    mActiveTask.erase(std::remove(mActiveTask.begin(), mActiveTask.end(), nullptr), mActiveTask.end());
+
+    const auto by_phase = [](const ITask* a, const ITask* b) { return a->mPhase < b->mPhase; };
+    if (!std::is_sorted(mActiveTask.begin(), mActiveTask.end(), by_phase))
+        std::stable_sort(mActiveTask.begin(), mActiveTask.end(), by_phase);
+
+    for (u32 i = 0; i < mActiveTask.size(); i++)
+        mActiveTask[i]->mArrayIndex = i;
+}
+
+void TaskMgr::freeTask_(ITask* task)
+{
+    TaskPool* pool = task->mPool;
+    // Start of the block, as ITask may not be the first base of the task type
+    void* ptr = dynamic_cast<void*>(task);
+    task->~ITask();
+
+#if RIO_IS_WIN
+    std::lock_guard<std::mutex> lock(mMutex);
+#endif // RIO_IS_WIN
+    pool->free(ptr);
+}
+
+void TaskMgr::calcTask_(void* task)
+{
+    static_cast<ITask*>(task)->calc_();
 }
 
 bool TaskMgr::changeTaskState_(ITask* task, ITask::State state)
@@ -80,8 +173,7 @@ bool TaskMgr::changeTaskState_(ITask* task, ITask::State state)
         RIO_ASSERT(curr_state == ITask::STATE_CREATED);
 
         task->mState = ITask::STATE_PREPARE;
-        task->mTaskListNode.erase();
-        mPrepareList.pushBack(&task->mTaskListNode);
+        addTask_(mPrepareTask, task);
 
         break;
 
@@ -89,8 +181,8 @@ bool TaskMgr::changeTaskState_(ITask* task, ITask::State state)
         RIO_ASSERT(curr_state == ITask::STATE_PREPARE);
 
         task->mState = ITask::STATE_RUNNING;
-        task->mTaskListNode.erase();
-        mActiveList.pushBack(&task->mTaskListNode);
+        removeTask_(mPrepareTask, task);
+        addTask_(mActiveTask, task);
 
         task->enter_();
 
@@ -101,16 +193,22 @@ bool TaskMgr::changeTaskState_(ITask* task, ITask::State state)
             return false;
 
         task->mState = ITask::STATE_DESTROYABLE;
-        task->mTaskListNode.erase();
-        mDestroyableList.pushBack(&task->mTaskListNode);
+        removeTask_(mActiveTask, task);
+        addTask_(mDestroyableTask, task);
 
         break;
 
     case ITask::STATE_DEAD:
         task->exit_();
 
+        if (curr_state == ITask::STATE_PREPARE)
+            removeTask_(mPrepareTask, task);
+        else if (curr_state == ITask::STATE_RUNNING)
+            removeTask_(mActiveTask, task);
+        else if (curr_state == ITask::STATE_DESTROYABLE)
+            removeTask_(mDestroyableTask, task);
+
         task->mState = ITask::STATE_DEAD;
-        task->mTaskListNode.erase();
 
         break;
 
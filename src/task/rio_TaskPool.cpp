@@ -0,0 +1,79 @@
+#include <misc/rio_MemUtil.h>
+#include <task/rio_TaskPool.h>
+
+namespace rio {
+
+TaskPool::TaskPool(size_t size, size_t alignment, u32 slab_block_num)
+    : mBlockSize(0)
+    , mAlignment(0)
+    , mSlabBlockNum(slab_block_num)
+    , mFreeList(nullptr)
+    , mSlab()
+    , mUsedNum(0)
+{
+    RIO_ASSERT(size && alignment && slab_block_num);
+
+    // Free blocks hold the free list link
+    if (alignment < alignof(FreeBlock))
+        alignment = alignof(FreeBlock);
+    if (size < sizeof(FreeBlock))
+        size = sizeof(FreeBlock);
+
+    mAlignment = alignment;
+    mBlockSize = (size + alignment - 1) / alignment * alignment;
+}
+
+TaskPool::~TaskPool()
+{
+    // Blocks still in use belong to tasks which were never destroyed
+    for (void* slab : mSlab)
+        MemUtil::free(slab);
+}
+
+void* TaskPool::alloc()
+{
+    if (!mFreeList)
+        addSlab_();
+
+    FreeBlock* block = mFreeList;
+    mFreeList = block->next;
+    mUsedNum++;
+
+    return block;
+}
+
+void TaskPool::free(void* ptr)
+{
+    RIO_ASSERT(ptr);
+    RIO_ASSERT(mUsedNum > 0);
+
+    // Reused first, while still in the cache
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = mFreeList;
+    mFreeList = block;
+    mUsedNum--;
+}
+
+void TaskPool::reserve(u32 num)
+{
+    while (getCapacity() < num)
+        addSlab_();
+}
+
+void TaskPool::addSlab_()
+{
+    u8* slab = static_cast<u8*>(MemUtil::alloc(mBlockSize * mSlabBlockNum, mAlignment, MemUtil::HEAP_TYPE_TASK));
+    RIO_ASSERT(slab);
+
+    mSlab.push_back(slab);
+
+    // Link the blocks in address order, in front of the free list
+    for (u32 i = mSlabBlockNum; i-- > 0; )
+    {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + mBlockSize * i);
+        block->next = mFreeList;
+        mFreeList = block;
+    }
+}
+
+} // namespace rio